@@ -654,6 +654,22 @@ char assert_aligned[(sizeof(struct mystruct)==16)*2-1];
       self.addDefine('HAVE_BUILTIN_EXPECT', 1)
     self.popLanguage()
 
+  def configureAttributeTarget(self):
+    '''Checks if __attribute((target())) and __builtin_cpu_supports() are available, so that vectorized kernels can be compiled for several instruction sets and selected at runtime'''
+    code = '''\
+__attribute((target("avx2,fma"))) static double myfunc_avx2(double a,double b) {return a*b;}
+__attribute((target("avx512f"))) static double myfunc_avx512(double a,double b) {return a*b;}
+'''
+    self.pushLanguage(self.languages.clanguage)
+    if self.checkLink(code, '''\
+__builtin_cpu_init();
+if (__builtin_cpu_supports("avx512f")) return (int)myfunc_avx512(1.0,0.0);
+if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return (int)myfunc_avx2(1.0,0.0);
+'''):
+      self.addDefine('HAVE_ATTRIBUTE_TARGET', 1)
+    self.popLanguage()
+    return
+
   def configureFunctionName(self):
     '''Sees if the compiler supports __func__ or a variant.'''
     def getFunctionName(lang):
@@ -934,6 +950,7 @@ char assert_aligned[(sizeof(struct mystruct)==16)*2-1];
     self.executeTest(self.configureIsatty)
     self.executeTest(self.configureExpect);
     self.executeTest(self.configureAlign);
+    self.executeTest(self.configureAttributeTarget)
     self.executeTest(self.configureFunctionName);
     self.executeTest(self.configureIntptrt);
     self.executeTest(self.configureSolaris)
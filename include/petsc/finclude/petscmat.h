@@ -99,6 +99,12 @@
 #define MATAIJSELL         'aijsell'
 #define MATSEQAIJSELL      'seqaijsell'
 #define MATMPIAIJSELL      'mpiaijsell'
+#define MATAIJSINGLE       'aijsingle'
+#define MATSEQAIJSINGLE    'seqaijsingle'
+#define MATMPIAIJSINGLE    'mpiaijsingle'
+#define MATAIJDELTA        'aijdelta'
+#define MATSEQAIJDELTA     'seqaijdelta'
+#define MATMPIAIJDELTA     'mpiaijdelta'
 #define MATAIJMKL          'aijmkl'
 #define MATSEQAIJMKL       'seqaijmkl'
 #define MATMPIAIJMKL       'mpiaijmkl'
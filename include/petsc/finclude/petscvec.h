@@ -31,6 +31,9 @@
 #define VECMPICUDA 'mpicuda'
 #define VECCUDA 'cuda'
 #define VECNODE 'node'
+#define VECSEQTHREADED 'seqthreaded'
+#define VECMPITHREADED 'mpithreaded'
+#define VECTHREADED 'threaded'
 
 #define VecScatterType character*(80)
 
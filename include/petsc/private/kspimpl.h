@@ -4,6 +4,7 @@
 
 #include <petscksp.h>
 #include <petsc/private/petscimpl.h>
+#include <petsc/private/vecimpl.h>
 
 PETSC_EXTERN PetscBool KSPRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode KSPRegisterAll(void);
@@ -329,6 +330,23 @@ PETSC_STATIC_INLINE PetscErrorCode KSP_PCApplyBAorABTranspose(KSP ksp,Vec x,Vec
   PetscFunctionReturn(0);
 }
 
+/*
+   KSPSplitReductionAvailable_Private - Split phase reductions on the communicator of v can be started only when none is
+   queued or pending there, which is not the case when this KSP is applied as the preconditioner of a pipelined method.
+   They are also not used with -vec_reproducible, since they do not use the reproducible sums of the vector.
+*/
+PETSC_STATIC_INLINE PetscErrorCode KSPSplitReductionAvailable_Private(Vec v,PetscBool *flg)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  if (v->reproducible) {*flg = PETSC_FALSE; PetscFunctionReturn(0);}
+  ierr = PetscSplitReductionGet(PetscObjectComm((PetscObject)v),&sr);CHKERRQ(ierr);
+  *flg = (PetscBool)(sr->state == STATE_BEGIN && !sr->numopsbegin);
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscLogEvent KSP_GMRESOrthogonalization;
 PETSC_EXTERN PetscLogEvent KSP_SetUp;
 PETSC_EXTERN PetscLogEvent KSP_Solve;
@@ -251,6 +251,39 @@ PETSC_INTERN PetscErrorCode MatProductSymbolic_ABC(Mat);
 PETSC_INTERN PetscErrorCode MatProductNumeric_ABC(Mat);
 PETSC_INTERN PetscErrorCode MatProductCreate_Private(Mat,Mat,Mat,Mat);
 
+/*
+   Instruction sets for which hand vectorized kernels (SELL, BAIJ, AIJ) exist. When the compiler supports
+   __attribute((target())) every variant is compiled, each with MAT_KERNEL_TARGET() for its instruction set, and the
+   one to use is chosen at runtime with MatGetKernelISA_Private() (which also handles -mat_kernel_isa); otherwise only
+   the variants the whole library is compiled for (e.g. with -mavx2) are available.
+*/
+typedef enum {MAT_KERNEL_ISA_GENERIC,MAT_KERNEL_ISA_AVX,MAT_KERNEL_ISA_AVX2,MAT_KERNEL_ISA_AVX512} MatKernelISA;
+PETSC_INTERN const char *const MatKernelISAs[];
+PETSC_INTERN PetscErrorCode MatGetKernelISA_Private(Mat,MatKernelISA*);
+
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES) && !defined(PETSC_SKIP_IMMINTRIN_H_CUDAWORKAROUND)
+#  if defined(PETSC_HAVE_ATTRIBUTE_TARGET)
+#    define MAT_KERNEL_TARGET(isa) __attribute((target(isa)))
+#    define MAT_KERNEL_HAVE_AVX    1
+#    define MAT_KERNEL_HAVE_AVX2   1
+#    define MAT_KERNEL_HAVE_AVX512 1
+#  else
+#    define MAT_KERNEL_TARGET(isa)
+#    if defined(__AVX__)
+#      define MAT_KERNEL_HAVE_AVX    1
+#    endif
+#    if defined(__AVX2__) && defined(__FMA__)
+#      define MAT_KERNEL_HAVE_AVX2   1
+#    endif
+#    if defined(__AVX512F__)
+#      define MAT_KERNEL_HAVE_AVX512 1
+#    endif
+#  endif
+#endif
+#define MAT_KERNEL_TARGET_AVX    MAT_KERNEL_TARGET("avx")
+#define MAT_KERNEL_TARGET_AVX2   MAT_KERNEL_TARGET("avx2,fma")
+#define MAT_KERNEL_TARGET_AVX512 MAT_KERNEL_TARGET("avx2,fma,avx512f")
+
 #if defined(PETSC_USE_DEBUG)
 #  define MatCheckPreallocated(A,arg) do {                              \
     if (PetscUnlikely(!(A)->preallocated)) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatXXXSetPreallocation() or MatSetUp() on argument %D \"%s\" before %s()",(arg),#A,PETSC_FUNCTION_NAME); \
@@ -290,6 +323,7 @@ PETSC_EXTERN PetscErrorCode PetscMatStashSpaceDestroy(PetscMatStashSpace*);
 
 typedef struct {
   PetscInt    count;
+  PetscInt    nflushed;         /* number of messages sent ahead of this one by the hashed stash */
 } MatStashHeader;
 
 typedef struct {
@@ -298,6 +332,8 @@ typedef struct {
   char        pending;
 } MatStashFrame;
 
+typedef struct _MatStashHash *MatStashHash;
+
 typedef struct _MatStash MatStash;
 struct _MatStash {
   PetscInt      nmax;                   /* maximum stash size */
@@ -356,6 +392,13 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used by the hashed stash, -matstash_hash */
+  PetscBool      hashed;          /* combine the entries for the same (row,col) when they are stashed */
+  MatStashHash   hash;            /* created at the first insertion */
+  PetscInt       flushrecv_i;     /* rank (index in recvranks) whose early messages are being received */
+  PetscInt       flushrecv_n;     /* number of early messages received from it so far */
+  MatStashFrame  flushframe;
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -1771,6 +1814,8 @@ PETSC_EXTERN PetscLogEvent MAT_Residual;
 PETSC_EXTERN PetscLogEvent MAT_SetRandom;
 PETSC_EXTERN PetscLogEvent MAT_FactorFactS;
 PETSC_EXTERN PetscLogEvent MAT_FactorInvS;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MATCOLORING_Apply;
 PETSC_EXTERN PetscLogEvent MATCOLORING_Comm;
 PETSC_EXTERN PetscLogEvent MATCOLORING_Local;
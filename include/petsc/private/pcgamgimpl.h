@@ -23,6 +23,7 @@ typedef struct gamg_TAG {
   PetscInt  setup_count;
   PetscBool repart;
   PetscBool reuse_prol;
+  PetscBool numeric_refresh;
   PetscBool use_aggs_in_asm;
   PetscBool use_parallel_coarse_grid_solver;
   PCGAMGLayoutType layout_type;
@@ -42,6 +43,11 @@ typedef struct gamg_TAG {
   PetscReal *data;          /* [data_sz] blocked vector of vertex data on fine grid (coordinates/nullspace) */
   PetscReal *orig_data;          /* cache data */
 
+  /* kept from the first setup for a numeric refresh of the Galerkin operators, indexed by the fine level of each pair */
+  Mat       refresh_P[PETSC_MG_MAXLEVELS];  /* prolongator before repartitioning */
+  Mat       refresh_C[PETSC_MG_MAXLEVELS];  /* P'AP with its symbolic data, before repartitioning */
+  IS        refresh_is[PETSC_MG_MAXLEVELS]; /* rows of the repartitioned coarse operator, or NULL */
+
   struct _PCGAMGOps *ops;
   char      *gamg_type_name;
 
@@ -69,7 +75,7 @@ PetscErrorCode PCGAMGGetDataWithGhosts(Mat, PetscInt, PetscReal[],PetscInt*, Pet
 
 #if defined PETSC_USE_LOG
 #define PETSC_GAMG_USE_LOG
-enum tag {SET1,SET2,GRAPH,GRAPH_MAT,GRAPH_FILTER,GRAPH_SQR,SET4,SET5,SET6,FIND_V,SET7,SET8,SET9,SET10,SET11,SET12,SET13,SET14,SET15,SET16,NUM_SET};
+enum tag {SET1,SET2,GRAPH,GRAPH_MAT,GRAPH_FILTER,GRAPH_SQR,SET4,SET5,SET6,FIND_V,SET7,SET8,SET9,SET10,SET11,SET12,SET13,SET14,SET15,SET16,REFRESH,REFRESH_PTAP,REFRESH_MOVE,NUM_SET};
 #if defined PETSC_GAMG_USE_LOG
 PETSC_EXTERN PetscLogEvent petsc_gamg_setup_events[NUM_SET];
 #endif
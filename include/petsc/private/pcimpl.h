@@ -68,4 +68,7 @@ PETSC_EXTERN PetscLogEvent PC_ModifySubMatrices;
 PETSC_EXTERN PetscLogEvent PC_ApplyOnBlocks;
 PETSC_EXTERN PetscLogEvent PC_ApplyTransposeOnBlocks;
 
+PETSC_INTERN PetscErrorCode PCSetUpBlocks_Private(PC,PetscInt,KSP[]);
+PETSC_INTERN PetscErrorCode PCApplyBlocks_Private(PC,PetscInt,PetscInt,KSP[],Vec[],Vec[],PetscBool);
+
 #endif
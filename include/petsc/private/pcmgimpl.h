@@ -53,6 +53,8 @@ typedef struct {
   PetscErrorCode (*view)(PC,PetscViewer);     /* GAMG and other objects that use PCMG can set their own viewer here */
   PetscReal      min_eigen_DinvA[PETSC_MG_MAXLEVELS];
   PetscReal      max_eigen_DinvA[PETSC_MG_MAXLEVELS];
+  PetscInt       esteig_refresh;              /* power iterations to refresh Chebyshev smoother estimates, -1 to leave the smoothers alone */
+  PetscBool      fused;                       /* use fused level kernels: residual and restriction in one pass, Chebyshev-Jacobi sweeps */
 } PC_MG;
 
 PETSC_INTERN PetscErrorCode PCSetUp_MG(PC);
@@ -61,6 +63,7 @@ PETSC_INTERN PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsOb
 PETSC_INTERN PetscErrorCode PCView_MG(PC,PetscViewer);
 PETSC_INTERN PetscErrorCode PCMGGetLevels_MG(PC,PetscInt *);
 PETSC_INTERN PetscErrorCode PCMGSetLevels_MG(PC,PetscInt,MPI_Comm *);
+PETSC_INTERN PetscErrorCode PCMGResidualRestrict_Private(Mat,Mat,Vec,Vec,Vec,PetscBool*);
 PETSC_DEPRECATED_FUNCTION("Use PCMGResidualDefault() (since version 3.5)") PETSC_STATIC_INLINE PetscErrorCode PCMGResidual_Default(Mat A,Vec b,Vec x,Vec r) {
   return PCMGResidualDefault(A,b,x,r);
 }
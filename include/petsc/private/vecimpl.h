@@ -96,6 +96,8 @@ struct _VecOps {
   PetscErrorCode (*bindtocpu)(Vec,PetscBool);
   PetscErrorCode (*getarraywrite)(Vec,PetscScalar**);
   PetscErrorCode (*restorearraywrite)(Vec,PetscScalar**);
+  PetscErrorCode (*axpydotnorm)(Vec,PetscScalar,Vec,Vec,PetscScalar*,PetscReal*);
+  PetscErrorCode (*maxpynorm)(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
 };
 
 /*
@@ -140,6 +142,7 @@ struct _p_Vec {
   VecStash               stash,bstash; /* used for storing off-proc values during assembly */
   PetscBool              petscnative;  /* means the ->data starts with VECHEADER and can use VecGetArrayFast()*/
   PetscInt               lock;         /* lock state. vector can be free (=0), locked for read (>0) or locked for write(<0) */
+  PetscBool              reproducible; /* the global reductions do not depend on the number of processes, -vec_reproducible */
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   void                   *spptr; /* this is the special pointer to the array on the GPU */
   PetscOffloadMask       offloadmask;  /* a mask which indicates where the valid vector data is (GPU, CPU or both) */
@@ -179,6 +182,7 @@ PETSC_EXTERN PetscLogEvent VEC_ReduceEnd;
 PETSC_EXTERN PetscLogEvent VEC_Swap;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent VEC_DotNorm2;
+PETSC_EXTERN PetscLogEvent VEC_AXPYDotNorm, VEC_MAXPYNorm;
 PETSC_EXTERN PetscLogEvent VEC_AXPBYPCZ;
 PETSC_EXTERN PetscLogEvent VEC_Ops;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyToGPU;
@@ -206,7 +210,8 @@ PETSC_EXTERN PetscErrorCode VecCUDACopyFromGPU(Vec v);
 #define VECHEADER                          \
   PetscScalar *array;                      \
   PetscScalar *array_allocated;                        /* if the array was allocated by PETSc this is its pointer */  \
-  PetscScalar *unplacedarray;                           /* if one called VecPlaceArray(), this is where it stashed the original */
+  PetscScalar *unplacedarray;                           /* if one called VecPlaceArray(), this is where it stashed the original */  \
+  PetscInt    omp_nthreads;                             /* number of OpenMP threads of VECSEQTHREADED and VECMPITHREADED */
 
 /* Lock a vector for exclusive read&write access */
 #if defined(PETSC_USE_DEBUG)
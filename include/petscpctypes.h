@@ -394,4 +394,17 @@ typedef enum {PC_NOERROR,PC_FACTOR_STRUCT_ZEROPIVOT,PC_FACTOR_NUMERIC_ZEROPIVOT,
 E*/
 typedef enum {PCGAMG_LAYOUT_COMPACT,PCGAMG_LAYOUT_SPREAD} PCGAMGLayoutType;
 
+/*E
+    PCGAMGAggressiveType - How aggressive coarsening is done on the levels selected with PCGAMGSetSquareGraph()
+
+$  PCGAMG_AGGRESSIVE_SQUARE - aggregate with a maximal independent set of the square of the graph, formed explicitly
+$  PCGAMG_AGGRESSIVE_MIS2 - aggregate with a distance-2 maximal independent set of the graph, the square is not formed
+
+    Level: intermediate
+
+.seealso: PCGAMGSetAggressiveType(), PCGAMGSetSquareGraph()
+    Any additions/changes here MUST also be made in include/petsc/finclude/petscpc.h
+E*/
+typedef enum {PCGAMG_AGGRESSIVE_SQUARE,PCGAMG_AGGRESSIVE_MIS2} PCGAMGAggressiveType;
+
 #endif
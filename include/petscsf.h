@@ -25,6 +25,7 @@ typedef const char *PetscSFType;
 #define PETSCSFGATHER     "gather"
 #define PETSCSFALLTOALL   "alltoall"
 #define PETSCSFWINDOW     "window"
+#define PETSCSFHIERARCHICAL "hierarchical"
 
 /*E
    PetscSFPattern - Pattern of the PetscSF graph
@@ -25,10 +25,12 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscErrorCode ierr;
   PetscInt       i;
-  PetscScalar    rho,rhoold,alpha,beta,omega,omegaold,d1;
-  Vec            X,B,V,P,R,RP,T,S;
+  PetscScalar    rho,rhonew,rhoold,alpha,beta,omega,omegaold,d1;
+  Vec            X,B,V,P,R,RP,T,S,tmp;
   PetscReal      dp    = 0.0,d2;
   KSP_BCGS       *bcgs = (KSP_BCGS*)ksp->data;
+  PetscMPIInt    size;
+  PetscBool      overlap;
 
   PetscFunctionBegin;
   X  = ksp->vec_sol;
@@ -40,6 +42,10 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
   S  = ksp->work[4];
   P  = ksp->work[5];
 
+  /* in parallel the reductions for the next rho and the norm of r are started before x is updated and overlap it */
+  ierr    = MPI_Comm_size(PetscObjectComm((PetscObject)ksp),&size);CHKERRQ(ierr);
+  overlap = (PetscBool)(size > 1);
+
   /* Compute initial preconditioned residual */
   ierr = KSPInitialResidual(ksp,X,V,T,R,B);CHKERRQ(ierr);
 
@@ -80,9 +86,9 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
   ierr     = VecSet(P,0.0);CHKERRQ(ierr);
   ierr     = VecSet(V,0.0);CHKERRQ(ierr);
 
+  ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);         /*   rho <- (r,rp)      */
   i=0;
   do {
-    ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);       /*   rho <- (r,rp)      */
     beta = (rho/rhoold) * (alpha/omegaold);
     ierr = VecAXPBYPCZ(P,1.0,-omegaold*beta,beta,R,V);CHKERRQ(ierr);  /* p <- r - omega * beta* v + beta * p */
     ierr = KSP_PCApplyBAorAB(ksp,P,V,T);CHKERRQ(ierr);  /*   v <- K p           */
@@ -118,11 +124,30 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
       break;
     }
     omega = d1 / d2;                               /*   w <- (t's) / (t't) */
-    ierr  = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
-    ierr  = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
-    if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
-      KSPCheckNorm(ksp,dp);
+    if (overlap) {ierr = KSPSplitReductionAvailable_Private(R,&overlap);CHKERRQ(ierr);}
+    if (overlap) {
+      PetscBool donorm = (PetscBool)(ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2);
+
+      ierr = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);  /*   r <- s - w t       */
+      ierr = VecDotBegin(R,RP,&rhonew);CHKERRQ(ierr);
+      if (donorm) {ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);}
+      ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
+      ierr = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
+      ierr = VecDotEnd(R,RP,&rhonew);CHKERRQ(ierr);
+      if (donorm) {
+        ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
+        KSPCheckNorm(ksp,dp);
+      }
+    } else {
+      ierr = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
+      /* r <- s - w t is formed in place of s, in the same pass as the next rho <- (r,rp) and the norm of r */
+      if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
+        ierr = VecAXPYDotNorm(S,-omega,T,RP,&rhonew,&dp);CHKERRQ(ierr);
+        KSPCheckNorm(ksp,dp);
+      } else {
+        ierr = VecAXPYDotNorm(S,-omega,T,RP,&rhonew,NULL);CHKERRQ(ierr);
+      }
+      tmp = R; R = S; S = tmp;
     }
 
     rhoold   = rho;
@@ -140,6 +165,7 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
       ksp->reason = KSP_DIVERGED_BREAKDOWN;
       break;
     }
+    rho = rhonew;
     i++;
   } while (i<ksp->max_it);
 
@@ -206,6 +232,9 @@ PetscErrorCode KSPDestroy_BCGS(KSP ksp)
     See KSPBCGSL for additional stabilization
           Supports left and right preconditioning but not symmetric
 
+          In parallel the reductions for the next rho and the norm of r are in flight while x is updated. With
+          -vec_reproducible they are computed with blocking reductions instead.
+
    References:
 .    1. -   van der Vorst, SIAM J. Sci. Stat. Comput., 1992.
 
@@ -81,6 +81,35 @@ static PetscErrorCode KSPSetUp_CG(KSP ksp)
      A macro used in the following KSPSolve_CG and KSPSolve_CG_SingleReduction routines
 */
 #define VecXDot(x,y,a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDot(x,y,a) : VecTDot(x,y,a))
+#define VecXDotBegin(x,y,a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDotBegin(x,y,a) : VecTDotBegin(x,y,a))
+#define VecXDotEnd(x,y,a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDotEnd(x,y,a) : VecTDotEnd(x,y,a))
+
+/*
+     KSPCGNormDot_Private - Computes z <- Br, then the norm of v (r or z) and beta <- z'*r in a single reduction when
+     the communicator has no other split phase reduction in progress and the vectors do not use reproducible reductions.
+     This only combines the two reductions, no computation overlaps them since both need z.
+*/
+static PetscErrorCode KSPCGNormDot_Private(KSP ksp,Vec R,Vec Z,Vec V,PetscReal *dp,PetscScalar *beta)
+{
+  KSP_CG         *cg = (KSP_CG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      split;
+
+  PetscFunctionBegin;
+  ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                   /*     z <- Br                          */
+  ierr = KSPSplitReductionAvailable_Private(V,&split);CHKERRQ(ierr);
+  if (split) {
+    ierr = VecNormBegin(V,NORM_2,dp);CHKERRQ(ierr);
+    ierr = VecXDotBegin(Z,R,beta);CHKERRQ(ierr);
+    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)V));CHKERRQ(ierr);
+    ierr = VecNormEnd(V,NORM_2,dp);CHKERRQ(ierr);
+    ierr = VecXDotEnd(Z,R,beta);CHKERRQ(ierr);
+  } else {
+    ierr = VecNorm(V,NORM_2,dp);CHKERRQ(ierr);
+    ierr = VecXDot(Z,R,beta);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
 
 /*
      KSPSolve_CG - This routine actually applies the conjugate gradient method
@@ -101,7 +130,8 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   Vec            X,B,Z,R,P,W;
   KSP_CG         *cg;
   Mat            Amat,Pmat;
-  PetscBool      diagonalscale;
+  PetscBool      diagonalscale,splitnorm,haveZ = PETSC_FALSE,haveBeta = PETSC_FALSE;
+  PetscMPIInt    size;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -119,6 +149,13 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
 
   if (eigs) {e = cg->e; d = cg->d; e[0] = 0.0; }
   ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  /*
+     The norm of z is always reduced together with the next beta. In parallel so is the unpreconditioned norm of r,
+     after z <- Br, which saves a reduction per iteration; on one process it is computed with the update of r instead,
+     which saves a pass over r
+  */
+  ierr      = MPI_Comm_size(PetscObjectComm((PetscObject)ksp),&size);CHKERRQ(ierr);
+  splitnorm = (PetscBool)(size > 1);
 
   ksp->its = 0;
   if (!ksp->guess_zero) {
@@ -130,19 +167,28 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
 
   switch (ksp->normtype) {
     case KSP_NORM_PRECONDITIONED:
-      ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*    z <- Br                           */
-      ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- z'*z = e'*A'*B'*B*A*e       */
+      ierr  = KSPCGNormDot_Private(ksp,R,Z,Z,&dp,&beta);CHKERRQ(ierr); /* dp <- z'*z = e'*A'*B'*B*A*e, beta <- z'*r */
       KSPCheckNorm(ksp,dp);
+      KSPCheckDot(ksp,beta);
+      haveZ = haveBeta = PETSC_TRUE;
       break;
     case KSP_NORM_UNPRECONDITIONED:
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- r'*r = e'*A'*A*e            */
-      KSPCheckNorm(ksp,dp);
+      if (splitnorm) {
+        ierr  = KSPCGNormDot_Private(ksp,R,Z,R,&dp,&beta);CHKERRQ(ierr); /* dp <- r'*r = e'*A'*A*e, beta <- z'*r */
+        KSPCheckNorm(ksp,dp);
+        KSPCheckDot(ksp,beta);
+        haveZ = haveBeta = PETSC_TRUE;
+      } else {
+        ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);            /*    dp <- r'*r = e'*A'*A*e            */
+        KSPCheckNorm(ksp,dp);
+      }
       break;
     case KSP_NORM_NATURAL:
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*    z <- Br                           */
       ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*    beta <- z'*r                      */
       KSPCheckDot(ksp,beta);
-      dp = PetscSqrtReal(PetscAbsScalar(beta));                /*    dp <- r'*z = r'*B*r = e'*A'*B*A*e */
+      dp    = PetscSqrtReal(PetscAbsScalar(beta));             /*    dp <- r'*z = r'*B*r = e'*A'*B*A*e */
+      haveZ = haveBeta = PETSC_TRUE;
       break;
     case KSP_NORM_NONE:
       dp = 0.0;
@@ -156,10 +202,10 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   ierr = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);     /* test for convergence */
   if (ksp->reason) PetscFunctionReturn(0);
 
-  if (ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) {
+  if (!haveZ) {
     ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                /*     z <- Br                           */
   }
-  if (ksp->normtype != KSP_NORM_NATURAL) {
+  if (!haveBeta) {
     ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                  /*     beta <- z'*r                      */
     KSPCheckDot(ksp,beta);
   }
@@ -205,19 +251,31 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     a = beta/dpi;                                              /*     a = beta/p'w                     */
     if (eigs) d[i] = PetscSqrtReal(PetscAbsScalar(b))*e[i] + 1.0/a;
     ierr = VecAXPY(X,a,P);CHKERRQ(ierr);                       /*     x <- x + ap                      */
-    ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                      /*     r <- r - aw                      */
+    haveZ = haveBeta = PETSC_FALSE;
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2 && !splitnorm) {
+      ierr = VecAXPYDotNorm(R,-a,W,NULL,NULL,&dp);CHKERRQ(ierr);/*     r <- r - aw, dp <- r'*r          */
+      KSPCheckNorm(ksp,dp);
+    } else {
+      ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                    /*     r <- r - aw                      */
+    }
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
-      ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- z'*z                       */
+      ierr  = KSPCGNormDot_Private(ksp,R,Z,Z,&dp,&beta);CHKERRQ(ierr); /* dp <- z'*z, beta <- z'*r   */
       KSPCheckNorm(ksp,dp);
+      KSPCheckDot(ksp,beta);
+      haveZ = haveBeta = PETSC_TRUE;
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- r'*r                       */
-      KSPCheckNorm(ksp,dp);
+      if (splitnorm) {
+        ierr  = KSPCGNormDot_Private(ksp,R,Z,R,&dp,&beta);CHKERRQ(ierr); /* dp <- r'*r, beta <- z'*r */
+        KSPCheckNorm(ksp,dp);
+        KSPCheckDot(ksp,beta);
+        haveZ = haveBeta = PETSC_TRUE;
+      } /* otherwise dp was computed with the update of r */
     } else if (ksp->normtype == KSP_NORM_NATURAL) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
       ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*     beta <- r'*z                     */
       KSPCheckDot(ksp,beta);
-      dp = PetscSqrtReal(PetscAbsScalar(beta));
+      dp    = PetscSqrtReal(PetscAbsScalar(beta));
+      haveZ = haveBeta = PETSC_TRUE;
     } else {
       dp = 0.0;
     }
@@ -228,10 +286,10 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     ierr = (*ksp->converged)(ksp,i+1,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
     if (ksp->reason) break;
 
-    if ((ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) || (ksp->chknorm >= i+2)) {
+    if (!haveZ) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
     }
-    if ((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i+2)) {
+    if (!haveBeta) {
       ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*     beta <- z'*r                     */
       KSPCheckDot(ksp,beta);
     }
@@ -375,15 +433,19 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
     a = beta/dpi;                                              /*    a = beta/p'w                      */
     if (eigs) d[i] = PetscSqrtReal(PetscAbsScalar(b))*e[i] + 1.0/a;
     ierr = VecAXPY(X,a,P);CHKERRQ(ierr);                       /*    x <- x + ap                       */
-    ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                      /*    r <- r - aw                       */
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
+      ierr = VecAXPYDotNorm(R,-a,W,NULL,NULL,&dp);CHKERRQ(ierr);/*    r <- r - aw, dp <- r'*r           */
+      KSPCheckNorm(ksp,dp);
+    } else {
+      ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                    /*    r <- r - aw                       */
+    }
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*    z <- Br                           */
       ierr = KSP_MatMult(ksp,Amat,Z,S);CHKERRQ(ierr);
       ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- z'*z                        */
       KSPCheckNorm(ksp,dp);
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- r'*r                        */
-      KSPCheckNorm(ksp,dp);
+      /* dp was computed with the update of r */
     } else if (ksp->normtype == KSP_NORM_NATURAL) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*    z <- Br                           */
       tmpvecs[0] = S; tmpvecs[1] = R;
@@ -564,6 +626,10 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp,Vec t,Vec v,Vec *V)
    For complex numbers there are two different CG methods, one for Hermitian symmetric matrices and one for non-Hermitian symmetric matrices. Use
    KSPCGSetType() to indicate which type you are using.
 
+   In parallel the norm used in the convergence test is computed in the same global reduction as the next z'*r, which saves
+   one reduction per iteration; the reduction is not overlapped with the application of the operator or the preconditioner.
+   With -vec_reproducible the two are computed with separate blocking reductions.
+
    Developer Notes:
     KSPSolve_CG() should actually query the matrix to determine if it is Hermitian symmetric or not and NOT require the user to
    indicate it to the KSP object.
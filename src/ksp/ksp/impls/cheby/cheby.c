@@ -10,6 +10,10 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
   if (cheb->kspest) {
     ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
   }
+  ierr = VecDestroy(&cheb->evec);CHKERRQ(ierr);
+  cheb->evec_rq = 0.0;
+  ierr = VecDestroy(&cheb->dinv);CHKERRQ(ierr);
+  cheb->dinvid = 0;
   PetscFunctionReturn(0);
 }
 
@@ -22,6 +26,67 @@ PETSC_STATIC_INLINE PetscScalar chebyhash(PetscInt xx)
   return (PetscScalar)((PetscInt64)x-2147483648)*5.e-10; /* center around zero, scaled about -1. to 1.*/
 }
 
+static PetscErrorCode KSPChebyshevSetNoisy_Private(Vec B)
+{
+  PetscErrorCode ierr;
+  PetscInt       n,i,istart;
+  PetscScalar    *xx;
+
+  PetscFunctionBegin;
+  ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(B,&xx);CHKERRQ(ierr);
+  for (i=0; i<n; i++) xx[i] = chebyhash(i+istart);
+  ierr = VecRestoreArrayWrite(B,&xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+ * Applies the preconditioned operator to the approximate dominant eigenvector kept from the last setup. The ratio of
+ * its Rayleigh quotients with the new and the old operators is what the eigenvalue estimates are scaled by. Then takes
+ * more power steps so the vector keeps improving from one setup to the next. With restart the vector is started from
+ * the noisy vector and no ratio is computed, this is done after each estimate from scratch.
+ */
+static PetscErrorCode KSPChebyshevRefreshEig_Private(KSP ksp,PetscBool restart,PetscReal *ratio)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  Mat            Amat;
+  Vec            v,t = ksp->work[0],w = ksp->work[1];
+  PetscScalar    rq;
+  PetscReal      norm;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  *ratio = 1.0;
+  ierr = KSPGetOperators(ksp,&Amat,NULL);CHKERRQ(ierr);
+  ierr = PCSetUp(ksp->pc);CHKERRQ(ierr);
+  if (!cheb->evec) {
+    ierr    = VecDuplicate(t,&cheb->evec);CHKERRQ(ierr);
+    ierr    = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cheb->evec);CHKERRQ(ierr);
+    restart = PETSC_TRUE;
+  }
+  v = cheb->evec;
+  if (restart) {
+    ierr = KSPChebyshevSetNoisy_Private(v);CHKERRQ(ierr);
+    ierr = VecNormalize(v,NULL);CHKERRQ(ierr);
+  }
+  ierr = KSP_MatMult(ksp,Amat,v,t);CHKERRQ(ierr);
+  ierr = KSP_PCApply(ksp,t,w);CHKERRQ(ierr);
+  ierr = VecDot(w,v,&rq);CHKERRQ(ierr);
+  if (!restart && cheb->evec_rq > 0.0 && PetscRealPart(rq) > 0.0) *ratio = PetscRealPart(rq)/cheb->evec_rq;
+  for (i=1; i<cheb->refresh_its; i++) {
+    ierr = VecNorm(w,NORM_2,&norm);CHKERRQ(ierr);
+    if (norm == 0.0) break;
+    ierr = VecAXPBY(v,1.0/norm,0.0,w);CHKERRQ(ierr);
+    ierr = KSP_MatMult(ksp,Amat,v,t);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,t,w);CHKERRQ(ierr);
+    ierr = VecDot(w,v,&rq);CHKERRQ(ierr);
+  }
+  cheb->evec_rq = PetscRealPart(rq);
+  PetscFunctionReturn(0);
+}
+
 /*
  * Must be passed a KSP solver that has "converged", with KSPSetComputeEigenvalues() called before the solve
  */
@@ -75,21 +140,26 @@ static PetscErrorCode KSPSetUp_Chebyshev(KSP ksp)
     ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
-    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+    if (cheb->refresh_its > 0 && cheb->evec_rq > 0.0 && amatid == cheb->amatid && pmatid == cheb->pmatid && (amatstate != cheb->amatstate || pmatstate != cheb->pmatstate)) {
+      PetscReal ratio;
+
+      ierr = KSPChebyshevRefreshEig_Private(ksp,PETSC_FALSE,&ratio);CHKERRQ(ierr);
+      ierr = PetscInfo2(ksp,"Refreshed eigenvalue estimates with %D power iterations, scaled by %g\n",cheb->refresh_its,(double)ratio);CHKERRQ(ierr);
+      cheb->emin_computed *= ratio;
+      cheb->emax_computed *= ratio;
+      cheb->emin = cheb->tform[0]*cheb->emin_computed + cheb->tform[1]*cheb->emax_computed;
+      cheb->emax = cheb->tform[2]*cheb->emin_computed + cheb->tform[3]*cheb->emax_computed;
+
+      cheb->amatstate = amatstate;
+      cheb->pmatstate = pmatstate;
+    } else if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
       PetscReal          max=0.0,min=0.0;
       Vec                B;
       KSPConvergedReason reason;
       ierr = KSPSetPC(cheb->kspest,ksp->pc);CHKERRQ(ierr);
       if (cheb->usenoisy) {
-        PetscInt       n,i,istart;
-        PetscScalar    *xx;
-
         B    = ksp->work[1];
-        ierr = VecGetOwnershipRange(B,&istart,NULL);CHKERRQ(ierr);
-        ierr = VecGetLocalSize(B,&n);CHKERRQ(ierr);
-        ierr = VecGetArrayWrite(B,&xx);CHKERRQ(ierr);
-        for (i=0; i<n; i++) xx[i] = chebyhash(i+istart);
-        ierr = VecRestoreArrayWrite(B,&xx);CHKERRQ(ierr);
+        ierr = KSPChebyshevSetNoisy_Private(B);CHKERRQ(ierr);
       } else {
         PetscBool change;
 
@@ -128,6 +198,36 @@ static PetscErrorCode KSPSetUp_Chebyshev(KSP ksp)
       cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
       cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
 
+      if (cheb->refresh_its > 0) {
+        PetscReal ratio;
+
+        ierr = KSPChebyshevRefreshEig_Private(ksp,PETSC_TRUE,&ratio);CHKERRQ(ierr);
+      }
+
+      cheb->amatid    = amatid;
+      cheb->pmatid    = pmatid;
+      cheb->amatstate = amatstate;
+      cheb->pmatstate = pmatstate;
+    }
+  } else if (cheb->refresh_its > 0) { /* estimates given with KSPChebyshevSetEigenvalues() */
+    ierr = KSPGetOperators(ksp,&Amat,&Pmat);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)Amat,&amatid);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+      PetscReal ratio;
+
+      if (cheb->evec_rq > 0.0 && amatid == cheb->amatid && pmatid == cheb->pmatid) {
+        ierr = KSPChebyshevRefreshEig_Private(ksp,PETSC_FALSE,&ratio);CHKERRQ(ierr);
+        ierr = PetscInfo2(ksp,"Refreshed eigenvalues with %D power iterations, scaled by %g\n",cheb->refresh_its,(double)ratio);CHKERRQ(ierr);
+        cheb->emin          *= ratio;
+        cheb->emax          *= ratio;
+        cheb->emin_computed *= ratio;
+        cheb->emax_computed *= ratio;
+      } else {
+        ierr = KSPChebyshevRefreshEig_Private(ksp,PETSC_TRUE,&ratio);CHKERRQ(ierr);
+      }
       cheb->amatid    = amatid;
       cheb->pmatid    = pmatid;
       cheb->amatstate = amatstate;
@@ -145,8 +245,9 @@ static PetscErrorCode KSPChebyshevSetEigenvalues_Chebyshev(KSP ksp,PetscReal ema
   PetscFunctionBegin;
   if (emax <= emin) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"Maximum eigenvalue must be larger than minimum: max %g min %g",(double)emax,(double)emin);
   if (emax*emin <= 0.0) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"Both eigenvalues must be of the same sign: max %g min %g",(double)emax,(double)emin);
-  chebyshevP->emax = emax;
-  chebyshevP->emin = emin;
+  chebyshevP->emax    = emax;
+  chebyshevP->emin    = emin;
+  chebyshevP->evec_rq = 0.0; /* new values, the refresh starts over from them */
 
   ierr = KSPChebyshevEstEigSet(ksp,0.,0.,0.,0.);CHKERRQ(ierr); /* Destroy any estimation setup */
   PetscFunctionReturn(0);
@@ -187,6 +288,26 @@ static PetscErrorCode KSPChebyshevEstEigSet_Chebyshev(KSP ksp,PetscReal a,PetscR
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPChebyshevEstEigSetRefresh_Chebyshev(KSP ksp,PetscInt its)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  if (its < 0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of power iterations %D cannot be negative",its);
+  if (its != cheb->refresh_its) cheb->evec_rq = 0.0;
+  cheb->refresh_its = its;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPChebyshevSetFused_Chebyshev(KSP ksp,PetscBool fused)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->fused = fused;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPChebyshevEstEigSetUseNoisy_Chebyshev(KSP ksp,PetscBool use)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -303,6 +424,81 @@ PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP ksp,PetscBool use)
   PetscFunctionReturn(0);
 }
 
+/*@
+   KSPChebyshevEstEigSetRefresh - When only the values of the operators change between setups, update the eigenvalue
+   estimates with a few power iterations instead of estimating them again from scratch
+
+   Logically Collective on ksp
+
+   Input Arguments:
++  ksp - linear solver context
+-  its - number of power iterations, 0 to estimate again from scratch at each setup (the default)
+
+   Options Database:
+.  -ksp_chebyshev_esteig_refresh <its>
+
+   Notes:
+   An approximate dominant eigenvector of the preconditioned operator is kept across setups and improved by its power
+   iterations each time. The estimates are scaled by the ratio of its Rayleigh quotients with the new and the old
+   operators, so they keep the accuracy of the Krylov estimate as long as the spectrum changes smoothly, as it does
+   from one time step to the next. A new matrix (not just new values), KSPChebyshevEstEigSet() or KSPReset() start over.
+
+   This also applies to eigenvalues given with KSPChebyshevSetEigenvalues(), for instance by PCGAMG from its prolongator
+   smoothing, which are then scaled as the operators change.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevSetEigenvalues(), PCMGSetEstEigRefresh()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetRefresh(KSP ksp,PetscInt its)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,its,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetRefresh_C",(KSP,PetscInt),(ksp,its));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPChebyshevSetFused - Perform each Chebyshev iteration in a single sweep over the matrix and the vectors when the
+   preconditioner is PCJACOBI
+
+   Logically Collective on ksp
+
+   Input Arguments:
++  ksp - linear solver context
+-  fused - PETSC_TRUE to use the fused update
+
+   Options Database:
+.  -ksp_chebyshev_fused <true,false>
+
+   Notes:
+   The residual, its Jacobi scaling and the three term update are then computed row by row in one pass, instead of
+   streaming the matrix and several vectors through a MatMult(), the preconditioner application and the vector
+   updates separately. This is mostly useful for Chebyshev-Jacobi smoothing in PCMG and PCGAMG, where the vector
+   traffic is a large part of the cost, see PCMGSetFused().
+
+   The fused update is only used for MATSEQAIJ and MATMPIAIJ operators with KSP_NORM_NONE, otherwise this has no
+   effect. The Jacobi scaling is obtained by applying the preconditioner to a vector of ones and is kept until the
+   preconditioner matrix changes.
+
+   Level: advanced
+
+.seealso: KSPCHEBYSHEV, PCJACOBI, PCMGSetFused()
+@*/
+PetscErrorCode KSPChebyshevSetFused(KSP ksp,PetscBool fused)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(ksp,fused,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevSetFused_C",(KSP,PetscBool),(ksp,fused));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   KSPChebyshevEstEigGetKSP - Get the Krylov method context used to estimate eigenvalues for the Chebyshev method.  If
   a Krylov method is not being used for this purpose, NULL is returned.  The reference count of the returned KSP is
@@ -346,11 +542,18 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
   PetscInt       neigarg = 2, nestarg = 4;
   PetscReal      eminmax[2] = {0., 0.};
   PetscReal      tform[4] = {PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE};
-  PetscBool      flgeig, flgest;
+  PetscBool      flgeig, flgest, flgref, fused = cheb->fused;
+  PetscInt       its;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"KSP Chebyshev Options");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-ksp_chebyshev_esteig_steps","Number of est steps in Chebyshev","",cheb->eststeps,&cheb->eststeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_chebyshev_esteig_refresh","Number of power iterations to refresh the estimates when only the matrix values change, 0 to estimate from scratch","KSPChebyshevEstEigSetRefresh",cheb->refresh_its,&its,&flgref);CHKERRQ(ierr);
+  if (flgref) {
+    ierr = KSPChebyshevEstEigSetRefresh(ksp,its);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsBool("-ksp_chebyshev_fused","Do each iteration in a single sweep over the matrix with Jacobi preconditioning","KSPChebyshevSetFused",fused,&fused,NULL);CHKERRQ(ierr);
+  ierr = KSPChebyshevSetFused(ksp,fused);CHKERRQ(ierr);
   ierr = PetscOptionsRealArray("-ksp_chebyshev_eigenvalues","extreme eigenvalues","KSPChebyshevSetEigenvalues",eminmax,&neigarg,&flgeig);CHKERRQ(ierr);
   if (flgeig) {
     if (neigarg != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_chebyshev_eigenvalues: must specify 2 parameters, min and max eigenvalues");
@@ -385,6 +588,34 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
   PetscFunctionReturn(0);
 }
 
+/*
+   Obtains the Jacobi scaling D^{-1} used by the fused update by applying the preconditioner to a vector of ones, w
+   is work space. It is only recomputed when the preconditioner matrix changes.
+*/
+static PetscErrorCode KSPChebyshevSetUpJacobi_Private(KSP ksp,Mat Pmat,Vec w)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  PetscObjectId    pmatid;
+  PetscObjectState pmatstate;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
+  if (!cheb->dinv) {
+    ierr = VecDuplicate(w,&cheb->dinv);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cheb->dinv);CHKERRQ(ierr);
+    cheb->dinvid = 0;
+  }
+  if (pmatid != cheb->dinvid || pmatstate != cheb->dinvstate) {
+    ierr = VecSet(w,1.0);CHKERRQ(ierr);
+    ierr = PCApply(ksp->pc,w,cheb->dinv);CHKERRQ(ierr);
+    cheb->dinvid    = pmatid;
+    cheb->dinvstate = pmatstate;
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -394,7 +625,7 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   PetscReal      rnorm = 0.0;
   Vec            sol_orig,b,p[3],r;
   Mat            Amat,Pmat;
-  PetscBool      diagonalscale;
+  PetscBool      diagonalscale,fused = PETSC_FALSE;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -426,9 +657,18 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   c[km1] = 1.0;
   c[k]   = mu;
 
+  /* with Jacobi preconditioning and no norms each iteration can be done in a single sweep over the matrix */
+  if (cheb->fused && ksp->normtype == KSP_NORM_NONE && !ksp->transpose_solve) {
+    ierr = PetscObjectTypeCompare((PetscObject)ksp->pc,PCJACOBI,&fused);CHKERRQ(ierr);
+    if (fused) {ierr = PetscObjectTypeCompareAny((PetscObject)Amat,&fused,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);}
+    if (fused) {ierr = KSPChebyshevSetUpJacobi_Private(ksp,Pmat,r);CHKERRQ(ierr);}
+  }
+
   if (!ksp->guess_zero) {
-    ierr = KSP_MatMult(ksp,Amat,sol_orig,r);CHKERRQ(ierr);     /*  r = b - A*p[km1] */
-    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+    if (!fused) {
+      ierr = KSP_MatMult(ksp,Amat,sol_orig,r);CHKERRQ(ierr);     /*  r = b - A*p[km1] */
+      ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+    }
   } else {
     ierr = VecCopy(b,r);CHKERRQ(ierr);
   }
@@ -461,10 +701,14 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
     if (ksp->max_it==0) ksp->reason = KSP_DIVERGED_ITS; /* This for a V(0,x) cycle */
     PetscFunctionReturn(0);
   }
-  if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
-    ierr = KSP_PCApply(ksp,r,p[k]);CHKERRQ(ierr);  /* p[k] = B^{-1}r */
+  if (fused && !ksp->guess_zero) {
+    ierr = KSPChebyshevJacobiSweep_Private(Amat,cheb->dinv,0.0,NULL,1.0,p[km1],scale,b,p[k]);CHKERRQ(ierr); /* p[k] = scale B^{-1}(b - A p[km1]) + p[km1] */
+  } else {
+    if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
+      ierr = KSP_PCApply(ksp,r,p[k]);CHKERRQ(ierr);  /* p[k] = B^{-1}r */
+    }
+    ierr = VecAYPX(p[k],scale,p[km1]);CHKERRQ(ierr);  /* p[k] = scale B^{-1}r + p[km1] */
   }
-  ierr = VecAYPX(p[k],scale,p[km1]);CHKERRQ(ierr);  /* p[k] = scale B^{-1}r + p[km1] */
   ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
   ksp->its = 1;
   ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
@@ -474,36 +718,38 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
     ksp->its++;
     ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
 
-    ierr = KSP_MatMult(ksp,Amat,p[k],r);CHKERRQ(ierr);          /*  r = b - Ap[k]    */
-    ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
-    /* calculate residual norm if requested */
-    if (ksp->normtype) {
-      switch (ksp->normtype) {
-      case KSP_NORM_PRECONDITIONED:
-        ierr = KSP_PCApply(ksp,r,p[kp1]);CHKERRQ(ierr);             /*  p[kp1] = B^{-1}r  */
-        ierr = VecNorm(p[kp1],NORM_2,&rnorm);CHKERRQ(ierr);
-        break;
-      case KSP_NORM_UNPRECONDITIONED:
-      case KSP_NORM_NATURAL:
-        ierr = VecNorm(r,NORM_2,&rnorm);CHKERRQ(ierr);
-        break;
-      default:
-        rnorm = 0.0;
-        break;
-      }
-      KSPCheckNorm(ksp,rnorm);
-      ierr         = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
-      ksp->rnorm   = rnorm;
-      ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
-      ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
-      ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
-      ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
-      if (ksp->reason) break;
-      if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
+    if (!fused) {
+      ierr = KSP_MatMult(ksp,Amat,p[k],r);CHKERRQ(ierr);          /*  r = b - Ap[k]    */
+      ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+      /* calculate residual norm if requested */
+      if (ksp->normtype) {
+        switch (ksp->normtype) {
+        case KSP_NORM_PRECONDITIONED:
+          ierr = KSP_PCApply(ksp,r,p[kp1]);CHKERRQ(ierr);             /*  p[kp1] = B^{-1}r  */
+          ierr = VecNorm(p[kp1],NORM_2,&rnorm);CHKERRQ(ierr);
+          break;
+        case KSP_NORM_UNPRECONDITIONED:
+        case KSP_NORM_NATURAL:
+          ierr = VecNorm(r,NORM_2,&rnorm);CHKERRQ(ierr);
+          break;
+        default:
+          rnorm = 0.0;
+          break;
+        }
+        KSPCheckNorm(ksp,rnorm);
+        ierr         = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+        ksp->rnorm   = rnorm;
+        ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+        ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+        ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+        ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+        if (ksp->reason) break;
+        if (ksp->normtype != KSP_NORM_PRECONDITIONED) {
+          ierr = KSP_PCApply(ksp,r,p[kp1]);CHKERRQ(ierr);             /*  p[kp1] = B^{-1}r  */
+        }
+      } else {
         ierr = KSP_PCApply(ksp,r,p[kp1]);CHKERRQ(ierr);             /*  p[kp1] = B^{-1}r  */
       }
-    } else {
-      ierr = KSP_PCApply(ksp,r,p[kp1]);CHKERRQ(ierr);             /*  p[kp1] = B^{-1}r  */
     }
     ksp->vec_sol = p[k];
 
@@ -511,7 +757,11 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
     omega  = omegaprod*c[k]/c[kp1];
 
     /* y^{k+1} = omega(y^{k} - y^{k-1} + Gamma*r^{k}) + y^{k-1} */
-    ierr = VecAXPBYPCZ(p[kp1],1.0-omega,omega,omega*Gamma*scale,p[km1],p[k]);CHKERRQ(ierr);
+    if (fused) {
+      ierr = KSPChebyshevJacobiSweep_Private(Amat,cheb->dinv,1.0-omega,p[km1],omega,p[k],omega*Gamma*scale,b,p[kp1]);CHKERRQ(ierr);
+    } else {
+      ierr = VecAXPBYPCZ(p[kp1],1.0-omega,omega,omega*Gamma*scale,p[km1],p[k]);CHKERRQ(ierr);
+    }
 
     ktmp = km1;
     km1  = k;
@@ -578,6 +828,12 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"  estimating eigenvalues using noisy right hand side\n");CHKERRQ(ierr);
       }
     }
+    if (cheb->refresh_its) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates refreshed with %D power iterations when only the matrix values change\n",cheb->refresh_its);CHKERRQ(ierr);
+    }
+    if (cheb->fused) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  using a single sweep per iteration with Jacobi preconditioning\n");CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -592,6 +848,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRefresh_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetFused_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -606,7 +864,9 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_refresh <its> - refresh the estimates with this many power iterations when only the matrix values change (KSPChebyshevEstEigSetRefresh())
+-   -ksp_chebyshev_fused - do each iteration in a single sweep over the matrix with Jacobi preconditioning (KSPChebyshevSetFused())
 
    Level: beginner
 
@@ -619,7 +879,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy(), KSPChebyshevEstEigSetRefresh(),
+           KSPChebyshevSetFused(),
            KSPRICHARDSON, KSPCG, PCMG
 
 M*/
@@ -661,6 +922,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",KSPChebyshevSetEigenvalues_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",KSPChebyshevEstEigSetUseNoisy_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRefresh_C",KSPChebyshevEstEigSetRefresh_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetFused_C",KSPChebyshevSetFused_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
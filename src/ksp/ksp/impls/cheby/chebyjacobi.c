@@ -0,0 +1,80 @@
+
+/*
+    Fused Chebyshev update for Jacobi preconditioning of AIJ matrices
+*/
+#include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h>
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+/*
+   y = alpha w + beta x + gamma D^{-1} (b - A x) for the rows of the diagonal block Ad and, if present, the
+   off-diagonal block Ao acting on the ghost values xo. w may be NULL.
+*/
+static PetscErrorCode KSPChebyshevJacobiSweep_SeqAIJ(Mat Ad,Mat Ao,const PetscScalar *xo,const PetscScalar *dinv,PetscScalar alpha,const PetscScalar *w,PetscScalar beta,const PetscScalar *x,PetscScalar gamma,const PetscScalar *b,PetscScalar *y)
+{
+  Mat_SeqAIJ      *ad = (Mat_SeqAIJ*)Ad->data,*ao = Ao ? (Mat_SeqAIJ*)Ao->data : NULL;
+  PetscInt        m = Ad->rmap->n,i,n;
+  const PetscInt  *aj;
+  const MatScalar *aa;
+  PetscScalar     sum;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    sum = b[i];
+    n   = ad->i[i+1] - ad->i[i];
+    aj  = ad->j + ad->i[i];
+    aa  = ad->a + ad->i[i];
+    PetscSparseDenseMinusDot(sum,x,aa,aj,n);
+    if (ao) {
+      n  = ao->i[i+1] - ao->i[i];
+      aj = ao->j + ao->i[i];
+      aa = ao->a + ao->i[i];
+      PetscSparseDenseMinusDot(sum,xo,aa,aj,n);
+    }
+    y[i] = beta*x[i] + gamma*dinv[i]*sum;
+    if (w) y[i] += alpha*w[i];
+  }
+  ierr = PetscLogFlops(2.0*(ad->nz + (ao ? ao->nz : 0)) + (w ? 7.0 : 5.0)*m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPChebyshevJacobiSweep_Private - Computes y = alpha w + beta x + gamma D^{-1} (b - A x) in a single pass over A
+   and the vectors, instead of a MatMult(), a VecAYPX(), the application of the Jacobi preconditioner and a
+   VecAXPBYPCZ(). w may be NULL, y must differ from the other vectors. A must be MATSEQAIJ or MATMPIAIJ.
+*/
+PetscErrorCode KSPChebyshevJacobiSweep_Private(Mat A,Vec dinv,PetscScalar alpha,Vec w,PetscScalar beta,Vec x,PetscScalar gamma,Vec b,Vec y)
+{
+  PetscErrorCode    ierr;
+  PetscBool         ismpi;
+  const PetscScalar *xa,*xo,*da,*wa = NULL,*ba;
+  PetscScalar       *ya;
+  Mat_MPIAIJ        *a = NULL;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATMPIAIJ,&ismpi);CHKERRQ(ierr);
+  if (ismpi) {
+    a    = (Mat_MPIAIJ*)A->data;
+    ierr = VecScatterBegin(a->Mvctx,x,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(a->Mvctx,x,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  }
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(dinv,&da);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(b,&ba);CHKERRQ(ierr);
+  if (w) {ierr = VecGetArrayRead(w,&wa);CHKERRQ(ierr);}
+  ierr = VecGetArrayWrite(y,&ya);CHKERRQ(ierr);
+  if (ismpi) {
+    ierr = VecGetArrayRead(a->lvec,&xo);CHKERRQ(ierr);
+    ierr = KSPChebyshevJacobiSweep_SeqAIJ(a->A,a->B,xo,da,alpha,wa,beta,xa,gamma,ba,ya);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(a->lvec,&xo);CHKERRQ(ierr);
+  } else {
+    ierr = KSPChebyshevJacobiSweep_SeqAIJ(A,NULL,NULL,da,alpha,wa,beta,xa,gamma,ba,ya);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayWrite(y,&ya);CHKERRQ(ierr);
+  if (w) {ierr = VecRestoreArrayRead(w,&wa);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(b,&ba);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(dinv,&da);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
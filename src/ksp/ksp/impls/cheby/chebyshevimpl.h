@@ -17,6 +17,17 @@ typedef struct {
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
+  /* For refreshing the estimates cheaply when only the matrix values change */
+  PetscInt         refresh_its;  /* number of warm-started power iterations, 0 to always estimate from scratch */
+  Vec              evec;         /* approximate dominant eigenvector, kept across setups */
+  PetscReal        evec_rq;      /* its Rayleigh quotient with the operators of the last setup, 0 if not computed yet */
+  /* For the fused update with Jacobi preconditioning */
+  PetscBool        fused;        /* use a single sweep over the matrix per iteration when possible */
+  Vec              dinv;         /* the Jacobi scaling, obtained by applying the preconditioner to a vector of ones */
+  PetscObjectId    dinvid;
+  PetscObjectState dinvstate;
 } KSP_Chebyshev;
 
+PETSC_INTERN PetscErrorCode KSPChebyshevJacobiSweep_Private(Mat,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscScalar,Vec,Vec);
+
 #endif
@@ -7,6 +7,7 @@
     given for correct computation of inner products.
 */
 #include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+#include <petsc/private/vecimpl.h>
 
 /*@C
      KSPGMRESClassicalGramSchmidtOrthogonalization -  This is the basic orthogonalization routine
@@ -20,12 +21,19 @@
 
    Options Database Keys:
 +   -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization()
--   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
+.   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
                                    used to increase the stability of the classical Gram-Schmidt  orthogonalization.
+-   -ksp_gmres_cgs_single_reduction - without refinement, compute the norm of the new direction in the same reduction as its inner products
 
     Notes:
     Use KSPGMRESSetCGSRefinementType() to determine if iterative refinement is to be used
 
+    With -ksp_gmres_cgs_single_reduction the norm of the orthogonalized direction is obtained from the norm of the
+    direction before orthogonalization and its inner products, sqrt(|w|^2 - |h|^2), which saves one global reduction
+    per iteration. When that loses too many digits, because the direction is nearly in the Krylov space, the norm is
+    computed again directly. The reductions are only combined, not overlapped with computation, and are done separately
+    with -vec_reproducible.
+
    Level: intermediate
 
 .seelaso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESSetCGSRefinementType(),
@@ -38,11 +46,13 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   PetscErrorCode ierr;
   PetscInt       j;
   PetscScalar    *hh,*hes,*lhh;
-  PetscReal      hnrm, wnrm;
+  PetscReal      hnrm, wnrm, wnrm0;
   PetscBool      refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
+  PetscBool      single = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_NEVER && gmres->cgssinglereduction);
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  if (single) {ierr = KSPSplitReductionAvailable_Private(VEC_VV(it+1),&single);CHKERRQ(ierr);}
   if (!gmres->orthogwork) {
     ierr = PetscMalloc1(gmres->max_k + 2,&gmres->orthogwork);CHKERRQ(ierr);
   }
@@ -62,7 +72,15 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
      This is really a matrix-vector product, with the matrix stored
      as pointer to rows
   */
-  ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
+  if (single) {
+    ierr = VecMDotBegin(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr);
+    ierr = VecNormBegin(VEC_VV(it+1),NORM_2,&wnrm0);CHKERRQ(ierr);
+    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(it+1)));CHKERRQ(ierr);
+    ierr = VecMDotEnd(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
+    ierr = VecNormEnd(VEC_VV(it+1),NORM_2,&wnrm0);CHKERRQ(ierr);
+  } else {
+    ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
+  }
   for (j=0; j<=it; j++) {
     KSPCheckDot(ksp,lhh[j]);
     lhh[j] = -lhh[j];
@@ -71,8 +89,27 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   /*
          This is really a matrix vector product:
          [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
+     Unless a refinement will follow anyway the norm of the new vector is computed in the same pass, it is
+     cached in the vector so the normalization of v[it+1] does not compute it again
   */
-  ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+  if (single) {
+    ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+    hnrm = 0.0;
+    for (j=0; j<=it; j++) hnrm += PetscRealPart(lhh[j] * PetscConj(lhh[j]));
+    wnrm = wnrm0*wnrm0 - hnrm;
+    /* the relative error of the difference is below 100 times the roundoff when the new direction keeps a tenth of its norm */
+    if (wnrm > 0.01*wnrm0*wnrm0) {
+      wnrm = PetscSqrtReal(wnrm);
+      ierr = PetscObjectComposedDataSetReal((PetscObject)VEC_VV(it+1),NormIds[NORM_2],wnrm);CHKERRQ(ierr);
+    } else {
+      ierr = PetscInfo2(ksp,"Computing the norm of the new direction again, wnorm %g hnorm %g\n",(double)wnrm0,(double)PetscSqrtReal(hnrm));CHKERRQ(ierr);
+      ierr = VecNorm(VEC_VV(it+1),NORM_2,&wnrm);CHKERRQ(ierr);
+    }
+  } else if (refine) {
+    ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+  } else {
+    ierr = VecMAXPYNorm(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),&wnrm);CHKERRQ(ierr);
+  }
   /* note lhh[j] is -<v,vnew> , hence the subtraction */
   for (j=0; j<=it; j++) {
     hh[j]  -= lhh[j];     /* hh += <v,vnew> */
@@ -88,7 +125,6 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
     for (j=0; j<=it; j++) hnrm +=  PetscRealPart(lhh[j] * PetscConj(lhh[j]));
 
     hnrm = PetscSqrtReal(hnrm);
-    ierr = VecNorm(VEC_VV(it+1),NORM_2, &wnrm);CHKERRQ(ierr);
     if (wnrm < hnrm) {
       refine = PETSC_TRUE;
       ierr   = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)wnrm,(double)hnrm);CHKERRQ(ierr);
@@ -98,7 +134,7 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   if (refine) {
     ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
     for (j=0; j<=it; j++) lhh[j] = -lhh[j];
-    ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+    ierr = VecMAXPYNorm(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),&wnrm);CHKERRQ(ierr);
     /* note lhh[j] is -<v,vnew> , hence the subtraction */
     for (j=0; j<=it; j++) {
       hh[j]  -= lhh[j];     /* hh += <v,vnew> */
@@ -522,6 +522,9 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, using %s\n",gmres->max_k,cstr);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)gmres->haptol);CHKERRQ(ierr);
+    if (gmres->orthog == KSPGMRESClassicalGramSchmidtOrthogonalization && gmres->cgstype == KSP_GMRES_CGS_REFINE_NEVER && gmres->cgssinglereduction) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  inner products and norm of each new direction computed in a single reduction\n");CHKERRQ(ierr);
+    }
   } else if (isstring) {
     ierr = PetscViewerStringSPrintf(viewer,"%s restart %D",cstr,gmres->max_k);CHKERRQ(ierr);
   }
@@ -592,6 +595,7 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
                           KSPGMRESCGSRefinementTypes,(PetscEnum)gmres->cgstype,(PetscEnum*)&gmres->cgstype,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-ksp_gmres_cgs_single_reduction","Compute the norm of each new direction in the same reduction as its inner products","KSPGMRESClassicalGramSchmidtOrthogonalization",gmres->cgssinglereduction,&gmres->cgssinglereduction,NULL);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-ksp_gmres_krylov_monitor","Plot the Krylov directions","KSPMonitorSet",flg,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -30,6 +30,7 @@
                                                                         \
   PetscErrorCode (*orthog)(KSP,PetscInt);                    \
   KSPGMRESCGSRefinementType cgstype;                                    \
+  PetscBool cgssinglereduction;  /* reduce the inner products and the norm of a new direction together */ \
                                                                         \
   Vec      *vecs;                                        /* the work vectors */ \
   Vec      *vecb;                                        /* holds the last full basis vectors of the Krylov subspace to compute (harmonic) Ritz pairs */ \
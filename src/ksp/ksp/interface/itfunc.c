@@ -616,6 +616,7 @@ static PetscErrorCode KSPSolve_Private(KSP ksp,Vec b,Vec x)
   MPI_Comm       comm;
   MatNullSpace   nullsp;
   Vec            btmp,vec_rhs=NULL;
+  PetscLogDouble toverlap,tblocked,toverlap0,tblocked0;
 
   PetscFunctionBegin;
   comm = PetscObjectComm((PetscObject)ksp);
@@ -643,6 +644,7 @@ static PetscErrorCode KSPSolve_Private(KSP ksp,Vec b,Vec x)
   if (ksp->res_hist_reset) ksp->res_hist_len = 0;
 
   ierr = PetscLogEventBegin(KSP_Solve,ksp,ksp->vec_rhs,ksp->vec_sol,0);CHKERRQ(ierr);
+  ierr = PetscCommSplitReductionGetTimes(PetscObjectComm((PetscObject)ksp->vec_rhs),&toverlap0,&tblocked0);CHKERRQ(ierr);
 
   if (ksp->guess) {
     PetscObjectState ostate,state;
@@ -753,6 +755,10 @@ static PetscErrorCode KSPSolve_Private(KSP ksp,Vec b,Vec x)
       ksp->dscalefix2 = PETSC_TRUE;
     }
   }
+  ierr = PetscCommSplitReductionGetTimes(PetscObjectComm((PetscObject)ksp->vec_rhs),&toverlap,&tblocked);CHKERRQ(ierr);
+  if (toverlap > toverlap0 || tblocked > tblocked0) {
+    ierr = PetscInfo2(ksp,"Split phase reductions were in flight during computation for %g seconds and blocked for %g seconds\n",(double)(toverlap-toverlap0),(double)(tblocked-tblocked0));CHKERRQ(ierr);
+  }
   ierr = PetscLogEventEnd(KSP_Solve,ksp,ksp->vec_rhs,ksp->vec_sol,0);CHKERRQ(ierr);
   if (ksp->guess) {
     ierr = KSPGuessUpdate(ksp->guess,ksp->vec_rhs,ksp->vec_sol);CHKERRQ(ierr);
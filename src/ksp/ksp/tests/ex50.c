@@ -132,4 +132,9 @@ int main(int argc,char **args)
       suffix: 2
       args: -bs {{8 9 10 11 12 13 14 15}} -pc_type ilu
 
+   test:
+      suffix: 3
+      args: -bs 9 -pc_type ilu -mat_kernel_isa {{generic avx2}}
+      output_file: output/ex50_2.out
+
 TEST*/
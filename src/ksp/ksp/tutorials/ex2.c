@@ -224,10 +224,41 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: ilu_threads
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -pc_type ilu -pc_factor_mat_solve_threads 2
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: 2_ilu_threads
+      nsize: 2
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -sub_pc_type ilu -sub_pc_factor_mat_solve_threads 2
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: vec_threads
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -vec_type threaded -vec_omp_num_threads 2
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: 2_vec_threads
+      nsize: 2
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -vec_type threaded -vec_omp_num_threads 2
+      output_file: output/ex2_2.out
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: 3_aijsingle
+      args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -mat_type aijsingle
+      output_file: output/ex2_3.out
+
    test:
       suffix: 4
       args: -pc_type eisenstat -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -253,6 +284,16 @@ int main(int argc,char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   # the local blocks are solved one after another unless PETSc is configured with OpenMP, --with-threadsafety and --with-log=0
+   test:
+      suffix: bjacobi_local_blocks
+      args: -pc_type bjacobi -pc_bjacobi_local_blocks 4 -pc_bjacobi_block_threads 2 -ksp_monitor_short -sub_pc_type ilu
+
+   # restrict to all blocks, solve all blocks, then interpolate, for PCApply() and PCApplyTranspose()
+   test:
+      suffix: asm_additive_blocks
+      args: -pc_type asm -pc_asm_local_blocks 4 -pc_asm_block_threads 2 -ksp_monitor_short -sub_pc_type ilu -ksp_type bicg
+
    test:
       suffix: fbcgs
       args: -ksp_type fbcgs -pc_type ilu
@@ -327,4 +368,26 @@ int main(int argc,char **args)
    test:
       suffix: pipeprcg_rcw
       args: -ksp_monitor_short -ksp_type pipeprcg -recompute_w false -m 9 -n 9
+
+   test:
+      suffix: cg_unpreconditioned_2
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cg -pc_type jacobi -ksp_norm_type unpreconditioned -ksp_rtol 1.e-3 -m 9 -n 9
+
+   test:
+      suffix: bcgs_2
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type bcgs -m 9 -n 9
+
+   test:
+      suffix: gmres_cgs_single_reduction
+      nsize: 2
+      args: -ksp_monitor_short -ksp_gmres_cgs_single_reduction -m 9 -n 9
+
+   test:
+      suffix: reproducible_2
+      nsize: 2
+      # the split phase reductions are not reproducible, so -info must not report any in flight
+      filter: grep -e "KSP Residual" -e "Split phase"
+      args: -ksp_monitor_short -ksp_type {{cg bcgs gmres}separate output} -ksp_gmres_cgs_single_reduction -vec_reproducible -info :ksp -m 9 -n 9
  TEST*/
@@ -232,6 +232,10 @@ int main(int argc,char **args)
       args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type classical -mg_levels_ksp_chebyshev_esteig 0,0.05,0,1.05 -ksp_converged_reason
       output_file: output/ex54_classical.out
 
+   test:
+      suffix: hash_threaded
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -mg_levels_ksp_max_it 3 -ksp_monitor_short -ksp_converged_reason -matptap_via hash_threaded -matmatmult_via hash_threaded -mat_omp_num_threads {{1 3}}
+
    test:
       suffix: geo
       nsize: 4
@@ -17,7 +17,9 @@ int main(int argc,char **args)
   Mat            Amat;
   PetscErrorCode ierr;
   PetscInt       m,nn,M,Istart,Iend,i,j,k,ii,jj,kk,ic,ne=4,id;
-  PetscReal      x,y,z,h,*coords,soft_alpha=1.e-3;
+  PetscReal      x,y,z,h,*coords,soft_alpha=1.e-3,soft_alpha2=0.0;
+  PetscInt       nsoft=0,*soft_idx=NULL;
+  PetscBool      *soft_bc=NULL;
   PetscBool      two_solves=PETSC_FALSE,test_nonzero_cols=PETSC_FALSE,use_nearnullspace=PETSC_FALSE,test_late_bs=PETSC_FALSE;
   Vec            xx,bb;
   KSP            ksp;
@@ -40,6 +42,7 @@ int main(int argc,char **args)
     ierr = PetscOptionsBool("-log_stages","Log stages of solve separately","",log_stages,&log_stages,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsReal("-alpha","material coefficient inside circle","",soft_alpha,&soft_alpha,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-two_solves","solve additional variant of the problem","",two_solves,&two_solves,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-two_solves_alpha","material coefficient inside circle for the additional solve (default: scale the whole matrix)","",soft_alpha2,&soft_alpha2,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-test_nonzero_cols","nonzero test","",test_nonzero_cols,&test_nonzero_cols,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-use_mat_nearnullspace","MatNearNullSpace API test","",use_nearnullspace,&use_nearnullspace,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-test_late_bs","","",test_late_bs,&test_late_bs,NULL);CHKERRQ(ierr);
@@ -163,6 +166,9 @@ int main(int argc,char **args)
 
     ierr      = PetscMalloc1(m+1, &coords);CHKERRQ(ierr);
     coords[m] = -99.0;
+    if (two_solves && soft_alpha2 > 0.0) {
+      ierr = PetscMalloc2(8*(m/3+1),&soft_idx,m/3+1,&soft_bc);CHKERRQ(ierr);
+    }
 
     /* forms the element stiffness and coordinates */
     for (i=Ni0,ic=0,ii=0; i<Ni1; i++,ii++) {
@@ -208,7 +214,13 @@ int main(int argc,char **args)
               idx[7] += NN*(nn*nn-NN*NN);
             }
 
-            if (radius < 0.25) alpha = soft_alpha;
+            if (radius < 0.25) {
+              alpha = soft_alpha;
+              if (soft_idx) { /* remember the soft elements to change their coefficient for the additional solve */
+                for (ix=0; ix<8; ix++) soft_idx[8*nsoft+ix] = idx[ix];
+                soft_bc[nsoft++] = (PetscBool)(k == 0);
+              }
+            }
 
             for (ix=0; ix<24; ix++) {
               for (jx=0;jx<24;jx++) DD[ix][jx] = alpha*DD1[ix][jx];
@@ -319,7 +331,20 @@ int main(int argc,char **args)
 
     ierr = MaybeLogStagePush(stage[2]);CHKERRQ(ierr);
     /* PC setup basically */
-    ierr = MatScale(Amat, 100000.0);CHKERRQ(ierr);
+    if (soft_idx) {
+      /* change only the soft inclusion, which changes the spectrum of the Jacobi preconditioned operator */
+      for (i=0; i<nsoft; i++) {
+        for (ii=0; ii<24; ii++) {
+          for (jj=0; jj<24; jj++) DD[ii][jj] = (soft_alpha2-soft_alpha)*(soft_bc[i] ? DD2[ii][jj] : DD1[ii][jj]);
+        }
+        ierr = MatSetValuesBlocked(Amat,8,soft_idx+8*i,8,soft_idx+8*i,(const PetscScalar*)DD,ADD_VALUES);CHKERRQ(ierr);
+      }
+      ierr = MatAssemblyBegin(Amat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      ierr = MatAssemblyEnd(Amat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      ierr = PetscFree2(soft_idx,soft_bc);CHKERRQ(ierr);
+    } else {
+      ierr = MatScale(Amat, 100000.0);CHKERRQ(ierr);
+    }
     ierr = KSPSetOperators(ksp, Amat, Amat);CHKERRQ(ierr);
     ierr = KSPSetUp(ksp);CHKERRQ(ierr);
 
@@ -990,6 +1015,35 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
       nsize: 2
       args: -use_mat_nearnullspace -ksp_monitor_short -pc_type telescope -pc_telescope_reduction_factor 2 -telescope_pc_type gamg
 
+   test:
+      suffix: mis2
+      nsize: 8
+      args: -ne 11 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_gamg_square_graph 10 -pc_gamg_aggressive_type mis2 -ksp_converged_reason -use_mat_nearnullspace -mg_levels_ksp_max_it 2 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 100 -pc_gamg_repartition false -ksp_monitor_short
+
+   test:
+      suffix: numeric_refresh
+      nsize: 8
+      args: -ne 11 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_gamg_numeric_refresh -two_solves -ksp_converged_reason -use_mat_nearnullspace -mg_levels_ksp_max_it 2 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 100 -pc_gamg_repartition false -ksp_monitor_short
+
+   test:
+      suffix: esteig_refresh
+      nsize: 8
+      # the second assembly changes only the soft inclusion, so the refreshed Chebyshev estimates are rescaled by a factor other than one
+      filter: grep -v -e "^\[[1-7]\]" -e KSPSolve_Private -e KSPConvergedDefault -e "Eigen estimator"
+      args: -ne 11 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_gamg_numeric_refresh -pc_mg_esteig_refresh 3 -two_solves -two_solves_alpha 1.e-1 -info :ksp -ksp_converged_reason -use_mat_nearnullspace -mg_levels_ksp_max_it 2 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 100 -pc_gamg_repartition false -ksp_monitor_short
+
+   test:
+      suffix: sa_esteig
+      nsize: 8
+      # the smoothers take the estimates from SA and do not run their own estimator
+      filter: grep -e "eigenvalue" -e "Linear solve"
+      args: -ne 11 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_gamg_use_sa_esteig true -ksp_view -ksp_converged_reason -use_mat_nearnullspace -mg_levels_ksp_max_it 2 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 100 -pc_gamg_repartition false
+
+   test:
+      suffix: fused
+      nsize: 8
+      args: -ne 11 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_mg_fused -ksp_converged_reason -use_mat_nearnullspace -mg_levels_ksp_max_it 2 -mg_levels_ksp_type chebyshev -mg_levels_pc_type jacobi -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 100 -pc_gamg_repartition false -ksp_monitor_short
+
    test:
       suffix: seqaijmkl
       nsize: 8
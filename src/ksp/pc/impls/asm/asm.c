@@ -32,6 +32,11 @@ static PetscErrorCode PCView_ASM(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  restriction/interpolation type - %s\n",PCASMTypes[osm->type]);CHKERRQ(ierr);
     if (osm->dm_subdomains) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: using DM to define subdomains\n");CHKERRQ(ierr);}
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: local solve composition type - %s\n",PCCompositeTypes[osm->loctype]);CHKERRQ(ierr);}
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+    if (osm->nthreads > 1) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: %D threads requested for the local blocks\n",osm->nthreads);CHKERRQ(ierr);}
+#else
+    if (osm->nthreads > 1) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: %D threads requested for the local blocks, ignored without OpenMP and --with-threadsafety\n",osm->nthreads);CHKERRQ(ierr);}
+#endif
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
     if (osm->same_local_solves) {
       if (osm->ksp) {
@@ -415,19 +420,11 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_ASM(PC pc)
 {
-  PC_ASM             *osm = (PC_ASM*)pc->data;
-  PetscErrorCode     ierr;
-  PetscInt           i;
-  KSPConvergedReason reason;
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  for (i=0; i<osm->n_local_true; i++) {
-    ierr = KSPSetUp(osm->ksp[i]);CHKERRQ(ierr);
-    ierr = KSPGetConvergedReason(osm->ksp[i],&reason);CHKERRQ(ierr);
-    if (reason == KSP_DIVERGED_PC_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
-    }
-  }
+  ierr = PCSetUpBlocks_Private(pc,osm->n_local_true,osm->ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -461,33 +458,48 @@ static PetscErrorCode PCApply_ASM(PC pc,Vec x,Vec y)
     ierr = VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
     ierr = VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
 
-    /* restrict local RHS to the overlapping 0-block RHS */
-    ierr = VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
-    ierr = VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
+    if (osm->loctype == PC_COMPOSITE_ADDITIVE) {
+      /* restrict local RHS to all the overlapping blocks, whose solves are then independent of each other */
+      for (i = 0; i < n_local_true; ++i) {
+        ierr = VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+        ierr = VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+      }
+
+      /* solve the overlapping blocks, concurrently if requested */
+      ierr = PCApplyBlocks_Private(pc, osm->nthreads, n_local_true, osm->ksp, osm->x, osm->y, PETSC_FALSE);CHKERRQ(ierr);
+
+      for (i = 0; i < n_local_true; ++i) {
+        if (osm->lprolongation) { /* interpolate the non-overlapping i-block solution to the local solution (only for restrictive additive) */
+          ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+        } else { /* interpolate the overlapping i-block solution to the local solution */
+          ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+        }
+      }
+    } else {
+      /* restrict local RHS to the overlapping 0-block RHS */
+      ierr = VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
+      ierr = VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
 
-    /* do the local solves */
-    for (i = 0; i < n_local_true; ++i) {
+      /* do the local solves, one after another since each one updates the RHS of the next */
+      for (i = 0; i < n_local_true; ++i) {
 
-      /* solve the overlapping i-block */
-      ierr = PetscLogEventBegin(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i],0);CHKERRQ(ierr);
-      ierr = KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
-      ierr = KSPCheckSolve(osm->ksp[i], pc, osm->y[i]);CHKERRQ(ierr);
-      ierr = PetscLogEventEnd(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0);CHKERRQ(ierr);
+        /* solve the overlapping i-block */
+        ierr = PetscLogEventBegin(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i],0);CHKERRQ(ierr);
+        ierr = KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
+        ierr = KSPCheckSolve(osm->ksp[i], pc, osm->y[i]);CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(PC_ApplyOnBlocks, osm->ksp[i], osm->x[i], osm->y[i], 0);CHKERRQ(ierr);
 
-      if (osm->lprolongation) { /* interpolate the non-overlapping i-block solution to the local solution (only for restrictive additive) */
-        ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-        ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-      } else { /* interpolate the overlapping i-block solution to the local solution */
+        /* interpolate the overlapping i-block solution to the local solution */
         ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
         ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
-      }
 
-      if (i < n_local_true-1) {
-        /* restrict local RHS to the overlapping (i+1)-block RHS */
-        ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
-        ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+        if (i < n_local_true-1) {
+          /* restrict local RHS to the overlapping (i+1)-block RHS */
+          ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
 
-        if (osm->loctype == PC_COMPOSITE_MULTIPLICATIVE) {
           /* update the overlapping (i+1)-block RHS using the current local solution */
           ierr = MatMult(osm->lmats[i+1], osm->ly, osm->y[i+1]);CHKERRQ(ierr);
           ierr = VecAXPBY(osm->x[i+1],-1.,1., osm->y[i+1]); CHKERRQ(ierr);
@@ -611,19 +623,16 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc,Vec x,Vec y)
   ierr = VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
   ierr = VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
 
-  /* Restrict local RHS to the overlapping 0-block RHS */
-  ierr = VecScatterBegin(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
-  ierr = VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0], INSERT_VALUES, forward);CHKERRQ(ierr);
-
-  /* do the local solves */
+  /* Restrict local RHS to all the overlapping blocks */
   for (i = 0; i < n_local_true; ++i) {
+    ierr = VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+  }
 
-    /* solve the overlapping i-block */
-    ierr = PetscLogEventBegin(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolveTranspose(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(osm->ksp[i],pc,osm->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
+  /* solve the overlapping blocks, concurrently if requested */
+  ierr = PCApplyBlocks_Private(pc, osm->nthreads, n_local_true, osm->ksp, osm->x, osm->y, PETSC_TRUE);CHKERRQ(ierr);
 
+  for (i = 0; i < n_local_true; ++i) {
     if (osm->lprolongation) { /* interpolate the non-overlapping i-block solution to the local solution */
       ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
       ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
@@ -631,12 +640,6 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc,Vec x,Vec y)
       ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
       ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
     }
-
-    if (i < n_local_true-1) {
-      /* Restrict local RHS to the overlapping (i+1)-block RHS */
-      ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
-      ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
-    }
   }
   /* Add the local solution to the global solution including the ghost nodes */
   ierr = VecScatterBegin(osm->restriction, osm->ly, y, ADD_VALUES, reverse);CHKERRQ(ierr);
@@ -714,7 +717,7 @@ static PetscErrorCode PCSetFromOptions_ASM(PetscOptionItems *PetscOptionsObject,
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
   PetscErrorCode ierr;
-  PetscInt       blocks,ovl;
+  PetscInt       blocks,ovl,nthreads;
   PetscBool      flg;
   PCASMType      asmtype;
   PCCompositeType loctype;
@@ -744,6 +747,8 @@ static PetscErrorCode PCSetFromOptions_ASM(PetscOptionItems *PetscOptionsObject,
   flg  = PETSC_FALSE;
   ierr = PetscOptionsEnum("-pc_asm_local_type","Type of local solver composition","PCASMSetLocalType",PCCompositeTypes,(PetscEnum)osm->loctype,(PetscEnum*)&loctype,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCASMSetLocalType(pc,loctype);CHKERRQ(ierr); }
+  ierr = PetscOptionsInt("-pc_asm_block_threads","Number of OpenMP threads for the solves of the local blocks","PCASMSetBlockThreads",osm->nthreads,&nthreads,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = PCASMSetBlockThreads(pc,nthreads);CHKERRQ(ierr);}
   ierr = PetscOptionsFList("-pc_asm_sub_mat_type","Subsolve Matrix Type","PCASMSetSubMatType",MatList,NULL,sub_mat_type,256,&flg);CHKERRQ(ierr);
   if (flg) {
     ierr = PCASMSetSubMatType(pc,sub_mat_type);CHKERRQ(ierr);
@@ -880,6 +885,15 @@ static PetscErrorCode  PCASMGetLocalType_ASM(PC pc, PCCompositeType *type)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCASMSetBlockThreads_ASM(PC pc,PetscInt nthreads)
+{
+  PC_ASM *osm = (PC_ASM*)pc->data;
+
+  PetscFunctionBegin;
+  osm->nthreads = nthreads;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCASMSetSortIndices_ASM(PC pc,PetscBool  doSort)
 {
   PC_ASM *osm = (PC_ASM*)pc->data;
@@ -1218,6 +1232,44 @@ PetscErrorCode PCASMGetLocalType(PC pc, PCCompositeType *type)
   PetscFunctionReturn(0);
 }
 
+/*@
+  PCASMSetBlockThreads - Sets the number of OpenMP threads used to solve the local blocks of the additive Schwarz
+  method concurrently.
+
+  Logically Collective on pc
+
+  Input Parameters:
++ pc  - the preconditioner context
+- nthreads - number of threads, 1 (the default) to handle the local blocks one after another
+
+  Options Database Key:
+. -pc_asm_block_threads <nthreads> - Sets the number of threads
+
+  Notes:
+  Intended for runs with few MPI processes, each with many local blocks (see PCASMSetLocalSubdomains()), for example
+  one process per socket. The blocks are distributed dynamically over the threads, each block keeps its own work
+  vectors. The setup (factorization) of the blocks, the restrictions to and the interpolations from the blocks are
+  still done by the calling thread.
+
+  Only the PC_COMPOSITE_ADDITIVE local composition is threaded, the blocks of PC_COMPOSITE_MULTIPLICATIVE depend on
+  each other. Requires PETSc be configured with OpenMP and --with-threadsafety, otherwise the value is ignored.
+
+  Level: intermediate
+
+.seealso: PCASMSetLocalSubdomains(), PCASMSetLocalType(), PCASMGetSubKSP(), PCBJacobiSetBlockThreads()
+@*/
+PetscErrorCode PCASMSetBlockThreads(PC pc,PetscInt nthreads)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,nthreads,2);
+  if (nthreads < 1) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",nthreads);
+  ierr = PetscTryMethod(pc,"PCASMSetBlockThreads_C",(PC,PetscInt),(pc,nthreads));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
     PCASMSetSortIndices - Determines whether subdomain indices are sorted.
 
@@ -1290,7 +1342,8 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 +  -pc_asm_blocks <blks> - Sets total blocks
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets ASM type, default is restrict
--  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+.  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+-  -pc_asm_block_threads <nthreads> - Sets the number of OpenMP threads for the local blocks, see PCASMSetBlockThreads()
 
      IMPORTANT: If you run with, for example, 3 blocks on 1 processor or 3 blocks on 3 processors you
       will get a different convergence rate due to the default option of -pc_asm_type restrict. Use
@@ -1349,6 +1402,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   osm->sort_indices      = PETSC_TRUE;
   osm->dm_subdomains     = PETSC_FALSE;
   osm->sub_mat_type      = NULL;
+  osm->nthreads          = 1;
 
   pc->data                 = (void*)osm;
   pc->ops->apply           = PCApply_ASM;
@@ -1373,6 +1427,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubKSP_C",PCASMGetSubKSP_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubMatType_C",PCASMGetSubMatType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSubMatType_C",PCASMSetSubMatType_ASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetBlockThreads_C",PCASMSetBlockThreads_ASM);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -167,6 +167,8 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PetscOptionItems *PetscOptionsObj
   if (flg) {ierr = PCBJacobiSetTotalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
   ierr = PetscOptionsInt("-pc_bjacobi_local_blocks","Local number of blocks","PCBJacobiSetLocalBlocks",jac->n_local,&blocks,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCBJacobiSetLocalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-pc_bjacobi_block_threads","Number of OpenMP threads for the solves of the local blocks","PCBJacobiSetBlockThreads",jac->nthreads,&blocks,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = PCBJacobiSetBlockThreads(pc,blocks);CHKERRQ(ierr);}
   if (jac->ksp) {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
@@ -198,6 +200,11 @@ static PetscErrorCode PCView_BJacobi(PC pc,PetscViewer viewer)
       ierr = PetscViewerASCIIPrintf(viewer,"  using Amat local matrix, number of blocks = %D\n",jac->n);CHKERRQ(ierr);
     }
     ierr = PetscViewerASCIIPrintf(viewer,"  number of blocks = %D\n",jac->n);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+    if (jac->nthreads > 1) {ierr = PetscViewerASCIIPrintf(viewer,"  %D threads requested for the local blocks\n",jac->nthreads);CHKERRQ(ierr);}
+#else
+    if (jac->nthreads > 1) {ierr = PetscViewerASCIIPrintf(viewer,"  %D threads requested for the local blocks, ignored without OpenMP and --with-threadsafety\n",jac->nthreads);CHKERRQ(ierr);}
+#endif
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
     if (jac->same_local_solves) {
       ierr = PetscViewerASCIIPrintf(viewer,"  Local solver is the same for all blocks, as in the following KSP and PC objects on rank 0:\n");CHKERRQ(ierr);
@@ -333,6 +340,15 @@ static PetscErrorCode  PCBJacobiGetLocalBlocks_BJacobi(PC pc, PetscInt *blocks,
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCBJacobiSetBlockThreads_BJacobi(PC pc,PetscInt nthreads)
+{
+  PC_BJacobi *jac = (PC_BJacobi*)pc->data;
+
+  PetscFunctionBegin;
+  jac->nthreads = nthreads;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 /*@C
@@ -497,6 +513,43 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCBJacobiSetBlockThreads - Sets the number of OpenMP threads used to solve the blocks owned by each process
+   concurrently.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  nthreads - number of threads, 1 (the default) to handle the local blocks one after another
+
+   Options Database Key:
+.  -pc_bjacobi_block_threads <nthreads> - Sets the number of threads
+
+   Notes:
+   Intended for runs with few MPI processes, each with many local blocks (see PCBJacobiSetLocalBlocks()), for example
+   one process per socket. The blocks are distributed dynamically over the threads, each block keeps its own work
+   vectors. Has no effect with a single block per process or with blocks shared by several processes. The blocks are
+   still set up (factored) one after another, since creating PETSc objects is not thread safe.
+
+   Requires PETSc be configured with OpenMP and --with-threadsafety, otherwise the value is ignored.
+
+   Level: intermediate
+
+.seealso: PCBJacobiSetLocalBlocks(), PCBJacobiGetSubKSP(), PCASMSetBlockThreads()
+@*/
+PetscErrorCode  PCBJacobiSetBlockThreads(PC pc,PetscInt nthreads)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,nthreads,2);
+  if (nthreads < 1) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",nthreads);
+  ierr = PetscTryMethod(pc,"PCBJacobiSetBlockThreads_C",(PC,PetscInt),(pc,nthreads));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -----------------------------------------------------------------------------------*/
 
 /*MC
@@ -505,7 +558,8 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_block_threads <nthreads> - use nthreads OpenMP threads for the local blocks, see PCBJacobiSetBlockThreads()
 
    Notes:
     Each processor can have one or more blocks, or a single block can be shared by several processes. Defaults to one block per processor.
@@ -560,12 +614,14 @@ PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
   jac->g_lens            = NULL;
   jac->l_lens            = NULL;
   jac->psubcomm          = NULL;
+  jac->nthreads          = 1;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetSubKSP_C",PCBJacobiGetSubKSP_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetTotalBlocks_C",PCBJacobiSetTotalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetTotalBlocks_C",PCBJacobiGetTotalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetLocalBlocks_C",PCBJacobiSetLocalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetLocalBlocks_C",PCBJacobiGetLocalBlocks_BJacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetBlockThreads_C",PCBJacobiSetBlockThreads_BJacobi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -890,19 +946,11 @@ static PetscErrorCode PCDestroy_BJacobi_Multiblock(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_BJacobi_Multiblock(PC pc)
 {
-  PC_BJacobi         *jac = (PC_BJacobi*)pc->data;
-  PetscErrorCode     ierr;
-  PetscInt           i,n_local = jac->n_local;
-  KSPConvergedReason reason;
+  PC_BJacobi     *jac = (PC_BJacobi*)pc->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  for (i=0; i<n_local; i++) {
-    ierr = KSPSetUp(jac->ksp[i]);CHKERRQ(ierr);
-    ierr = KSPGetConvergedReason(jac->ksp[i],&reason);CHKERRQ(ierr);
-    if (reason == KSP_DIVERGED_PC_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
-    }
-  }
+  ierr = PCSetUpBlocks_Private(pc,jac->n_local,jac->ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -929,12 +977,9 @@ static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc,Vec x,Vec y)
     */
     ierr = VecPlaceArray(bjac->x[i],xin+bjac->starts[i]);CHKERRQ(ierr);
     ierr = VecPlaceArray(bjac->y[i],yin+bjac->starts[i]);CHKERRQ(ierr);
-
-    ierr = PetscLogEventBegin(PC_ApplyOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolve(jac->ksp[i],bjac->x[i],bjac->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(jac->ksp[i],pc,bjac->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-
+  }
+  ierr = PCApplyBlocks_Private(pc,jac->nthreads,n_local,jac->ksp,bjac->x,bjac->y,PETSC_FALSE);CHKERRQ(ierr);
+  for (i=0; i<n_local; i++) {
     ierr = VecResetArray(bjac->x[i]);CHKERRQ(ierr);
     ierr = VecResetArray(bjac->y[i]);CHKERRQ(ierr);
   }
@@ -966,12 +1011,9 @@ static PetscErrorCode PCApplyTranspose_BJacobi_Multiblock(PC pc,Vec x,Vec y)
     */
     ierr = VecPlaceArray(bjac->x[i],xin+bjac->starts[i]);CHKERRQ(ierr);
     ierr = VecPlaceArray(bjac->y[i],yin+bjac->starts[i]);CHKERRQ(ierr);
-
-    ierr = PetscLogEventBegin(PC_ApplyTransposeOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolveTranspose(jac->ksp[i],bjac->x[i],bjac->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(jac->ksp[i],pc,bjac->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyTransposeOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-
+  }
+  ierr = PCApplyBlocks_Private(pc,jac->nthreads,n_local,jac->ksp,bjac->x,bjac->y,PETSC_TRUE);CHKERRQ(ierr);
+  for (i=0; i<n_local; i++) {
     ierr = VecResetArray(bjac->x[i]);CHKERRQ(ierr);
     ierr = VecResetArray(bjac->y[i]);CHKERRQ(ierr);
   }
@@ -20,6 +20,7 @@ typedef struct {
   PetscInt     *l_lens;           /* lens of each block */
   PetscInt     *g_lens;
   PetscSubcomm psubcomm;          /* for multiple processors per block */
+  PetscInt     nthreads;          /* number of OpenMP threads for the solves of multiple local blocks */
 } PC_BJacobi;
 
 /*
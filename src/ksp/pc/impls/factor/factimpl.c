@@ -230,6 +230,7 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
   PetscFunctionList ordlist;
   PetscEnum         etmp;
   PetscBool         inplace;
+  PetscInt          nthreads;
 
   PetscFunctionBegin;
   ierr = PCFactorGetUseInPlace(pc,&inplace);CHKERRQ(ierr);
@@ -261,6 +262,10 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
   if (set) {
     ierr = PCFactorSetReuseOrdering(pc,flg);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsInt("-pc_factor_mat_solve_threads","Number of OpenMP threads for the triangular solves","PCFactorSetMatSolveThreads",(PetscInt)factor->info.solvethreads,&nthreads,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PCFactorSetMatSolveThreads(pc,nthreads);CHKERRQ(ierr);
+  }
 
   ierr = MatGetOrderingList(&ordlist);CHKERRQ(ierr);
   ierr = PetscOptionsFList("-pc_factor_mat_ordering_type","Reordering to reduce nonzeros in factored matrix","PCFactorSetMatOrderingType",ordlist,((PC_Factor*)factor)->ordering,tname,sizeof(tname),&flg);CHKERRQ(ierr);
@@ -296,6 +301,7 @@ PetscErrorCode PCView_Factor(PC pc,PetscViewer viewer)
 
     if (factor->reusefill)     {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing fill from past factorization\n");CHKERRQ(ierr);}
     if (factor->reuseordering) {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing reordering from past factorization\n");CHKERRQ(ierr);}
+    if (factor->info.solvethreads > 1) {ierr = PetscViewerASCIIPrintf(viewer,"  %D threads requested for the triangular solves\n",(PetscInt)factor->info.solvethreads);CHKERRQ(ierr);}
     if (factor->factortype == MAT_FACTOR_ILU || factor->factortype == MAT_FACTOR_ICC) {
       if (factor->info.dt > 0) {
         ierr = PetscViewerASCIIPrintf(viewer,"  drop tolerance %g\n",(double)factor->info.dt);CHKERRQ(ierr);
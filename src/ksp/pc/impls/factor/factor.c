@@ -19,6 +19,15 @@ static PetscErrorCode PCFactorSetReuseFill_Factor(PC pc,PetscBool flag)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCFactorSetMatSolveThreads_Factor(PC pc,PetscInt nthreads)
+{
+  PC_Factor *lu = (PC_Factor*)pc->data;
+
+  PetscFunctionBegin;
+  lu->info.solvethreads = (PetscReal)nthreads;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCFactorSetUseInPlace_Factor(PC pc,PetscBool flg)
 {
   PC_Factor *dir = (PC_Factor*)pc->data;
@@ -674,6 +683,43 @@ PetscErrorCode  PCFactorSetReuseFill(PC pc,PetscBool flag)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCFactorSetMatSolveThreads - Sets the number of OpenMP threads used when applying the factored matrix
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  nthreads - number of threads, 1 (the default) for the usual sequential triangular solves
+
+   Options Database Key:
+.  -pc_factor_mat_solve_threads <nthreads> - Sets the number of threads
+
+   Notes:
+   Currently only used by the PETSc LU and ILU factorizations of MATSEQAIJ matrices (also as the blocks of PCBJACOBI
+   and PCASM, with the sub_ prefix). At each numeric factorization the rows of the L and U factors are grouped into
+   levels of independent rows and MatSolve() then works on one level at a time, dividing its rows between the threads.
+   This only pays off when the levels are large; their number and average size are reported by -info and -ksp_view.
+
+   Requires PETSc be configured with OpenMP, otherwise the value is ignored. Takes effect at the next numeric
+   factorization.
+
+   Level: intermediate
+
+.seealso: PCFactorSetLevels(), MatSolve()
+@*/
+PetscErrorCode  PCFactorSetMatSolveThreads(PC pc,PetscInt nthreads)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,nthreads,2);
+  if (nthreads < 1) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",nthreads);
+  ierr = PetscTryMethod(pc,"PCFactorSetMatSolveThreads_C",(PC,PetscInt),(pc,nthreads));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCFactorInitialize(PC pc)
 {
   PetscErrorCode ierr;
@@ -685,6 +731,7 @@ PetscErrorCode PCFactorInitialize(PC pc)
   fact->info.shiftamount     = 100.0*PETSC_MACHINE_EPSILON;
   fact->info.zeropivot       = 100.0*PETSC_MACHINE_EPSILON;
   fact->info.pivotinblocks   = 1.0;
+  fact->info.solvethreads    = 1.0;
   pc->ops->getfactoredmatrix = PCFactorGetMatrix_Factor;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetZeroPivot_C",PCFactorSetZeroPivot_Factor);CHKERRQ(ierr);
@@ -707,5 +754,6 @@ PetscErrorCode PCFactorInitialize(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorGetUseInPlace_C",PCFactorGetUseInPlace_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseOrdering_C",PCFactorSetReuseOrdering_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseFill_C",PCFactorSetReuseFill_Factor);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetMatSolveThreads_C",PCFactorSetMatSolveThreads_Factor);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
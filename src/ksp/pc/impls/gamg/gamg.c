@@ -29,6 +29,20 @@ static PetscFunctionList GAMGList = NULL;
 static PetscBool PCGAMGPackageInitialized;
 
 /* ----------------------------------------------------------------------------- */
+static PetscErrorCode PCGAMGDestroyRefresh_Private(PC_GAMG *pc_gamg)
+{
+  PetscErrorCode ierr;
+  PetscInt       level;
+
+  PetscFunctionBegin;
+  for (level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+    ierr = MatDestroy(&pc_gamg->refresh_P[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->refresh_C[level]);CHKERRQ(ierr);
+    ierr = ISDestroy(&pc_gamg->refresh_is[level]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCReset_GAMG(PC pc)
 {
   PetscErrorCode ierr, level;
@@ -36,6 +50,7 @@ PetscErrorCode PCReset_GAMG(PC pc)
   PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
 
   PetscFunctionBegin;
+  ierr = PCGAMGDestroyRefresh_Private(pc_gamg);CHKERRQ(ierr);
   ierr = PetscFree(pc_gamg->data);CHKERRQ(ierr);
   pc_gamg->data_sz = 0;
   ierr = PetscFree(pc_gamg->orig_data);CHKERRQ(ierr);
@@ -63,6 +78,9 @@ PetscErrorCode PCReset_GAMG(PC pc)
    . a_nactive_proc - number of active procs
    Output Parameter:
    . a_Amat_crs - coarse matrix that is created (k-1)
+
+   With -pc_gamg_numeric_refresh the prolongator before repartitioning, the P'AP product and the repartitioned rows
+   are kept in 'pc_gamg->refresh_*' so later setups only redo the numeric part, see PCGAMGNumericRefresh_Private()
 */
 
 static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,Mat *a_P_inout,Mat *a_Amat_crs,PetscMPIInt *a_nactive_proc,IS * Pcolumnperm, PetscBool is_last)
@@ -81,6 +99,17 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
   ierr = MatGetBlockSize(Amat_fine, &f_bs);CHKERRQ(ierr);
   ierr = MatPtAP(Amat_fine, Pold, MAT_INITIAL_MATRIX, 2.0, &Cmat);CHKERRQ(ierr);
+  if (pc_gamg->numeric_refresh) {
+    PetscInt level = pc_gamg->current_level;
+
+    ierr = PetscObjectReference((PetscObject)Pold);CHKERRQ(ierr);
+    ierr = PetscObjectReference((PetscObject)Cmat);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->refresh_P[level]);CHKERRQ(ierr);
+    ierr = MatDestroy(&pc_gamg->refresh_C[level]);CHKERRQ(ierr);
+    ierr = ISDestroy(&pc_gamg->refresh_is[level]);CHKERRQ(ierr);
+    pc_gamg->refresh_P[level] = Pold;
+    pc_gamg->refresh_C[level] = Cmat;
+  }
 
   if (Pcolumnperm) *Pcolumnperm = NULL;
 
@@ -356,6 +385,10 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
       ierr = PetscObjectReference((PetscObject)new_eq_indices);CHKERRQ(ierr);
       *Pcolumnperm = new_eq_indices;
     }
+    if (pc_gamg->numeric_refresh) {
+      ierr = PetscObjectReference((PetscObject)new_eq_indices);CHKERRQ(ierr);
+      pc_gamg->refresh_is[pc_gamg->current_level] = new_eq_indices;
+    }
     ierr = ISDestroy(&is_eq_num);CHKERRQ(ierr);
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET13],0,0,0,0);CHKERRQ(ierr);
@@ -425,6 +458,60 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGNumericRefresh_Private - Recomputes the coarse operators of a hierarchy built with -pc_gamg_numeric_refresh
+   for new values of the fine grid operator with the same nonzero pattern. The aggregates, prolongators, symbolic
+   P'AP products and repartitioning of the first setup are kept; only the numeric P'AP, the move of the coarse
+   operators to their repartitioned rows and the setup of the smoothers are done again.
+
+   Input Parameter:
+.  pc - the preconditioner context
+*/
+static PetscErrorCode PCGAMGNumericRefresh_Private(PC pc)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg       = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg  = (PC_GAMG*)mg->innerctx;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscInt       level,lidx;
+  Mat            dA,dB,B;
+
+  PetscFunctionBegin;
+#if defined PETSC_GAMG_USE_LOG
+  ierr = PetscLogEventBegin(petsc_gamg_setup_events[REFRESH],0,0,0,0);CHKERRQ(ierr);
+#endif
+  /* (re)set to get dirty flag */
+  ierr = KSPGetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,&dA,&dB);CHKERRQ(ierr);
+  ierr = KSPSetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,dA,dB);CHKERRQ(ierr);
+  for (level = 0, lidx = pc_gamg->Nlevels-2; lidx >= 0; level++, lidx--) {
+#if defined PETSC_GAMG_USE_LOG
+    ierr = PetscLogEventBegin(petsc_gamg_setup_events[REFRESH_PTAP],0,0,0,0);CHKERRQ(ierr);
+#endif
+    ierr = MatPtAP(dB,pc_gamg->refresh_P[level],MAT_REUSE_MATRIX,1.0,&pc_gamg->refresh_C[level]);CHKERRQ(ierr);
+#if defined PETSC_GAMG_USE_LOG
+    ierr = PetscLogEventEnd(petsc_gamg_setup_events[REFRESH_PTAP],0,0,0,0);CHKERRQ(ierr);
+#endif
+    ierr = KSPGetOperators(mglevels[lidx]->smoothd,NULL,&B);CHKERRQ(ierr);
+    if (pc_gamg->refresh_is[level]) {
+#if defined PETSC_GAMG_USE_LOG
+      ierr = PetscLogEventBegin(petsc_gamg_setup_events[REFRESH_MOVE],0,0,0,0);CHKERRQ(ierr);
+#endif
+      ierr = MatCreateSubMatrix(pc_gamg->refresh_C[level],pc_gamg->refresh_is[level],pc_gamg->refresh_is[level],MAT_REUSE_MATRIX,&B);CHKERRQ(ierr);
+#if defined PETSC_GAMG_USE_LOG
+      ierr = PetscLogEventEnd(petsc_gamg_setup_events[REFRESH_MOVE],0,0,0,0);CHKERRQ(ierr);
+#endif
+    } else if (B != pc_gamg->refresh_C[level]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Coarse operator on level %D is not the kept Galerkin product",level);
+    ierr = KSPSetOperators(mglevels[lidx]->smoothd,B,B);CHKERRQ(ierr);
+    dB   = B;
+  }
+#if defined PETSC_GAMG_USE_LOG
+  ierr = PetscLogEventEnd(petsc_gamg_setup_events[REFRESH],0,0,0,0);CHKERRQ(ierr);
+#endif
+  ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCSetUp_GAMG - Prepares for the use of the GAMG preconditioner
@@ -455,7 +542,16 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
 
   if (pc_gamg->setup_count++ > 0) {
-    if ((PetscBool)(!pc_gamg->reuse_prol)) {
+    if (pc_gamg->numeric_refresh && pc_gamg->Nlevels > 1 && pc_gamg->refresh_C[0]) {
+      if (pc->flag == SAME_NONZERO_PATTERN) {
+        ierr = PetscInfo1(pc,"Numeric refresh of the Galerkin operators, %D setup\n",pc_gamg->setup_count);CHKERRQ(ierr);
+        ierr = PCGAMGNumericRefresh_Private(pc);CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+      }
+      ierr = PetscInfo(pc,"Nonzero pattern changed, rebuilding the hierarchy instead of a numeric refresh\n");CHKERRQ(ierr);
+    }
+    ierr = PCGAMGDestroyRefresh_Private(pc_gamg);CHKERRQ(ierr);
+    if ((PetscBool)(!pc_gamg->reuse_prol) || pc_gamg->numeric_refresh) {
       /* reset everything */
       ierr = PCReset_MG(pc);CHKERRQ(ierr);
       pc->setupcalled = 0;
@@ -511,7 +607,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   }
 
   /* cache original data for reuse */
-  if (!pc_gamg->orig_data && (PetscBool)(!pc_gamg->reuse_prol)) {
+  if (!pc_gamg->orig_data && ((PetscBool)(!pc_gamg->reuse_prol) || pc_gamg->numeric_refresh)) {
     ierr = PetscMalloc1(pc_gamg->data_sz, &pc_gamg->orig_data);CHKERRQ(ierr);
     for (qq=0; qq<pc_gamg->data_sz; qq++) pc_gamg->orig_data[qq] = pc_gamg->data[qq];
     pc_gamg->orig_data_cell_rows = pc_gamg->data_cell_rows;
@@ -691,34 +787,35 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     ierr = PetscOptionsEnd();CHKERRQ(ierr);
     ierr = PCMGSetGalerkin(pc,PC_MG_GALERKIN_EXTERNAL);CHKERRQ(ierr);
 
-    ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
-
-    /* setup cheby eigen estimates from SA */
+    /* setup cheby eigen estimates from SA, before the smoothers are set up so they do not compute their own; options
+       such as -mg_levels_ksp_chebyshev_eigenvalues still take precedence since PCSetUp_MG() applies them afterwards */
     for (lidx = 1, level = pc_gamg->Nlevels-2; level >= 0 ; lidx++, level--) {
       KSP       smoother;
       PetscBool ischeb;
       ierr = PCMGGetSmoother(pc, lidx, &smoother);CHKERRQ(ierr);
       ierr = PetscObjectTypeCompare((PetscObject)smoother,KSPCHEBYSHEV,&ischeb);CHKERRQ(ierr);
-      if (ischeb) {
-        KSP_Chebyshev  *cheb = (KSP_Chebyshev*)smoother->data;
-        if (mg->max_eigen_DinvA[level] > 0 && cheb->emax == 0.) { /* let command line emax override using SA's eigenvalues */
-          PC        subpc;
-          PetscBool isjac;
-          ierr = KSPGetPC(smoother, &subpc);CHKERRQ(ierr);
-          ierr = PetscObjectTypeCompare((PetscObject)subpc,PCJACOBI,&isjac);CHKERRQ(ierr);
-          if ( (isjac && pc_gamg->use_sa_esteig==-1) || pc_gamg->use_sa_esteig==1) {
-            PetscReal       emax,emin;
-            emin = mg->min_eigen_DinvA[level];
-            emax = mg->max_eigen_DinvA[level];
-            ierr = PetscInfo4(pc,"PCSetUp_GAMG: call KSPChebyshevSetEigenvalues on level %D (N=%D) with emax = %g emin = %g\n",level,Aarr[level]->rmap->N,(double)emax,(double)emin);CHKERRQ(ierr);
-            cheb->emin_computed = emin;
-            cheb->emax_computed = emax;
-            ierr = KSPChebyshevSetEigenvalues(smoother, cheb->tform[2]*emin + cheb->tform[3]*emax, cheb->tform[0]*emin + cheb->tform[1]*emax);CHKERRQ(ierr);
-          }
+      if (ischeb && mg->max_eigen_DinvA[level] > 0) {
+        KSP_Chebyshev *cheb = (KSP_Chebyshev*)smoother->data;
+        PC            subpc;
+        PetscBool     isjac;
+        ierr = KSPGetPC(smoother, &subpc);CHKERRQ(ierr);
+        ierr = PetscObjectTypeCompare((PetscObject)subpc,PCJACOBI,&isjac);CHKERRQ(ierr);
+        /* by default only when the smoother already uses Jacobi, like SA, and has no eigenvalues; the level options,
+           such as -mg_levels_pc_type, are only applied in PCSetUp_MG() */
+        if ((isjac && pc_gamg->use_sa_esteig == -1 && cheb->emax == 0.) || pc_gamg->use_sa_esteig == 1) {
+          PetscReal emax,emin;
+          emin = mg->min_eigen_DinvA[level];
+          emax = mg->max_eigen_DinvA[level];
+          ierr = PetscInfo4(pc,"PCSetUp_GAMG: call KSPChebyshevSetEigenvalues on level %D (N=%D) with emax = %g emin = %g\n",level,Aarr[level]->rmap->N,(double)emax,(double)emin);CHKERRQ(ierr);
+          cheb->emin_computed = emin;
+          cheb->emax_computed = emax;
+          ierr = KSPChebyshevSetEigenvalues(smoother, cheb->tform[2]*emin + cheb->tform[3]*emax, cheb->tform[0]*emin + cheb->tform[1]*emax);CHKERRQ(ierr);
         }
       }
     }
 
+    ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
+
     /* clean up */
     for (level=1; level<pc_gamg->Nlevels; level++) {
       ierr = MatDestroy(&Parr[level]);CHKERRQ(ierr);
@@ -934,6 +1031,10 @@ static PetscErrorCode PCGAMGSetEstEigKSPMaxIt_GAMG(PC pc, PetscInt n)
 .  -pc_gamg_use_sa_esteig <true,false>
 
    Notes:
+   With PETSC_TRUE the estimates are given to the Chebyshev smoothers before they are set up, so the smoothers do not run
+   their own estimator, and they are taken again each time the hierarchy is rebuilt. When it is not, with
+   PCGAMGSetReuseInterpolation() or PCGAMGSetNumericRefresh(), use PCMGSetEstEigRefresh() to have the smoothers scale
+   them as the matrix values change. Options such as -mg_levels_ksp_chebyshev_esteig still have the smoothers estimate.
 
    Level: intermediate
 
@@ -1056,7 +1157,7 @@ static PetscErrorCode PCGAMGSetEigenvalues_GAMG(PC pc,PetscReal emax,PetscReal e
     this may negatively affect the convergence rate of the method on new matrices if the matrix entries change a great deal, but allows
           rebuilding the preconditioner quicker.
 
-.seealso: ()
+.seealso: PCGAMGSetNumericRefresh()
 @*/
 PetscErrorCode PCGAMGSetReuseInterpolation(PC pc, PetscBool n)
 {
@@ -1078,6 +1179,55 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetNumericRefresh - Keep the aggregates, prolongators, symbolic Galerkin products and repartitioning of the
+   first setup and only recompute the numeric Galerkin products and the smoothers when the operator is rebuilt with
+   the same nonzero pattern
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_numeric_refresh <true,false>
+
+   Level: intermediate
+
+   Notes:
+    Unlike PCGAMGSetReuseInterpolation() the symbolic P'AP is never redone, at the price of keeping the prolongators
+    and Galerkin products from before the repartitioning of the coarse grids. If the nonzero pattern of the operator
+    changes the hierarchy is rebuilt from scratch. As with reused interpolation the convergence rate may degrade if
+    the matrix entries change a great deal.
+
+    The time spent is logged in the events "GAMG: refresh", "  PtAP numeric" and "  Move A numeric", to compare with
+    "GAMG: createProl" and "GAMG: partLevel" of the first setup.
+
+   Must be set before the first PCSetUp().
+
+.seealso: PCGAMGSetReuseInterpolation()
+@*/
+PetscErrorCode PCGAMGSetNumericRefresh(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  ierr = PetscTryMethod(pc,"PCGAMGSetNumericRefresh_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetNumericRefresh_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->numeric_refresh = n;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGASMSetUseAggs - Have the PCGAMG smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner.
 
@@ -1492,6 +1642,9 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->use_parallel_coarse_grid_solver) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n");CHKERRQ(ierr);
   }
+  if (pc_gamg->numeric_refresh) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Only numeric Galerkin products recomputed when the nonzero pattern is unchanged\n");CHKERRQ(ierr);
+  }
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (pc_gamg->cpu_pin_coarse_grids) {
     /* ierr = PetscViewerASCIIPrintf(viewer,"      Pinning coarse grids to the CPU)\n");CHKERRQ(ierr); */
@@ -1537,6 +1690,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   ierr = PetscOptionsBool("-pc_gamg_use_sa_esteig","Use eigen estimate from Smoothed aggregation for smoother","PCGAMGSetUseSAEstEig",f2,&f2,&flag);CHKERRQ(ierr);
   if (flag) pc_gamg->use_sa_esteig = f2 ? 1 : 0;
   ierr = PetscOptionsBool("-pc_gamg_reuse_interpolation","Reuse prolongation operator","PCGAMGReuseInterpolation",pc_gamg->reuse_prol,&pc_gamg->reuse_prol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_gamg_numeric_refresh","Only recompute the numeric Galerkin products when the nonzero pattern is unchanged","PCGAMGSetNumericRefresh",pc_gamg->numeric_refresh,&pc_gamg->numeric_refresh,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids","Pin coarse grids to the CPU","PCGAMGSetCpuPinCoarseGrids",pc_gamg->cpu_pin_coarse_grids,&pc_gamg->cpu_pin_coarse_grids,NULL);CHKERRQ(ierr);
@@ -1579,6 +1733,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 +   -pc_gamg_type <type> - one of agg, geo, or classical
 .   -pc_gamg_repartition  <true,default=false> - repartition the degrees of freedom accross the coarse grids as they are determined
 .   -pc_gamg_reuse_interpolation <true,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations
+.   -pc_gamg_numeric_refresh <true,default=false> - when rebuilding with the same nonzero pattern also reuse the symbolic Galerkin products and repartitioning
 .   -pc_gamg_asm_use_agg <true,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
@@ -1589,7 +1744,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
    Options Database Keys for default Aggregation:
 +  -pc_gamg_agg_nsmooths <nsmooth, default=1> - number of smoothing steps to use with smooth aggregation
 .  -pc_gamg_sym_graph <true,default=false> - symmetrize the graph before computing the aggregation
--  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+.  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+-  -pc_gamg_aggressive_type <square,mis2> - square the graph on those levels, or aggregate with a distance-2 maximal independent set of the graph
 
    Multigrid options:
 +  -pc_mg_cycles <v> - v or w, see PCMGSetCycleType()
@@ -1607,7 +1763,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   Level: intermediate
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
-           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType()
+           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetUseSAEstEig(), PCGAMGSetEstEigKSPMaxIt(), PCGAMGSetEstEigKSPType(),
+           PCGAMGSetNumericRefresh()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1654,6 +1811,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetEigenvalues_C",PCGAMGSetEigenvalues_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseSAEstEig_C",PCGAMGSetUseSAEstEig_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseInterpolation_C",PCGAMGSetReuseInterpolation_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNumericRefresh_C",PCGAMGSetNumericRefresh_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCpuPinCoarseGrids_C",PCGAMGSetCpuPinCoarseGrids_GAMG);CHKERRQ(ierr);
@@ -1665,6 +1823,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNlevels_C",PCGAMGSetNlevels_GAMG);CHKERRQ(ierr);
   pc_gamg->repart           = PETSC_FALSE;
   pc_gamg->reuse_prol       = PETSC_FALSE;
+  pc_gamg->numeric_refresh  = PETSC_FALSE;
   pc_gamg->use_aggs_in_asm  = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids = PETSC_FALSE;
@@ -1735,6 +1894,9 @@ PetscErrorCode PCGAMGInitializePackage(void)
   ierr = PetscLogEventRegister("  Invert-Sort", PC_CLASSID, &petsc_gamg_setup_events[SET13]);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("  Move A", PC_CLASSID, &petsc_gamg_setup_events[SET14]);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("  Move P", PC_CLASSID, &petsc_gamg_setup_events[SET15]);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("GAMG: refresh", PC_CLASSID, &petsc_gamg_setup_events[REFRESH]);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("  PtAP numeric", PC_CLASSID, &petsc_gamg_setup_events[REFRESH_PTAP]);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("  Move A numeric", PC_CLASSID, &petsc_gamg_setup_events[REFRESH_MOVE]);CHKERRQ(ierr);
 
   /* PetscLogEventRegister(" PL move data", PC_CLASSID, &petsc_gamg_setup_events[SET13]); */
   /* PetscLogEventRegister("GAMG: fix", PC_CLASSID, &petsc_gamg_setup_events[SET10]); */
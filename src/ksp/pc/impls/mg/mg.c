@@ -12,6 +12,7 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
   PC_MG_Levels   *mgc,*mglevels = *mglevelsin;
   PetscErrorCode ierr;
   PetscInt       cycles = (mglevels->level == 1) ? 1 : (PetscInt) mglevels->cycles;
+  PetscBool      fused = PETSC_FALSE;
 
   PetscFunctionBegin;
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
@@ -19,9 +20,18 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
   ierr = KSPCheckSolve(mglevels->smoothd,pc,mglevels->x);CHKERRQ(ierr);
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   if (mglevels->level) {  /* not the coarsest grid */
-    if (mglevels->eventresidual) {ierr = PetscLogEventBegin(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
-    ierr = (*mglevels->residual)(mglevels->A,mglevels->b,mglevels->x,mglevels->r);CHKERRQ(ierr);
-    if (mglevels->eventresidual) {ierr = PetscLogEventEnd(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    mgc = *(mglevelsin - 1);
+    /* the residual itself is only needed for the convergence test on the finest level */
+    if (mg->fused && mglevels->residual == PCMGResidualDefault && !(mglevels->level == mglevels->levels-1 && mg->ttol && reason)) {
+      if (mglevels->eventresidual) {ierr = PetscLogEventBegin(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+      ierr = PCMGResidualRestrict_Private(mglevels->A,mglevels->restrct,mglevels->b,mglevels->x,mgc->b,&fused);CHKERRQ(ierr);
+      if (mglevels->eventresidual) {ierr = PetscLogEventEnd(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    }
+    if (!fused) {
+      if (mglevels->eventresidual) {ierr = PetscLogEventBegin(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+      ierr = (*mglevels->residual)(mglevels->A,mglevels->b,mglevels->x,mglevels->r);CHKERRQ(ierr);
+      if (mglevels->eventresidual) {ierr = PetscLogEventEnd(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    }
 
     /* if on finest level and have convergence criteria set */
     if (mglevels->level == mglevels->levels-1 && mg->ttol && reason) {
@@ -39,10 +49,11 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
       }
     }
 
-    mgc = *(mglevelsin - 1);
-    if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
-    if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (!fused) {
+      if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+      ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
+      if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    }
     ierr = VecSet(mgc->x,0.0);CHKERRQ(ierr);
     while (cycles--) {
       ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
@@ -444,6 +455,11 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
       ierr = PCMGMultiplicativeSetCycles(pc,cycles);CHKERRQ(ierr);
     }
   }
+  ierr = PetscOptionsInt("-pc_mg_esteig_refresh","Power iterations to refresh Chebyshev smoother eigenvalue estimates when only the matrix values change","PCMGSetEstEigRefresh",mg->esteig_refresh,&cycles,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PCMGSetEstEigRefresh(pc,cycles);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsBool("-pc_mg_fused","Use fused level kernels for the residual, restriction and Chebyshev-Jacobi smoothing","PCMGSetFused",mg->fused,&mg->fused,NULL);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_log","Log times for each multigrid level","None",flg,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -783,6 +799,18 @@ PetscErrorCode PCSetUp_MG(PC pc)
   }
 
   if (!pc->setupcalled) {
+    if (mg->esteig_refresh >= 0) { /* before the options so that the options of a level take precedence */
+      for (i=1; i<n; i++) {
+        ierr = KSPChebyshevEstEigSetRefresh(mglevels[i]->smoothd,mg->esteig_refresh);CHKERRQ(ierr);
+        ierr = KSPChebyshevEstEigSetRefresh(mglevels[i]->smoothu,mg->esteig_refresh);CHKERRQ(ierr);
+      }
+    }
+    if (mg->fused) {
+      for (i=1; i<n; i++) {
+        ierr = KSPChebyshevSetFused(mglevels[i]->smoothd,PETSC_TRUE);CHKERRQ(ierr);
+        ierr = KSPChebyshevSetFused(mglevels[i]->smoothu,PETSC_TRUE);CHKERRQ(ierr);
+      }
+    }
     for (i=0; i<n; i++) {
       ierr = KSPSetFromOptions(mglevels[i]->smoothd);CHKERRQ(ierr);
     }
@@ -1220,6 +1248,77 @@ PetscErrorCode  PCMGSetDistinctSmoothUp(PC pc)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMGSetEstEigRefresh - Have the Chebyshev smoothers on all levels keep their eigenvalue estimates across setups and
+   refresh them with a few warm-started power iterations when only the matrix values change
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  its - the number of power iterations, 0 to estimate the eigenvalues from scratch at each setup
+
+   Options Database Key:
+.  -pc_mg_esteig_refresh <its>
+
+   Level: advanced
+
+   Notes:
+   This calls KSPChebyshevEstEigSetRefresh() on the smoothers of all levels but the coarsest when the multigrid
+   hierarchy is set up; it has no effect on smoothers that are not KSPCHEBYSHEV. Options given for a level, for
+   instance -mg_levels_1_ksp_chebyshev_esteig_refresh, take precedence.
+
+.seealso: KSPChebyshevEstEigSetRefresh(), PCMGSetNumberSmooth()
+@*/
+PetscErrorCode  PCMGSetEstEigRefresh(PC pc,PetscInt its)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,its,2);
+  if (its < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of power iterations %D cannot be negative",its);
+  mg->esteig_refresh = its;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCMGSetFused - Use fused kernels on the multigrid levels, which make fewer passes over the matrices and vectors
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  fused - PETSC_TRUE to use the fused kernels
+
+   Options Database Key:
+.  -pc_mg_fused <true,false>
+
+   Level: advanced
+
+   Notes:
+   The residual after pre-smoothing and its restriction to the next coarser level are then computed together in one
+   pass over the rows of the operator and the interpolation, without storing the residual. This requires MATSEQAIJ or
+   MATMPIAIJ operators with the interpolation given (rather than a separate restriction) and the default residual
+   routine; other levels, and the finest level when PCMG tests convergence with KSPRICHARDSON, compute the residual
+   and restrict it as usual. The interpolation of the correction is already a single MatMultAdd().
+
+   This also calls KSPChebyshevSetFused() on the smoothers of all levels but the coarsest when the multigrid hierarchy
+   is set up, so that Chebyshev-Jacobi smoothers do each iteration in a single sweep. Both apply to PCGAMG as well.
+
+.seealso: KSPChebyshevSetFused(), PCMGSetResidual(), PCMGSetInterpolation()
+@*/
+PetscErrorCode  PCMGSetFused(PC pc,PetscBool fused)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,fused,2);
+  mg->fused = fused;
+  PetscFunctionReturn(0);
+}
+
 /* No new matrices are created, and the coarse operator matrices are the references to the original ones */
 PetscErrorCode  PCGetInterpolations_MG(PC pc,PetscInt *num_levels,Mat *interpolations[])
 {
@@ -1276,6 +1375,8 @@ PetscErrorCode  PCGetCoarseOperators_MG(PC pc,PetscInt *num_levels,Mat *coarseOp
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles - number of cycles to use as the preconditioner (defaults to 1)
+.  -pc_mg_esteig_refresh <its> - refresh the Chebyshev smoother eigenvalue estimates with power iterations when only the matrix values change, see PCMGSetEstEigRefresh()
+.  -pc_mg_fused - use fused level kernels for the residual, restriction and Chebyshev-Jacobi smoothing, see PCMGSetFused()
 .  -pc_mg_dump_matlab - dumps the matrices for each level and the restriction/interpolation matrices
                         to the Socket viewer for reading from MATLAB.
 -  -pc_mg_dump_binary - dumps the matrices for each level and the restriction/interpolation matrices
@@ -1312,6 +1413,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
   mg->am       = PC_MG_MULTIPLICATIVE;
   mg->galerkin = PC_MG_GALERKIN_NONE;
 
+  mg->esteig_refresh = -1;
+
   pc->useAmat = PETSC_TRUE;
 
   pc->ops->apply          = PCApply_MG;
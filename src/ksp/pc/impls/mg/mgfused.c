@@ -0,0 +1,107 @@
+
+/*
+    Fused residual and restriction for PCMG levels with AIJ operators
+*/
+#include <petsc/private/pcmgimpl.h>
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+/*
+   Adds P^T (b - A x) for the rows of the diagonal blocks Ad, Pd and, if present, the off-diagonal blocks Ao, Po, to
+   yd and yo. xo are the ghost values of x needed by Ao.
+*/
+static PetscErrorCode PCMGResidualRestrict_SeqAIJ(Mat Ad,Mat Ao,Mat Pd,Mat Po,const PetscScalar *b,const PetscScalar *x,const PetscScalar *xo,PetscScalar *yd,PetscScalar *yo)
+{
+  Mat_SeqAIJ      *ad = (Mat_SeqAIJ*)Ad->data,*ao = Ao ? (Mat_SeqAIJ*)Ao->data : NULL;
+  Mat_SeqAIJ      *pd = (Mat_SeqAIJ*)Pd->data,*po = Po ? (Mat_SeqAIJ*)Po->data : NULL;
+  PetscInt        m = Ad->rmap->n,i,j,n;
+  const PetscInt  *aj;
+  const MatScalar *aa;
+  PetscScalar     r;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    r  = b[i];
+    n  = ad->i[i+1] - ad->i[i];
+    aj = ad->j + ad->i[i];
+    aa = ad->a + ad->i[i];
+    PetscSparseDenseMinusDot(r,x,aa,aj,n);
+    if (ao) {
+      n  = ao->i[i+1] - ao->i[i];
+      aj = ao->j + ao->i[i];
+      aa = ao->a + ao->i[i];
+      PetscSparseDenseMinusDot(r,xo,aa,aj,n);
+    }
+    n  = pd->i[i+1] - pd->i[i];
+    aj = pd->j + pd->i[i];
+    aa = pd->a + pd->i[i];
+    for (j=0; j<n; j++) yd[aj[j]] += r*aa[j];
+    if (po) {
+      n  = po->i[i+1] - po->i[i];
+      aj = po->j + po->i[i];
+      aa = po->a + po->i[i];
+      for (j=0; j<n; j++) yo[aj[j]] += r*aa[j];
+    }
+  }
+  ierr = PetscLogFlops(2.0*(ad->nz + (ao ? ao->nz : 0) + pd->nz + (po ? po->nz : 0)));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCMGResidualRestrict_Private - Computes the restricted residual y = P^T (b - A x) in a single pass over the rows of
+   A and the interpolation P, without storing the residual.
+
+   Sets done to PETSC_FALSE, without computing anything, unless A and P are both MATSEQAIJ or both MATMPIAIJ and P is
+   given as the interpolation, with the rows of A.
+*/
+PetscErrorCode PCMGResidualRestrict_Private(Mat A,Mat P,Vec b,Vec x,Vec y,PetscBool *done)
+{
+  PetscErrorCode    ierr;
+  PetscBool         aseq,ampi,pseq,pmpi;
+  const PetscScalar *ba,*xa,*xo;
+  PetscScalar       *ya,*yo;
+  Mat_MPIAIJ        *a,*p;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  if (P->rmap->N != A->rmap->N || P->rmap->n != A->rmap->n) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&aseq);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATMPIAIJ,&ampi);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)P,MATSEQAIJ,&pseq);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)P,MATMPIAIJ,&pmpi);CHKERRQ(ierr);
+  if (!(aseq && pseq) && !(ampi && pmpi)) PetscFunctionReturn(0);
+
+  ierr = VecSet(y,0.0);CHKERRQ(ierr);
+  if (ampi) {
+    a    = (Mat_MPIAIJ*)A->data;
+    p    = (Mat_MPIAIJ*)P->data;
+    ierr = VecScatterBegin(a->Mvctx,x,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(a->Mvctx,x,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecSet(p->lvec,0.0);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(b,&ba);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(a->lvec,&xo);CHKERRQ(ierr);
+    ierr = VecGetArray(y,&ya);CHKERRQ(ierr);
+    ierr = VecGetArray(p->lvec,&yo);CHKERRQ(ierr);
+    ierr = PCMGResidualRestrict_SeqAIJ(a->A,a->B,p->A,p->B,ba,xa,xo,ya,yo);CHKERRQ(ierr);
+    ierr = VecRestoreArray(p->lvec,&yo);CHKERRQ(ierr);
+    ierr = VecRestoreArray(y,&ya);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(a->lvec,&xo);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(b,&ba);CHKERRQ(ierr);
+    /* add the contributions to the coarse rows owned by other processes */
+    ierr = VecScatterBegin(p->Mvctx,p->lvec,y,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+    ierr = VecScatterEnd(p->Mvctx,p->lvec,y,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayRead(b,&ba);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(y,&ya);CHKERRQ(ierr);
+    ierr = PCMGResidualRestrict_SeqAIJ(A,NULL,P,NULL,ba,xa,NULL,ya,NULL);CHKERRQ(ierr);
+    ierr = VecRestoreArray(y,&ya);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(b,&ba);CHKERRQ(ierr);
+  }
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
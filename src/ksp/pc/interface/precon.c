@@ -991,6 +991,71 @@ PetscErrorCode  PCSetUpOnBlocks(PC pc)
   PetscFunctionReturn(0);
 }
 
+/*
+   PCSetUpBlocks_Private - Calls KSPSetUp() on the n block solvers ksp[] of a block preconditioner such as PCBJACOBI
+   or PCASM, so the blocks are factored, and marks pc as failed if one of them fails.
+
+   The blocks are always set up one after another: the setup creates PETSc objects, whose ids and logging are not
+   thread safe, so only the solves in PCApplyBlocks_Private() are threaded.
+*/
+PetscErrorCode PCSetUpBlocks_Private(PC pc,PetscInt n,KSP ksp[])
+{
+  PetscErrorCode     ierr;
+  PetscInt           i;
+  KSPConvergedReason reason;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {ierr = KSPSetUp(ksp[i]);CHKERRQ(ierr);}
+  for (i=0; i<n; i++) {
+    ierr = KSPGetConvergedReason(ksp[i],&reason);CHKERRQ(ierr);
+    if (reason == KSP_DIVERGED_PC_FAILED) pc->failedreason = PC_SUBPC_ERROR;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCApplyBlocks_Private - Solves (or, with transpose, transpose solves) with the n block solvers ksp[] of a block
+   preconditioner, y[i] = ksp[i]^{-1} x[i]. Each block has its own x[i] and y[i], so the solves are independent.
+
+   With nthreads > 1 the blocks are distributed dynamically over that many OpenMP threads and the failures of the block
+   solves are checked after all of them are done. This requires PETSc to be configured with OpenMP and
+   --with-threadsafety, otherwise the blocks are always solved one after another. The blocks must have been set up with
+   PCSetUpBlocks_Private(), so the solves create no PETSc objects.
+*/
+PetscErrorCode PCApplyBlocks_Private(PC pc,PetscInt nthreads,PetscInt n,KSP ksp[],Vec x[],Vec y[],PetscBool transpose)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscLogEvent  event = transpose ? PC_ApplyTransposeOnBlocks : PC_ApplyOnBlocks;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  if (nthreads > 1 && n > 1) {
+    PetscInt nfail = 0;
+
+    nthreads = PetscMin(nthreads,n);
+#pragma omp parallel for num_threads((int)nthreads) schedule(dynamic,1) reduction(+:nfail)
+    for (i=0; i<n; i++) {
+      if (transpose ? KSPSolveTranspose(ksp[i],x[i],y[i]) : KSPSolve(ksp[i],x[i],y[i])) nfail++;
+    }
+    if (nfail) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"%D of the block solves failed",nfail);
+    for (i=0; i<n; i++) {ierr = KSPCheckSolve(ksp[i],pc,y[i]);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+#endif
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(event,ksp[i],x[i],y[i],0);CHKERRQ(ierr);
+    if (transpose) {
+      ierr = KSPSolveTranspose(ksp[i],x[i],y[i]);CHKERRQ(ierr);
+    } else {
+      ierr = KSPSolve(ksp[i],x[i],y[i]);CHKERRQ(ierr);
+    }
+    ierr = KSPCheckSolve(ksp[i],pc,y[i]);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(event,ksp[i],x[i],y[i],0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PCSetModifySubMatrices - Sets a user-defined routine for modifying the
    submatrices that arise within certain subdomain-based preconditioners.
@@ -0,0 +1,324 @@
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+/*
+   Vertex states: selected and deleted vertices are the extreme values so that they
+   dominate, or are ignored by, the min reductions; undecided vertices carry a random
+   key in the high bits with the (unique) global index in the low bits.
+*/
+#define MIS2_IN       ((PetscInt64)-1)
+#define MIS2_OUT      ((PetscInt64)0x7fffffffffffffffLL)
+#define MIS2_GID_BITS 47
+
+PETSC_STATIC_INLINE PetscInt64 MIS2Key(PetscInt gid,PetscInt round)
+{
+  unsigned long long h = (unsigned long long)gid + 0x9e3779b97f4a7c15ULL*(unsigned long long)(round+1);
+
+  h = (h ^ (h >> 30))*0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27))*0x94d049bb133111ebULL;
+  h = h ^ (h >> 31);
+  return (PetscInt64)(((h & 0x7fff) << MIS2_GID_BITS) | (unsigned long long)gid);
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+   maxIndSetAgg2 - parallel distance-2 maximal independent set (MIS-2) and aggregation. MatAIJ specific!!!
+
+   The MIS-2 is computed directly on the (symmetric) graph of distance 1: each round
+   takes two min reductions of the vertex keys over the closed neighborhood, with a ghost
+   update after each, so the square of the graph is never formed. The vertices of the
+   MIS-2 are the roots of the aggregates; a vertex joins its (unique) adjacent root, then
+   the remaining vertices join the aggregate of a neighbor. A vertex only joins an
+   aggregate owned by another process if it is a ghost of a local vertex of that
+   aggregate on that process, so aggregates only contain local and ghost vertices of
+   the process that owns the root, which is what the prolongator construction needs.
+
+   Input Parameter:
+   . Gmat - global matrix of graph, structurally symmetric (data not defined)
+
+   Output Parameter:
+   . a_locals_llist - array of list of global indices rooted at selected nodes (strict aggregates)
+*/
+static PetscErrorCode maxIndSetAgg2(Mat Gmat,PetscCoarsenData **a_locals_llist)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *matA,*matB=NULL;
+  Mat_MPIAIJ       *mpimat=NULL;
+  MPI_Comm         comm;
+  PetscMPIInt      rank,rowner,uowner;
+  PetscInt         num_fine_ghosts=0,n,ix,j,*idx,*ii,iter,my0,Iend,lid,cpid,gid,r,nremoved=0,nselected=0,nleft=0,t1,t2;
+  PetscInt         *lid_cprowID,*lid_root,*cpcol_root=NULL;
+  const PetscInt   *garray=NULL;
+  PetscInt64       *lid_state,*lid_min,*cpcol_state=NULL,*cpcol_min=NULL,s,t;
+  PetscBool        *lid_removed;
+  PetscBool        isMPI,isAIJ;
+  const PetscInt   nloc = Gmat->rmap->n;
+  PetscCoarsenData *agg_lists;
+  PetscLayout      layout;
+  PetscSF          sf=NULL;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  if (Gmat->rmap->N >= ((PetscInt64)1 << MIS2_GID_BITS)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"MIS-2 coarsening supports graphs with fewer than 2^%d vertices",MIS2_GID_BITS);
+
+  /* get submatrices */
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    /* force compressed storage of B */
+    ierr   = MatCheckCompressedRow(mpimat->B,matB->nonzerorowcnt,&matB->compressedrow,matB->i,Gmat->rmap->n,-1.0);CHKERRQ(ierr);
+  } else {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Require AIJ matrix.");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+  if (mpimat) {
+    garray = mpimat->garray;
+    ierr   = VecGetLocalSize(mpimat->lvec,&num_fine_ghosts);CHKERRQ(ierr);
+    ierr   = PetscMalloc3(num_fine_ghosts,&cpcol_state,num_fine_ghosts,&cpcol_min,num_fine_ghosts,&cpcol_root);CHKERRQ(ierr);
+    ierr   = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr   = PetscSFSetGraphLayout(sf,layout,num_fine_ghosts,NULL,PETSC_COPY_VALUES,mpimat->garray);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc5(nloc,&lid_cprowID,nloc,&lid_root,nloc,&lid_state,nloc,&lid_min,nloc,&lid_removed);CHKERRQ(ierr);
+
+  /* set index into compressed row 'lid_cprowID' */
+  for (lid=0; lid<nloc; lid++) lid_cprowID[lid] = -1;
+  if (matB) {
+    for (ix=0; ix<matB->compressedrow.nrows; ix++) {
+      lid = matB->compressedrow.rindex[ix];
+      lid_cprowID[lid] = ix;
+    }
+  }
+  /* remove singletons: one local adj (me) and no ghost */
+  for (lid=0; lid<nloc; lid++) {
+    n  = matA->i[lid+1] - matA->i[lid];
+    ix = lid_cprowID[lid];
+    lid_removed[lid] = (PetscBool)(n < 2 && (ix == -1 || !(matB->compressedrow.i[ix+1]-matB->compressedrow.i[ix])));
+    if (lid_removed[lid]) {
+      lid_state[lid] = MIS2_OUT;
+      nremoved++;
+    } else lid_state[lid] = MIS2Key(lid+my0,0);
+  }
+
+  /* MIS-2 */
+  for (iter=0; ; iter++) {
+    /* min of the states over the closed neighborhood */
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT64,lid_state,cpcol_state);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT64,lid_state,cpcol_state);CHKERRQ(ierr);
+    }
+    for (lid=0; lid<nloc; lid++) {
+      t   = lid_state[lid];
+      n   = matA->i[lid+1] - matA->i[lid];
+      idx = matA->j + matA->i[lid];
+      for (j=0; j<n; j++) t = PetscMin(t,lid_state[idx[j]]);
+      if ((ix=lid_cprowID[lid]) != -1) {
+        ii  = matB->compressedrow.i; n = ii[ix+1] - ii[ix];
+        idx = matB->j + ii[ix];
+        for (j=0; j<n; j++) t = PetscMin(t,cpcol_state[idx[j]]);
+      }
+      lid_min[lid] = t;
+    }
+    /* min of those over the closed neighborhood: the min over the distance 2 neighborhood */
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT64,lid_min,cpcol_min);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT64,lid_min,cpcol_min);CHKERRQ(ierr);
+    }
+    t1 = 0;
+    for (lid=0; lid<nloc; lid++) {
+      s = lid_state[lid];
+      if (s == MIS2_IN || s == MIS2_OUT) continue;
+      t   = lid_min[lid];
+      n   = matA->i[lid+1] - matA->i[lid];
+      idx = matA->j + matA->i[lid];
+      for (j=0; j<n; j++) t = PetscMin(t,lid_min[idx[j]]);
+      if ((ix=lid_cprowID[lid]) != -1) {
+        ii  = matB->compressedrow.i; n = ii[ix+1] - ii[ix];
+        idx = matB->j + ii[ix];
+        for (j=0; j<n; j++) t = PetscMin(t,cpcol_min[idx[j]]);
+      }
+      if (t == MIS2_IN) lid_state[lid] = MIS2_OUT; /* a selected vertex is within distance 2 */
+      else if (t == s) {                           /* smallest key within distance 2 */
+        lid_state[lid] = MIS2_IN;
+        nselected++;
+      } else {
+        lid_state[lid] = MIS2Key(lid+my0,iter+1); /* fresh keys for the next round */
+        t1++;
+      }
+    }
+    /* all done? */
+    ierr = MPIU_Allreduce(&t1,&t2,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    if (!t2) break;
+  }
+
+  /* roots of the aggregates */
+  for (lid=0; lid<nloc; lid++) lid_root[lid] = (lid_state[lid] == MIS2_IN) ? lid+my0 : -1;
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+  }
+  /* join the adjacent root, there is at most one */
+  for (lid=0; lid<nloc; lid++) {
+    if (lid_removed[lid] || lid_root[lid] != -1) continue;
+    n   = matA->i[lid+1] - matA->i[lid];
+    idx = matA->j + matA->i[lid];
+    for (j=0; j<n; j++) {
+      if (lid_root[idx[j]] == idx[j]+my0) {
+        lid_root[lid] = idx[j]+my0;
+        break;
+      }
+    }
+    if (lid_root[lid] == -1 && (ix=lid_cprowID[lid]) != -1) {
+      ii  = matB->compressedrow.i; n = ii[ix+1] - ii[ix];
+      idx = matB->j + ii[ix];
+      for (j=0; j<n; j++) {
+        cpid = idx[j];
+        if (cpcol_root[cpid] == garray[cpid]) {
+          lid_root[lid] = garray[cpid];
+          break;
+        }
+      }
+    }
+  }
+  /* join the aggregate of a neighbor, using the assignments above only; 'lid_min' is free for the new ones */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+  }
+  for (lid=0; lid<nloc; lid++) {
+    lid_min[lid] = -1;
+    if (lid_removed[lid] || lid_root[lid] != -1) continue;
+    n   = matA->i[lid+1] - matA->i[lid];
+    idx = matA->j + matA->i[lid];
+    for (j=0; j<n; j++) { /* local neighbors: only if the root is local too */
+      r = lid_root[idx[j]];
+      if (r >= my0 && r < Iend) {
+        lid_min[lid] = r;
+        break;
+      }
+    }
+    if (lid_min[lid] == -1 && (ix=lid_cprowID[lid]) != -1) {
+      ii  = matB->compressedrow.i; n = ii[ix+1] - ii[ix];
+      idx = matB->j + ii[ix];
+      for (j=0; j<n; j++) { /* ghost neighbors: if the root is local or owned with the neighbor */
+        cpid = idx[j];
+        r    = cpcol_root[cpid];
+        if (r == -1) continue;
+        if (r < my0 || r >= Iend) {
+          ierr = PetscLayoutFindOwner(layout,r,&rowner);CHKERRQ(ierr);
+          ierr = PetscLayoutFindOwner(layout,garray[cpid],&uowner);CHKERRQ(ierr);
+          if (rowner != uowner) continue;
+        }
+        lid_min[lid] = r;
+        break;
+      }
+    }
+  }
+  for (lid=0; lid<nloc; lid++) {
+    if (lid_removed[lid] || lid_root[lid] != -1) continue;
+    if (lid_min[lid] != -1) lid_root[lid] = (PetscInt)lid_min[lid];
+    else { /* no aggregate can take it, start a new one */
+      lid_root[lid] = lid+my0;
+      nleft++;
+    }
+  }
+  ierr = PetscInfo5(Gmat,"\t removed %D of %D vertices.  %D selected in %D rounds, %D new roots for leftover vertices.\n",nremoved,nloc,nselected,iter+1,nleft);CHKERRQ(ierr);
+
+  /* strict aggregates of global indices, root first */
+  ierr = PetscCDCreate(nloc,&agg_lists);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    if (lid_root[lid] == lid+my0) {
+      ierr = PetscCDAppendID(agg_lists,lid,lid+my0);CHKERRQ(ierr);
+    }
+  }
+  for (lid=0; lid<nloc; lid++) {
+    r = lid_root[lid];
+    if (r != -1 && r != lid+my0 && r >= my0 && r < Iend) {
+      ierr = PetscCDAppendID(agg_lists,r-my0,lid+my0);CHKERRQ(ierr);
+    }
+  }
+  /* fill in the ghost members of my aggregates */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_root,cpcol_root);CHKERRQ(ierr);
+    for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+      r   = cpcol_root[cpid];
+      gid = garray[cpid];
+      if (r != gid && r >= my0 && r < Iend) {
+        ierr = PetscCDAppendID(agg_lists,r-my0,gid);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = PetscFree3(cpcol_state,cpcol_min,cpcol_root);CHKERRQ(ierr);
+  }
+  ierr = PetscFree5(lid_cprowID,lid_root,lid_state,lid_min,lid_removed);CHKERRQ(ierr);
+  *a_locals_llist = agg_lists;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenApply_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+  Mat            mat = coarse->graph;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"MIS-2 coarsening only supports strict aggregates");
+  ierr = maxIndSetAgg2(mat,&coarse->agg_lists);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenView_MIS2(MatCoarsen coarse,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)coarse),&rank);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] MIS-2 aggregator\n",rank);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMIS2 - Creates a coarsen context that aggregates around a distance-2 maximal independent set
+
+   Collective
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Notes:
+   This gives the aggressive coarsening of MATCOARSENMIS on the square of the graph without forming the
+   square: the independent set is computed with two rounds of neighbor communication per iteration on
+   the graph itself. The graph must be structurally symmetric and only strict aggregates are supported.
+   The selection is randomized with a hash of the global indices, so any greedy ordering is ignored and
+   the result does not depend on the ordering of the local vertices.
+
+   Level: beginner
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS, PCGAMGSetAggressiveType()
+
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen coarse)
+{
+  PetscFunctionBegin;
+  coarse->ops->apply = MatCoarsenApply_MIS2;
+  coarse->ops->view  = MatCoarsenView_MIS2;
+  PetscFunctionReturn(0);
+}
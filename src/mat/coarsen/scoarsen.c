@@ -4,6 +4,7 @@
 
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_HEM(MatCoarsen);
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen);
 
 /*@C
   MatCoarsenRegisterAll - Registers all of the matrix Coarsen routines in PETSc.
@@ -35,6 +36,7 @@ PetscErrorCode  MatCoarsenRegisterAll(void)
 
   ierr = MatCoarsenRegister(MATCOARSENMIS,MatCoarsenCreate_MIS);CHKERRQ(ierr);
   ierr = MatCoarsenRegister(MATCOARSENHEM,MatCoarsenCreate_HEM);CHKERRQ(ierr);
+  ierr = MatCoarsenRegister(MATCOARSENMIS2,MatCoarsenCreate_MIS2);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
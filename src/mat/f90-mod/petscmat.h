@@ -66,7 +66,9 @@
       PetscEnum, parameter :: MAT_SUBSET_OFF_PROC_ENTRIES = 20
       PetscEnum, parameter :: MAT_SUBMAT_SINGLEIS = 21
       PetscEnum, parameter :: MAT_STRUCTURE_ONLY = 22
-      PetscEnum, parameter :: MAT_OPTION_MAX = 23
+      PetscEnum, parameter :: MAT_SORTED_FULL = 23
+      PetscEnum, parameter :: MAT_LOCALITY_REORDER = 24
+      PetscEnum, parameter :: MAT_OPTION_MAX = 25
 !
 !  MatFactorShiftType
 !
@@ -140,6 +142,7 @@
       PetscEnum, parameter :: MAT_FACTORINFO_ZERO_PIVOT = 9
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_TYPE = 10
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_AMOUNT = 11
+      PetscEnum, parameter :: MAT_FACTORINFO_SOLVE_THREADS = 12
 !
 !  Options for SOR and SSOR
 !  MatSorType may be bitwise ORd together, so do not change the numbers
@@ -388,6 +391,8 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBSET_OFF_PROC_ENTRIES
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBMAT_SINGLEIS
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_STRUCTURE_ONLY
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_SORTED_FULL
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_LOCALITY_REORDER
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_OPTION_MAX
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SHIFT_NONE
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SHIFT_NONZERO
@@ -434,6 +439,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_ZERO_PIVOT
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SHIFT_TYPE
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SHIFT_AMOUNT
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_FACTORINFO_SOLVE_THREADS
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_FORWARD_SWEEP
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_BACKWARD_SWEEP
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_SYMMETRIC_SWEEP
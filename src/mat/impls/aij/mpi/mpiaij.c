@@ -19,7 +19,7 @@
 . -mat_type aij - sets the matrix type to "aij" during a call to MatSetFromOptions()
 
   Developer Notes:
-    Subclasses include MATAIJCUSP, MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
+    Subclasses include MATAIJCUSP, MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJSINGLE, MATAIJDELTA, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
    enough exist.
 
   Level: beginner
@@ -850,6 +850,7 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
     ierr = MatBindToCPU(aij->B,PETSC_TRUE);CHKERRQ(ierr);
   }
 #endif
+  ierr = MatSeqAIJSetOpenMPThreads_Private(aij->A,aij->omp_nthreads);CHKERRQ(ierr);
   ierr = MatAssemblyBegin(aij->A,mode);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(aij->A,mode);CHKERRQ(ierr);
 
@@ -872,6 +873,8 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
     ierr = MatSetUpMultiply_MPIAIJ(mat);CHKERRQ(ierr);
   }
   ierr = MatSetOption(aij->B,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);
+  /* the off-diagonal block may have been replaced in the disassembly */
+  ierr = MatSeqAIJSetOpenMPThreads_Private(aij->B,aij->omp_nthreads);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (mat->offloadmask == PETSC_OFFLOAD_CPU && aij->B->offloadmask != PETSC_OFFLOAD_UNALLOCATED) aij->B->offloadmask = PETSC_OFFLOAD_CPU;
 #endif
@@ -1110,6 +1113,10 @@ PetscErrorCode MatMult_MPIAIJ(Mat A,Vec xx,Vec yy)
   PetscFunctionBegin;
   ierr = VecGetLocalSize(xx,&nt);CHKERRQ(ierr);
   if (nt != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Incompatible partition of A (%D) and xx (%D)",A->cmap->n,nt);
+  if (a->nbr_use) {
+    ierr = MatMultAdd_MPIAIJ_Neighbor(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecScatterBegin(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
   ierr = (*a->A->ops->mult)(a->A,xx,yy);CHKERRQ(ierr);
   ierr = VecScatterEnd(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
@@ -1134,6 +1141,10 @@ PetscErrorCode MatMultAdd_MPIAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   VecScatter     Mvctx = a->Mvctx;
 
   PetscFunctionBegin;
+  if (a->nbr_use) {
+    ierr = MatMultAdd_MPIAIJ_Neighbor(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (a->Mvctx_mpi1_flg) Mvctx = a->Mvctx_mpi1;
   ierr = VecScatterBegin(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
   ierr = (*a->A->ops->multadd)(a->A,xx,yy,zz);CHKERRQ(ierr);
@@ -1252,6 +1263,22 @@ PetscErrorCode MatScale_MPIAIJ(Mat A,PetscScalar aa)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&aij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree(aij->coo_sendperm);CHKERRQ(ierr);
+  ierr = PetscFree2(aij->coo_sendbuf,aij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree4(aij->Ajmap1,aij->Aperm1,aij->Bjmap1,aij->Bperm1);CHKERRQ(ierr);
+  ierr = PetscFree4(aij->Ajmap2,aij->Aperm2,aij->Bjmap2,aij->Bperm2);CHKERRQ(ierr);
+  aij->coo_nsend = 0;
+  aij->coo_nrecv = 0;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -1276,6 +1303,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  ierr = MatMPIAIJResetNeighbor_Private(mat);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
 
   /* may be created by MatCreateMPIAIJSumSeqAIJSymbolic */
@@ -1288,6 +1317,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpibaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
@@ -1432,6 +1463,7 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPrintf(viewer,"Information on VecScatter used in matrix-vector product: \n");CHKERRQ(ierr);
       ierr = VecScatterView(aij->Mvctx,viewer);CHKERRQ(ierr);
+      ierr = MatView_MPIAIJ_Neighbor(mat,viewer);CHKERRQ(ierr);
       PetscFunctionReturn(0);
     } else if (format == PETSC_VIEWER_ASCII_INFO) {
       PetscInt inodecount,inodelimit,*inodes;
@@ -1441,6 +1473,7 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"not using I-node (on process 0) routines\n");CHKERRQ(ierr);
       }
+      ierr = MatView_MPIAIJ_Neighbor(mat,viewer);CHKERRQ(ierr);
       PetscFunctionReturn(0);
     } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO) {
       PetscFunctionReturn(0);
@@ -1807,6 +1840,12 @@ PetscErrorCode MatSetOption_MPIAIJ(Mat A,MatOption op,PetscBool flg)
     ierr = MatSetOption(a->A,op,flg);CHKERRQ(ierr);
     ierr = MatSetOption(a->B,op,flg);CHKERRQ(ierr);
     break;
+  case MAT_LOCALITY_REORDER:
+    /* only the diagonal block, the columns of the off-diagonal block follow the ghost ordering of the scatter */
+    MatCheckPreallocated(A,1);
+    a->localityreorder = flg;
+    ierr = MatSetOption(a->A,op,flg);CHKERRQ(ierr);
+    break;
   case MAT_ROW_ORIENTED:
     MatCheckPreallocated(A,1);
     a->roworiented = flg;
@@ -2528,8 +2567,10 @@ PetscErrorCode MatMPIAIJSetUseScalableIncreaseOverlap(Mat A,PetscBool sc)
 
 PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
 {
+  Mat_MPIAIJ           *a = (Mat_MPIAIJ*)A->data;
   PetscErrorCode       ierr;
-  PetscBool            sc = PETSC_FALSE,flg;
+  PetscBool            sc = PETSC_FALSE,flg,set;
+  PetscInt             nthreads;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"MPIAIJ options");CHKERRQ(ierr);
@@ -2538,6 +2579,21 @@ PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat
   if (flg) {
     ierr = MatMPIAIJSetUseScalableIncreaseOverlap(A,sc);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-mat_mpiaij_neighbor_overlap","Multiply the off-diagonal part neighbor by neighbor as the messages arrive","MatMult",a->nbr_use,&a->nbr_use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_locality_reorder","Multiply with a copy of the diagonal block in reverse Cuthill-McKee order","MatSetOption",a->localityreorder,&flg,&set);CHKERRQ(ierr);
+  if (set) {
+    a->localityreorder = flg;
+    if (A->preallocated) {ierr = MatSetOption(a->A,MAT_LOCALITY_REORDER,flg);CHKERRQ(ierr);}
+  }
+  ierr = PetscOptionsInt("-mat_omp_num_threads","Number of OpenMP threads for the products with the local blocks","None",PetscMax(a->omp_nthreads,1),&nthreads,&set);CHKERRQ(ierr);
+  if (set) {
+    a->omp_nthreads = nthreads;
+    if (A->preallocated) {
+      ierr = MatSeqAIJSetOpenMPThreads_Private(a->A,nthreads);CHKERRQ(ierr);
+      ierr = MatSeqAIJSetOpenMPThreads_Private(a->B,nthreads);CHKERRQ(ierr);
+    }
+  }
+  if (a->size == 1) a->nbr_use = PETSC_FALSE;
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2781,6 +2837,7 @@ PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJ(Mat B,PetscInt d_nz,const Petsc
   ierr = PetscFree(b->garray);CHKERRQ(ierr);
   ierr = VecDestroy(&b->lvec);CHKERRQ(ierr);
   ierr = VecScatterDestroy(&b->Mvctx);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(B);CHKERRQ(ierr);
 
   /* Because the B will have been resized we simply destroy it and create a new one each time */
   ierr = MPI_Comm_size(PetscObjectComm((PetscObject)B),&size);CHKERRQ(ierr);
@@ -2797,6 +2854,7 @@ PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJ(Mat B,PetscInt d_nz,const Petsc
     ierr = MatSetBlockSizesFromMats(b->A,B,B);CHKERRQ(ierr);
     ierr = MatSetType(b->A,MATSEQAIJ);CHKERRQ(ierr);
     ierr = PetscLogObjectParent((PetscObject)B,(PetscObject)b->A);CHKERRQ(ierr);
+    if (b->localityreorder) {ierr = MatSetOption(b->A,MAT_LOCALITY_REORDER,PETSC_TRUE);CHKERRQ(ierr);}
   }
 
   ierr = MatSeqAIJSetPreallocation(b->A,d_nz,d_nnz);CHKERRQ(ierr);
@@ -2807,6 +2865,42 @@ PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJ(Mat B,PetscInt d_nz,const Petsc
   PetscFunctionReturn(0);
 }
 
+/*
+   The subclasses of MATMPIAIJ that only change the class of the diagonal and off-diagonal blocks (MATMPIAIJSINGLE,
+   MATMPIAIJDELTA) convert the blocks with the SeqAIJ conversion seqconvert() whenever they are created
+*/
+PetscErrorCode MatMPIAIJConvertBlocks_Private(Mat B,MatType seqtype,PetscErrorCode (*seqconvert)(Mat,MatType,MatReuse,Mat*))
+{
+  Mat_MPIAIJ     *b = (Mat_MPIAIJ*)B->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* a matrix that is not preallocated yet has no blocks */
+  if (b->A) {
+    ierr = (*seqconvert)(b->A,seqtype,MAT_INPLACE_MATRIX,&b->A);CHKERRQ(ierr);
+    ierr = (*seqconvert)(b->B,seqtype,MAT_INPLACE_MATRIX,&b->B);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* preallocation is the MatMPIAIJSetPreallocation() of the subclass, which calls MatMPIAIJConvertBlocks_Private() */
+PetscErrorCode MatConvert_MPIAIJ_MPIAIJBlocks_Private(Mat A,MatType type,MatType seqtype,PetscErrorCode (*seqconvert)(Mat,MatType,MatReuse,Mat*),PetscErrorCode (*preallocation)(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[]),MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  /* an already preallocated matrix keeps its blocks, which then need converting as well */
+  ierr = MatMPIAIJConvertBlocks_Private(B,seqtype,seqconvert);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)B,type);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",preallocation);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatResetPreallocation_MPIAIJ(Mat B)
 {
   Mat_MPIAIJ     *b;
@@ -2826,6 +2920,7 @@ PetscErrorCode MatResetPreallocation_MPIAIJ(Mat B)
   ierr = PetscFree(b->garray);CHKERRQ(ierr);
   ierr = VecDestroy(&b->lvec);CHKERRQ(ierr);
   ierr = VecScatterDestroy(&b->Mvctx);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(B);CHKERRQ(ierr);
 
   ierr = MatResetPreallocation(b->A);CHKERRQ(ierr);
   ierr = MatResetPreallocation(b->B);CHKERRQ(ierr);
@@ -2854,13 +2949,16 @@ PetscErrorCode MatDuplicate_MPIAIJ(Mat matin,MatDuplicateOption cpvalues,Mat *ne
   mat->insertmode   = NOT_SET_VALUES;
   mat->preallocated = matin->preallocated;
 
-  a->size         = oldmat->size;
-  a->rank         = oldmat->rank;
-  a->donotstash   = oldmat->donotstash;
-  a->roworiented  = oldmat->roworiented;
-  a->rowindices   = NULL;
-  a->rowvalues    = NULL;
-  a->getrowactive = PETSC_FALSE;
+  a->size            = oldmat->size;
+  a->rank            = oldmat->rank;
+  a->donotstash      = oldmat->donotstash;
+  a->roworiented     = oldmat->roworiented;
+  a->nbr_use         = oldmat->nbr_use;
+  a->localityreorder = oldmat->localityreorder;
+  a->omp_nthreads    = oldmat->omp_nthreads;
+  a->rowindices      = NULL;
+  a->rowvalues       = NULL;
+  a->getrowactive    = PETSC_FALSE;
 
   ierr = PetscLayoutReference(matin->rmap,&mat->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutReference(matin->cmap,&mat->cmap);CHKERRQ(ierr);
@@ -3821,6 +3919,234 @@ PetscErrorCode MatMPIAIJSetPreallocationCSR_MPIAIJ(Mat B,const PetscInt Ii[],con
   PetscFunctionReturn(0);
 }
 
+/*
+   The entries are split into the locally owned ones and the ones to send to the owner of their row. The owners
+   learn their senders with PetscCommBuildTwoSided() and build a PetscSF whose roots are the send buffers, so that
+   MatSetValuesCOO_MPIAIJ() only packs the values and does a single PetscSFBcast. Both sets of entries are then merged
+   into the nonzero pattern, and for each nonzero of the diagonal (A) and off-diagonal (B) blocks we keep the list of
+   local entries (jmap1/perm1) and received entries (jmap2/perm2) to sum into it.
+*/
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  MPI_Comm       comm;
+  PetscSF        sf;
+  PetscSFNode    *iremote;
+  PetscMPIInt    owner,nto,nfrom,*toranks,*fromranks;
+  PetscInt       *todata,*fromdata,*sorder;
+  PetscInt       m,rstart,rend,cstart,cend,k,r,t,q,n1,nsend,nrecv,ntot;
+  PetscInt       *lperm,*sowner,*sendperm,*sendi,*sendj,*recvi,*recvj,*ci,*cj;
+  PetscInt       *Ii,*J,*jmap,*perm,*d_nnz,*o_nnz,nzA,nzB,nA1,nA2,nB1,nB2,row;
+  PetscInt       *Ajmap1,*Aperm1,*Bjmap1,*Bperm1,*Ajmap2,*Aperm2,*Bjmap2,*Bperm2;
+  PetscBool      ignorezeroentries,nooffprocentries;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr   = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  m      = mat->rmap->n;
+  rstart = mat->rmap->rstart;
+  rend   = mat->rmap->rend;
+  cstart = mat->cmap->rstart;
+  cend   = mat->cmap->rend;
+
+  /* split the entries into locally owned and off-process ones, the latter sorted by owner */
+  ierr = PetscMalloc3(n,&lperm,n,&sowner,n,&sendperm);CHKERRQ(ierr);
+  n1 = nsend = 0;
+  for (k=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= rstart && coo_i[k] < rend) lperm[n1++] = k;
+    else {
+      ierr = PetscLayoutFindOwner(mat->rmap,coo_i[k],&owner);CHKERRQ(ierr);
+      sowner[nsend]   = owner;
+      sendperm[nsend] = k;
+      nsend++;
+    }
+  }
+  ierr = PetscSortIntWithArray(nsend,sowner,sendperm);CHKERRQ(ierr);
+
+  /* tell each owner how many entries it gets from us and where they start in our send buffer */
+  for (nto=0,k=0; k<nsend; k++) if (!k || sowner[k] != sowner[k-1]) nto++;
+  ierr = PetscMalloc2(nto,&toranks,2*nto,&todata);CHKERRQ(ierr);
+  for (nto=0,k=0; k<nsend; k++) {
+    if (!k || sowner[k] != sowner[k-1]) {
+      toranks[nto]      = (PetscMPIInt)sowner[k];
+      todata[2*nto]     = 0;
+      todata[2*nto+1]   = k;
+      nto++;
+    }
+    todata[2*(nto-1)]++;
+  }
+  ierr = PetscCommBuildTwoSided(comm,2,MPIU_INT,nto,toranks,todata,&nfrom,&fromranks,&fromdata);CHKERRQ(ierr);
+  ierr = PetscFree2(toranks,todata);CHKERRQ(ierr);
+
+  /* order the received entries by sender rank so that the summation order does not depend on message arrival */
+  ierr = PetscMalloc1(nfrom,&sorder);CHKERRQ(ierr);
+  for (k=0; k<nfrom; k++) sorder[k] = k;
+  ierr = PetscSortMPIIntWithIntArray(nfrom,fromranks,sorder);CHKERRQ(ierr);
+  for (nrecv=0,k=0; k<nfrom; k++) nrecv += fromdata[2*k];
+  ierr = PetscMalloc1(nrecv,&iremote);CHKERRQ(ierr);
+  for (q=0,k=0; k<nfrom; k++) {
+    for (t=0; t<fromdata[2*sorder[k]]; t++,q++) {
+      iremote[q].rank  = fromranks[k];
+      iremote[q].index = fromdata[2*sorder[k]+1] + t;
+    }
+  }
+  ierr = PetscFree(sorder);CHKERRQ(ierr);
+  ierr = PetscFree(fromranks);CHKERRQ(ierr);
+  ierr = PetscFree(fromdata);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,nsend,nrecv,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+
+  /* move the indices of the off-process entries to their owners */
+  ntot = n1 + nrecv;
+  ierr = PetscMalloc4(nsend,&sendi,nsend,&sendj,nrecv,&recvi,nrecv,&recvj);CHKERRQ(ierr);
+  for (k=0; k<nsend; k++) {
+    sendi[k] = coo_i[sendperm[k]];
+    sendj[k] = coo_j[sendperm[k]];
+  }
+  ierr = PetscSFBcastBegin(sf,MPIU_INT,sendi,recvi);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf,MPIU_INT,sendj,recvj);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_INT,sendi,recvi);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_INT,sendj,recvj);CHKERRQ(ierr);
+
+  /* merge local and received entries; in perm[] values below n1 are local entries, the others received ones */
+  ierr = PetscMalloc2(ntot,&ci,ntot,&cj);CHKERRQ(ierr);
+  for (k=0; k<n1; k++) {
+    ci[k] = coo_i[lperm[k]] - rstart;
+    cj[k] = coo_j[lperm[k]];
+  }
+  for (k=0; k<nrecv; k++) {
+    ci[n1+k] = recvi[k] - rstart;
+    cj[n1+k] = recvj[k];
+  }
+  ierr = PetscFree4(sendi,sendj,recvi,recvj);CHKERRQ(ierr);
+  ierr = MatSeqAIJCOOBuildMap_Private(m,ntot,ci,cj,&Ii,&J,&jmap,&perm);CHKERRQ(ierr);
+  ierr = PetscFree2(ci,cj);CHKERRQ(ierr);
+
+  /* preallocate and insert the pattern; A's ignorezeroentries is used for both blocks by MatSetValues_MPIAIJ() */
+  ierr = PetscCalloc2(m,&d_nnz,m,&o_nnz);CHKERRQ(ierr);
+  nzA = nzB = nA1 = nA2 = nB1 = nB2 = 0;
+  for (r=0; r<m; r++) {
+    for (k=Ii[r]; k<Ii[r+1]; k++) {
+      for (q=0,t=jmap[k]; t<jmap[k+1]; t++) if (perm[t] < n1) q++;
+      if (J[k] >= cstart && J[k] < cend) {d_nnz[r]++; nA1 += q; nA2 += jmap[k+1]-jmap[k]-q;}
+      else                               {o_nnz[r]++; nB1 += q; nB2 += jmap[k+1]-jmap[k]-q;}
+    }
+    nzA += d_nnz[r];
+    nzB += o_nnz[r];
+  }
+  ierr = MatMPIAIJSetPreallocation(mat,0,d_nnz,0,o_nnz);CHKERRQ(ierr);
+  ierr = PetscFree2(d_nnz,o_nnz);CHKERRQ(ierr);
+  ierr = MatSetOption(mat,MAT_NEW_NONZERO_LOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ignorezeroentries = ((Mat_SeqAIJ*)mpiaij->A->data)->ignorezeroentries;
+  ((Mat_SeqAIJ*)mpiaij->A->data)->ignorezeroentries = PETSC_FALSE;
+  for (r=0; r<m; r++) {
+    row  = r + rstart;
+    ierr = MatSetValues_MPIAIJ(mat,1,&row,Ii[r+1]-Ii[r],J+Ii[r],NULL,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  nooffprocentries      = mat->nooffprocentries;
+  mat->nooffprocentries = PETSC_TRUE;
+  ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  mat->nooffprocentries = nooffprocentries;
+  ((Mat_SeqAIJ*)mpiaij->A->data)->ignorezeroentries = ignorezeroentries;
+  ierr = MatSetOption(mat,MAT_NEW_NONZERO_LOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
+
+  /* the nonzeros of each row of A and B are sorted by global column, as are the merged entries of the row */
+  ierr = PetscMalloc4(nzA+1,&Ajmap1,nA1,&Aperm1,nzB+1,&Bjmap1,nB1,&Bperm1);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nzA+1,&Ajmap2,nA2,&Aperm2,nzB+1,&Bjmap2,nB2,&Bperm2);CHKERRQ(ierr);
+  Ajmap1[0] = Ajmap2[0] = Bjmap1[0] = Bjmap2[0] = 0;
+  nzA = nzB = nA1 = nA2 = nB1 = nB2 = 0;
+  for (k=0; k<Ii[m]; k++) {
+    if (J[k] >= cstart && J[k] < cend) {
+      for (t=jmap[k]; t<jmap[k+1]; t++) {
+        if (perm[t] < n1) Aperm1[nA1++] = lperm[perm[t]];
+        else              Aperm2[nA2++] = perm[t] - n1;
+      }
+      nzA++;
+      Ajmap1[nzA] = nA1;
+      Ajmap2[nzA] = nA2;
+    } else {
+      for (t=jmap[k]; t<jmap[k+1]; t++) {
+        if (perm[t] < n1) Bperm1[nB1++] = lperm[perm[t]];
+        else              Bperm2[nB2++] = perm[t] - n1;
+      }
+      nzB++;
+      Bjmap1[nzB] = nB1;
+      Bjmap2[nzB] = nB2;
+    }
+  }
+  ierr = PetscFree(Ii);CHKERRQ(ierr);
+  ierr = PetscFree(J);CHKERRQ(ierr);
+  ierr = PetscFree(jmap);CHKERRQ(ierr);
+  ierr = PetscFree(perm);CHKERRQ(ierr);
+
+  mpiaij->coo_sf    = sf;
+  mpiaij->coo_nsend = nsend;
+  mpiaij->coo_nrecv = nrecv;
+  ierr = PetscMalloc1(nsend,&mpiaij->coo_sendperm);CHKERRQ(ierr);
+  ierr = PetscArraycpy(mpiaij->coo_sendperm,sendperm,nsend);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nsend,&mpiaij->coo_sendbuf,nrecv,&mpiaij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree3(lperm,sowner,sendperm);CHKERRQ(ierr);
+  mpiaij->Ajmap1 = Ajmap1; mpiaij->Aperm1 = Aperm1; mpiaij->Bjmap1 = Bjmap1; mpiaij->Bperm1 = Bperm1;
+  mpiaij->Ajmap2 = Ajmap2; mpiaij->Aperm2 = Aperm2; mpiaij->Bjmap2 = Bjmap2; mpiaij->Bperm2 = Bperm2;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  Mat            A = mpiaij->A,B = mpiaij->B;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  MatScalar      *aa = a->a,*ba = b->a;
+  PetscScalar    *sendbuf = mpiaij->coo_sendbuf,*recvbuf = mpiaij->coo_recvbuf,sum;
+  const PetscInt *Ajmap1 = mpiaij->Ajmap1,*Aperm1 = mpiaij->Aperm1,*Bjmap1 = mpiaij->Bjmap1,*Bperm1 = mpiaij->Bperm1;
+  const PetscInt *Ajmap2 = mpiaij->Ajmap2,*Aperm2 = mpiaij->Aperm2,*Bjmap2 = mpiaij->Bjmap2,*Bperm2 = mpiaij->Bperm2;
+  PetscInt       k,t;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mpiaij->coo_sf) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  for (k=0; k<mpiaij->coo_nsend; k++) sendbuf[k] = v ? v[mpiaij->coo_sendperm[k]] : 0.0;
+  ierr = PetscSFBcastBegin(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,recvbuf);CHKERRQ(ierr);
+
+  /* sum the local entries while the off-process ones are in flight */
+  for (k=0; k<a->nz; k++) {
+    sum = 0.0;
+    if (v) for (t=Ajmap1[k]; t<Ajmap1[k+1]; t++) sum += v[Aperm1[t]];
+    aa[k] = (imode == INSERT_VALUES) ? sum : aa[k] + sum;
+  }
+  for (k=0; k<b->nz; k++) {
+    sum = 0.0;
+    if (v) for (t=Bjmap1[k]; t<Bjmap1[k+1]; t++) sum += v[Bperm1[t]];
+    ba[k] = (imode == INSERT_VALUES) ? sum : ba[k] + sum;
+  }
+  ierr = PetscSFBcastEnd(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,recvbuf);CHKERRQ(ierr);
+
+  for (k=0; k<a->nz; k++) {
+    for (t=Ajmap2[k]; t<Ajmap2[k+1]; t++) aa[k] += recvbuf[Aperm2[t]];
+  }
+  for (k=0; k<b->nz; k++) {
+    for (t=Bjmap2[k]; t<Bjmap2[k+1]; t++) ba[k] += recvbuf[Bperm2[t]];
+  }
+  ierr = PetscLogFlops(Ajmap1[a->nz]+Ajmap2[a->nz]+Bjmap1[b->nz]+Bjmap2[b->nz]);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(B);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)B);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIAIJ,&flg);CHKERRQ(ierr);
+  if (!flg) { /* derived formats, and those of the blocks, rebuild their own copy of the values at assembly, as in MatSetValuesCOO_SeqAIJ() */
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMPIAIJSetPreallocationCSR - Allocates memory for a sparse parallel matrix in AIJ format
    (the default parallel PETSc format).
@@ -5720,6 +6046,8 @@ PetscErrorCode MatGetCommunicationStructs(Mat A, Vec *lvec, PetscInt *colmap[],
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSingle(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJDelta(Mat,MatType,MatReuse,Mat*);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat,MatType,MatReuse,Mat*);
 #endif
@@ -5817,7 +6145,12 @@ PETSC_INTERN PetscErrorCode MatProductSetFromOptions_MPIDense_MPIAIJ(Mat C)
    MATMPIAIJ - MATMPIAIJ = "mpiaij" - A matrix type to be used for parallel sparse matrices.
 
    Options Database Keys:
-. -mat_type mpiaij - sets the matrix type to "mpiaij" during a call to MatSetFromOptions()
++ -mat_type mpiaij - sets the matrix type to "mpiaij" during a call to MatSetFromOptions()
+. -mat_mpiaij_neighbor_overlap - in MatMult() and MatMultAdd() multiply the off-diagonal part by the entries received
+                                 from each neighbor process as soon as they arrive, the communication time hidden behind
+                                 and exposed by the computation is shown with -mat_view ::ascii_info
+- -mat_omp_num_threads <n> - number of OpenMP threads for the products with the diagonal and off-diagonal blocks, by
+                             default 1, see MATSEQAIJ
 
    Level: beginner
 
@@ -5877,9 +6210,13 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijsell_C",MatConvert_MPIAIJ_MPIAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijsingle_C",MatConvert_MPIAIJ_MPIAIJSingle);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijdelta_C",MatConvert_MPIAIJ_MPIAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijmkl_C",MatConvert_MPIAIJ_MPIAIJMKL);CHKERRQ(ierr);
 #endif
@@ -69,15 +69,46 @@ typedef struct {
   /* Used by MPICUSPARSE classes */
   void * spptr;
 
+  /* Used by MatSetPreallocationCOO() and MatSetValuesCOO() */
+  PetscSF     coo_sf;                              /* sends the off-process entries to their owners */
+  PetscInt    coo_nsend,coo_nrecv;                 /* number of entries sent and received */
+  PetscInt    *coo_sendperm;                       /* user entries packed into the send buffer */
+  PetscScalar *coo_sendbuf,*coo_recvbuf;
+  PetscInt    *Ajmap1,*Aperm1,*Bjmap1,*Bperm1;     /* local entries summed into the nonzeros of A and B */
+  PetscInt    *Ajmap2,*Aperm2,*Bjmap2,*Bperm2;     /* received entries summed into the nonzeros of A and B */
+
+  PetscBool        localityreorder;                /* MAT_LOCALITY_REORDER, passed to the diagonal block when it is created */
+  PetscInt         omp_nthreads;                   /* -mat_omp_num_threads, passed to both blocks when they are assembled */
+
+  /* Used by MatMult_MPIAIJ() and MatMultAdd_MPIAIJ() with -mat_mpiaij_neighbor_overlap, see mpiaijnbr.c */
+  PetscBool        nbr_use;                        /* multiply the off-diagonal part neighbor by neighbor */
+  PetscBool        nbr_ready;                      /* the neighbor data below is set up */
+  PetscObjectState nbr_nonzerostate;               /* nonzero state of the matrix when it was set up */
+  PetscSF          nbr_sf;                         /* leaves are the entries of lvec, roots the owned columns */
+  PetscMPIInt      nbr_tag;
+  PetscInt         *nbr_segptr;                    /* segments of neighbor k are nbr_segptr[k] .. nbr_segptr[k+1]-1 */
+  PetscInt         *nbr_segrow;                    /* row of each segment */
+  PetscInt         *nbr_segstart,*nbr_segend;      /* the nonzeros of B of each segment */
+  PetscScalar      *nbr_sbuf;                      /* packed entries of xx sent to the neighbors */
+  MPI_Request      *nbr_rreqs,*nbr_sreqs;
+  PetscInt         nbr_count;                      /* number of products done, for the diagnostic */
+  PetscLogDouble   nbr_hidden,nbr_exposed;         /* communication time overlapped with computation and waited for */
 } Mat_MPIAIJ;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
 
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatMPIAIJConvertBlocks_Private(Mat,MatType,PetscErrorCode (*)(Mat,MatType,MatReuse,Mat*));
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJBlocks_Private(Mat,MatType,MatType,PetscErrorCode (*)(Mat,MatType,MatReuse,Mat*),PetscErrorCode (*)(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[]),MatReuse,Mat*);
 
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatMPIAIJResetNeighbor_Private(Mat);
+PETSC_INTERN PetscErrorCode MatMultAdd_MPIAIJ_Neighbor(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatView_MPIAIJ_Neighbor(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat,MatDuplicateOption,Mat*);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat,PetscInt,IS [],PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat,PetscInt,IS [],PetscInt);
 PETSC_INTERN PetscErrorCode MatFDColoringCreate_MPIXAIJ(Mat,ISColoring,MatFDColoring);
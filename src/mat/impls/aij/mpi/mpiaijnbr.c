@@ -0,0 +1,234 @@
+
+/*
+    MatMult() and MatMultAdd() of MPIAIJ matrices that apply the off-diagonal part B neighbor by neighbor. The columns
+  of B (the entries of lvec) are sorted by global number, so the columns owned by one neighbor process are contiguous
+  in lvec and in each row of B. The rows of B are cut into one segment per row and neighbor; the message of each
+  neighbor is received directly into its part of lvec and its segments are multiplied as soon as MPI_Waitany() reports
+  it, instead of waiting for all the messages before starting on B.
+
+    The time spent blocked in MPI and the time the messages were in flight while computing are accumulated, the
+  averages per product since the nonzero structure last changed are shown with -mat_view ::ascii_info and with -info
+  when the matrix is destroyed.
+*/
+
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+#include <petsctime.h>
+
+PetscErrorCode MatMPIAIJResetNeighbor_Private(Mat A)
+{
+  Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->nbr_count) {
+    ierr = PetscInfo3(A,"MatMult with neighbor overlap: %D products, communication per product hidden %g exposed %g seconds\n",a->nbr_count,(double)(a->nbr_hidden/a->nbr_count),(double)(a->nbr_exposed/a->nbr_count));CHKERRQ(ierr);
+  }
+  a->nbr_count   = 0;
+  a->nbr_hidden  = 0.0;
+  a->nbr_exposed = 0.0;
+  ierr = PetscSFDestroy(&a->nbr_sf);CHKERRQ(ierr);
+  ierr = PetscFree4(a->nbr_segptr,a->nbr_segrow,a->nbr_segstart,a->nbr_segend);CHKERRQ(ierr);
+  ierr = PetscFree(a->nbr_sbuf);CHKERRQ(ierr);
+  ierr = PetscFree2(a->nbr_rreqs,a->nbr_sreqs);CHKERRQ(ierr);
+  a->nbr_ready = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatMPIAIJSetUpNeighbor_Private - Finds the neighbors of the process and cuts the rows of B into per neighbor segments
+
+   Collective on Mat
+
+   Notes:
+   Called from the first product after the nonzero structure changed. If the columns of lvec owned by some neighbor
+   are not contiguous or the rows of B are not sorted (possible when garray was provided by the caller) the products
+   use the VecScatter as usual on all processes.
+*/
+static PetscErrorCode MatMPIAIJSetUpNeighbor_Private(Mat A)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ*)A->data;
+  Mat_SeqAIJ        *b;
+  PetscInt          m = A->rmap->n,ec,nranks,niranks,i,k,p,t,s,nseg = 0,*nbr = NULL,*cnt = NULL;
+  const PetscInt    *roffset,*rmine,*ioffset,*bi = NULL,*bj = NULL;
+  const PetscMPIInt *ranks,*iranks;
+  PetscBool         isseqaij,ok,gok;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMPIAIJResetNeighbor_Private(A);CHKERRQ(ierr);
+  a->nbr_nonzerostate = A->nonzerostate;
+  ierr = VecGetSize(a->lvec,&ec);CHKERRQ(ierr);
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject)A),&a->nbr_sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(a->nbr_sf,A->cmap,ec,NULL,PETSC_COPY_VALUES,a->garray);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(a->nbr_sf);CHKERRQ(ierr);
+  ierr = PetscSFGetRootRanks(a->nbr_sf,&nranks,&ranks,&roffset,&rmine,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafRanks(a->nbr_sf,&niranks,&iranks,&ioffset,NULL);CHKERRQ(ierr);
+
+  ierr = PetscObjectTypeCompare((PetscObject)a->B,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  ok   = isseqaij;
+  if (ok) {
+    b  = (Mat_SeqAIJ*)a->B->data;
+    bi = b->i;
+    bj = b->j;
+    ierr = PetscMalloc2(ec,&nbr,nranks,&cnt);CHKERRQ(ierr);
+    for (k=0; k<nranks; k++) {
+      cnt[k] = 0;
+      for (p=roffset[k]; p<roffset[k+1]; p++) {
+        if (rmine[p] != rmine[roffset[k]] + p - roffset[k]) ok = PETSC_FALSE;
+        nbr[rmine[p]] = k;
+      }
+    }
+    for (i=0; i<m && ok; i++) {
+      for (p=bi[i]; p<bi[i+1]; p++) {
+        if (p > bi[i] && bj[p] <= bj[p-1]) {ok = PETSC_FALSE; break;}
+        if (p == bi[i] || nbr[bj[p]] != nbr[bj[p-1]]) {cnt[nbr[bj[p]]]++; nseg++;}
+      }
+    }
+  }
+  ierr = MPIU_Allreduce(&ok,&gok,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)A));CHKERRQ(ierr);
+  if (!gok) {
+    ierr = PetscFree2(nbr,cnt);CHKERRQ(ierr);
+    ierr = PetscInfo(A,"Columns of the off-diagonal part are not grouped by neighbor, using the VecScatter for MatMult()\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = PetscMalloc4(nranks+1,&a->nbr_segptr,nseg,&a->nbr_segrow,nseg,&a->nbr_segstart,nseg,&a->nbr_segend);CHKERRQ(ierr);
+  a->nbr_segptr[0] = 0;
+  for (k=0; k<nranks; k++) {
+    a->nbr_segptr[k+1] = a->nbr_segptr[k] + cnt[k];
+    cnt[k]             = a->nbr_segptr[k];
+  }
+  for (i=0; i<m; i++) {
+    for (p=bi[i]; p<bi[i+1]; p=t) {
+      k = nbr[bj[p]];
+      for (t=p+1; t<bi[i+1] && nbr[bj[t]] == k; t++) ;
+      s                  = cnt[k]++;
+      a->nbr_segrow[s]   = i;
+      a->nbr_segstart[s] = p;
+      a->nbr_segend[s]   = t;
+    }
+  }
+  ierr = PetscFree2(nbr,cnt);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ioffset[niranks],&a->nbr_sbuf);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nranks,&a->nbr_rreqs,niranks,&a->nbr_sreqs);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,(nranks+1+3*nseg)*sizeof(PetscInt)+ioffset[niranks]*sizeof(PetscScalar));CHKERRQ(ierr);
+  if (!a->nbr_tag) {ierr = PetscObjectGetNewTag((PetscObject)A,&a->nbr_tag);CHKERRQ(ierr);}
+  a->nbr_ready = PETSC_TRUE;
+  ierr = PetscInfo4(A,"Off-diagonal part applied neighbor by neighbor: receiving from %D and sending to %D processes, %D row segments for %D rows\n",nranks,niranks,nseg,m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* zz = A*xx (+ yy) */
+PetscErrorCode MatMultAdd_MPIAIJ_Neighbor(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ*)A->data;
+  Mat_SeqAIJ        *b;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)A);
+  PetscInt          nranks,niranks,i,k,n,s;
+  PetscMPIInt       len,idx;
+  const PetscInt    *roffset,*rmine,*ioffset,*irootloc,*segptr,*segrow,*segstart,*segend,*bj;
+  const PetscMPIInt *ranks,*iranks;
+  const MatScalar   *ba;
+  const PetscScalar *x;
+  PetscScalar       *z,*lv,*sbuf,sum;
+  PetscLogDouble    tpost,tlast,t0,t1,exposed = 0.0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->nbr_sf || a->nbr_nonzerostate != A->nonzerostate) {ierr = MatMPIAIJSetUpNeighbor_Private(A);CHKERRQ(ierr);}
+  if (!a->nbr_ready) {
+    ierr = VecScatterBegin(a->Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    if (yy) {ierr = (*a->A->ops->multadd)(a->A,xx,yy,zz);CHKERRQ(ierr);}
+    else    {ierr = (*a->A->ops->mult)(a->A,xx,zz);CHKERRQ(ierr);}
+    ierr = VecScatterEnd(a->Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = (*a->B->ops->multadd)(a->B,a->lvec,zz,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscSFGetRootRanks(a->nbr_sf,&nranks,&ranks,&roffset,&rmine,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafRanks(a->nbr_sf,&niranks,&iranks,&ioffset,&irootloc);CHKERRQ(ierr);
+  sbuf = a->nbr_sbuf;
+
+  /* post the receives straight into lvec, then pack and send the owned entries the neighbors need */
+  ierr = VecGetArray(a->lvec,&lv);CHKERRQ(ierr);
+  for (k=0; k<nranks; k++) {
+    ierr = PetscMPIIntCast(roffset[k+1]-roffset[k],&len);CHKERRQ(ierr);
+    ierr = MPI_Irecv(lv+rmine[roffset[k]],len,MPIU_SCALAR,ranks[k],a->nbr_tag,comm,&a->nbr_rreqs[k]);CHKERRQ(ierr);
+  }
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  for (i=0; i<ioffset[niranks]; i++) sbuf[i] = x[irootloc[i]];
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  for (k=0; k<niranks; k++) {
+    ierr = PetscMPIIntCast(ioffset[k+1]-ioffset[k],&len);CHKERRQ(ierr);
+    ierr = MPI_Isend(sbuf+ioffset[k],len,MPIU_SCALAR,iranks[k],a->nbr_tag,comm,&a->nbr_sreqs[k]);CHKERRQ(ierr);
+  }
+  ierr  = PetscTime(&tpost);CHKERRQ(ierr);
+  tlast = tpost;
+
+  /* the diagonal block while the messages are in flight */
+  if (yy) {ierr = (*a->A->ops->multadd)(a->A,xx,yy,zz);CHKERRQ(ierr);}
+  else    {ierr = (*a->A->ops->mult)(a->A,xx,zz);CHKERRQ(ierr);}
+
+  /* the segments of each neighbor in the order the messages arrive */
+  b        = (Mat_SeqAIJ*)a->B->data;
+  ba       = b->a;
+  bj       = b->j;
+  segptr   = a->nbr_segptr;
+  segrow   = a->nbr_segrow;
+  segstart = a->nbr_segstart;
+  segend   = a->nbr_segend;
+  ierr     = VecGetArray(zz,&z);CHKERRQ(ierr);
+  for (n=0; n<nranks; n++) {
+    ierr     = PetscTime(&t0);CHKERRQ(ierr);
+    ierr     = MPI_Waitany((PetscMPIInt)nranks,a->nbr_rreqs,&idx,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    ierr     = PetscTime(&t1);CHKERRQ(ierr);
+    exposed += t1 - t0;
+    tlast    = t1;
+    for (s=segptr[idx]; s<segptr[idx+1]; s++) {
+      const PetscInt  nz = segend[s] - segstart[s],*vj = bj + segstart[s];
+      const MatScalar *v = ba + segstart[s];
+
+      sum = 0.0;
+      PetscSparseDensePlusDot(sum,lv,v,vj,nz);
+      z[segrow[s]] += sum;
+    }
+  }
+  ierr     = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr     = VecRestoreArray(a->lvec,&lv);CHKERRQ(ierr);
+  /* the receives were in flight from tpost to tlast, all of it not spent in MPI_Waitany() was hidden */
+  a->nbr_hidden += PetscMax(tlast - tpost - exposed,0.0);
+  ierr     = PetscTime(&t0);CHKERRQ(ierr);
+  ierr     = MPI_Waitall((PetscMPIInt)niranks,a->nbr_sreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr     = PetscTime(&t1);CHKERRQ(ierr);
+  exposed += t1 - t0;
+
+  a->nbr_count++;
+  a->nbr_exposed += exposed;
+  ierr = PetscLogFlops(2.0*b->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the communication time per product, the largest over the processes with ::ascii_info and that of each process with ::ascii_info_detail */
+PetscErrorCode MatView_MPIAIJ_Neighbor(Mat A,PetscViewer viewer)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ*)A->data;
+  PetscViewerFormat format;
+  PetscLogDouble    t[2],tmax[2];
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->nbr_use) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  t[0] = a->nbr_count ? a->nbr_hidden/a->nbr_count : 0.0;
+  t[1] = a->nbr_count ? a->nbr_exposed/a->nbr_count : 0.0;
+  if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] MatMult with neighbor overlap: %D products, communication per product hidden %g exposed %g seconds\n",a->rank,a->nbr_count,(double)t[0],(double)t[1]);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  } else {
+    ierr = MPIU_Allreduce(t,tmax,2,MPIU_PETSCLOGDOUBLE,MPI_MAX,PetscObjectComm((PetscObject)A));CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"MatMult with neighbor overlap: %D products, communication per product (max over processes) hidden %g exposed %g seconds\n",a->nbr_count,(double)tmax[0],(double)tmax[1]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
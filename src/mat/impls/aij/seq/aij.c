@@ -700,6 +700,9 @@ PetscErrorCode MatView_SeqAIJ_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"];\n %s = spconvert(zzz);\n",name);CHKERRQ(ierr);
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    if (a->lvl_nthreads) {
+      ierr = PetscViewerASCIIPrintf(viewer,"level scheduled solve with %D threads: %D levels of L, %D levels of U, on average %g rows per level\n",a->lvl_nthreads,a->lvl_nL,a->lvl_nU,(double)(2*m)/(a->lvl_nL+a->lvl_nU));CHKERRQ(ierr);
+    }
     PetscFunctionReturn(0);
   } else if (format == PETSC_VIEWER_ASCII_COMMON) {
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
@@ -1094,6 +1097,8 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   if (!A->structure_only) {
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
+  ierr = MatSeqAIJSetUpOpenMP_Private(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetUpLocalityReorder_Private(A);CHKERRQ(ierr);
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1166,6 +1171,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = MatSeqAIJResetOpenMP_Private(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJResetLevelSolve_Private(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJResetLocalityReorder_Private(A);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1207,6 +1217,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_is_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_seqdense_seqaij_C",NULL);CHKERRQ(ierr);
@@ -1265,6 +1277,10 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
     if (flg) A->ops->setvalues = MatSetValues_SeqAIJ_SortedFull;
     else     A->ops->setvalues = MatSetValues_SeqAIJ;
     break;
+  case MAT_LOCALITY_REORDER:
+    a->localityreorder = flg;
+    if (A->assembled) {ierr = MatSeqAIJSetUpLocalityReorder_Private(A);CHKERRQ(ierr);}
+    break;
   default:
     SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"unknown option %d",op);
   }
@@ -1272,6 +1288,23 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       nthreads;
+  PetscBool      flg,set;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqAIJ options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_locality_reorder","Multiply with a copy of the matrix in reverse Cuthill-McKee order","MatSetOption",a->localityreorder,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = MatSetOption(A,MAT_LOCALITY_REORDER,flg);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-mat_omp_num_threads","Number of OpenMP threads for MatMult(), MatMultAdd() and MatMultTranspose()","None",PetscMax(a->omp_request,1),&nthreads,&set);CHKERRQ(ierr);
+  if (set) {ierr = MatSeqAIJSetOpenMPThreads_Private(A,nthreads);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatGetDiagonal_SeqAIJ(Mat A,Vec v)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
@@ -1323,6 +1356,18 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 #endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMultTransposeAdd_SeqAIJ_OpenMP(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX2)
+  if (a->inode.size && a->inode.isa >= MAT_KERNEL_ISA_AVX2) {
+    ierr = MatMultTransposeAdd_SeqAIJ_Inode(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
@@ -1385,6 +1430,16 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->lr_perm) {
+    ierr = MatMult_SeqAIJ_LocalityReorder(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMult_SeqAIJ_OpenMP(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
@@ -1537,6 +1592,16 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscBool         usecprow=a->compressedrow.use;
 
   PetscFunctionBegin;
+  if (a->lr_perm) {
+    ierr = MatMultAdd_SeqAIJ_LocalityReorder(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMultAdd_SeqAIJ_OpenMP(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   if (usecprow) { /* use compressed row format */
@@ -2937,8 +3002,11 @@ PETSC_INTERN PetscErrorCode MatSeqAIJGetArray_SeqAIJ(Mat A,PetscScalar *array[])
 
 PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat A,PetscScalar *array[])
 {
+  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data;
+
   PetscFunctionBegin;
-  *array = NULL;
+  *array      = NULL;
+  a->lr_state = -1; /* the values may have changed */
   PetscFunctionReturn(0);
 }
 
@@ -3448,7 +3516,7 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         0,
                                 /* 74*/ 0,
                                         MatFDColoringApply_AIJ,
-                                        0,
+                                        MatSetFromOptions_SeqAIJ,
                                         0,
                                         0,
                                 /* 79*/ MatFindZeroDiagonals_SeqAIJ,
@@ -3804,7 +3872,9 @@ PetscErrorCode  MatRetrieveValues(Mat mat)
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_kernel_isa <generic,avx2,avx512> - Instruction set for the vectorized inode MatMult() kernels, by default the best one the processor supports
+-  -mat_omp_num_threads <n> - Number of OpenMP threads for MatMult(), MatMultAdd() and MatMultTranspose(), by default 1; the threads use a plain row loop instead of the inode, compressed row and AVX2/AVX-512 kernels
 
    Level: intermediate
 
@@ -3865,7 +3935,9 @@ PetscErrorCode  MatCreateSeqAIJ(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_kernel_isa <generic,avx2,avx512> - Instruction set for the vectorized inode MatMult() kernels, by default the best one the processor supports
+-  -mat_omp_num_threads <n> - Number of OpenMP threads for MatMult(), MatMultAdd() and MatMultTranspose(), by default 1; the threads use a plain row loop instead of the inode, compressed row and AVX2/AVX-512 kernels
 
    Level: intermediate
 
@@ -3912,6 +3984,10 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
 
   b = (Mat_SeqAIJ*)B->data;
 
+  /* a new nonzero structure invalidates any map built by MatSetPreallocationCOO() */
+  ierr = PetscFree(b->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(b->coo_perm);CHKERRQ(ierr);
+
   if (!skipallocation) {
     if (!b->imax) {
       ierr = PetscMalloc1(B->rmap->n,&b->imax);CHKERRQ(ierr);
@@ -4081,6 +4157,143 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+/*
+   MatSeqAIJCOOBuildMap_Private - sorts a list of COO entries by row and column and merges the repeated ones
+
+   Input Parameters:
++  m - number of local rows
+.  n - number of entries
+.  coo_i - local row indices, in [0,m); entries with a negative row or column index are ignored
+-  coo_j - column indices
+
+   Output Parameters:
++  Ii - row offsets of the merged nonzeros, of length m+1
+.  J - column indices of the merged nonzeros, sorted in each row
+.  jmap - of length Ii[m]+1, nonzero k is made of the entries perm[jmap[k]] .. perm[jmap[k+1]-1]
+-  perm - indices into coo_i[] and coo_j[] of the kept entries, ordered by nonzero
+
+   Notes:
+   The caller is responsible for freeing all the output arrays with PetscFree()
+*/
+PetscErrorCode MatSeqAIJCOOBuildMap_Private(PetscInt m,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[],PetscInt **Ii,PetscInt **J,PetscInt **jmap,PetscInt **perm)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,r,t,nkept,nz,*offsets,*next,*cols,*p,*ii,*jj,*jm;
+
+  PetscFunctionBegin;
+  /* bucket the entries by row */
+  ierr = PetscCalloc2(m+1,&offsets,m,&next);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= m) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row %D is not in [0,%D)",coo_i[k],m);
+    offsets[coo_i[k]+1]++;
+  }
+  for (r=0; r<m; r++) {
+    offsets[r+1] += offsets[r];
+    next[r]       = offsets[r];
+  }
+  nkept = offsets[m];
+  ierr  = PetscMalloc1(nkept,&cols);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(nkept,&p);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    t       = next[coo_i[k]]++;
+    cols[t] = coo_j[k];
+    p[t]    = k;
+  }
+
+  /* sort each row by column and count the distinct columns */
+  nz = 0;
+  for (r=0; r<m; r++) {
+    ierr = PetscSortIntWithArray(offsets[r+1]-offsets[r],cols+offsets[r],p+offsets[r]);CHKERRQ(ierr);
+    for (t=offsets[r]; t<offsets[r+1]; t++) {
+      if (t == offsets[r] || cols[t] != cols[t-1]) nz++;
+    }
+  }
+
+  ierr = PetscMalloc1(m+1,&ii);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nz,&jj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nz+1,&jm);CHKERRQ(ierr);
+  nz   = 0;
+  for (r=0; r<m; r++) {
+    ii[r] = nz;
+    for (t=offsets[r]; t<offsets[r+1]; t++) {
+      if (t == offsets[r] || cols[t] != cols[t-1]) {
+        jj[nz] = cols[t];
+        jm[nz] = t;
+        nz++;
+      }
+    }
+  }
+  ii[m]  = nz;
+  jm[nz] = nkept;
+  ierr   = PetscFree2(offsets,next);CHKERRQ(ierr);
+  ierr   = PetscFree(cols);CHKERRQ(ierr);
+  *Ii    = ii;
+  *J     = jj;
+  *jmap  = jm;
+  *perm  = p;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       *Ii,*J,*jmap,*perm;
+  PetscBool      ignorezeroentries;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = MatSeqAIJCOOBuildMap_Private(A->rmap->n,n,coo_i,coo_j,&Ii,&J,&jmap,&perm);CHKERRQ(ierr);
+
+  /* the nonzeros are inserted as explicit zeros, they must not be dropped */
+  ignorezeroentries    = a->ignorezeroentries;
+  a->ignorezeroentries = PETSC_FALSE;
+  a->nonew             = 0;
+  ierr = MatSeqAIJSetPreallocationCSR(A,Ii,J,NULL);CHKERRQ(ierr);
+  a->ignorezeroentries = ignorezeroentries;
+  ierr = PetscFree(Ii);CHKERRQ(ierr);
+  ierr = PetscFree(J);CHKERRQ(ierr);
+
+  a->coo_jmap = jmap;
+  a->coo_perm = perm;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  const PetscInt *jmap = a->coo_jmap,*perm = a->coo_perm;
+  MatScalar      *aa = a->a;
+  PetscScalar    sum;
+  PetscInt       k,t;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  for (k=0; k<a->nz; k++) {
+    sum = 0.0;
+    if (v) {
+      for (t=jmap[k]; t<jmap[k+1]; t++) sum += v[perm[t]];
+    }
+    aa[k] = (imode == INSERT_VALUES) ? sum : aa[k] + sum;
+  }
+  ierr = PetscLogFlops(jmap[a->nz]);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
+  if (A->offloadmask != PETSC_OFFLOAD_UNALLOCATED) A->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&flg);CHKERRQ(ierr);
+  if (!flg) { /* derived formats rebuild their own copy of the values at assembly */
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4161,7 +4374,8 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat
    based on compressed sparse row format.
 
    Options Database Keys:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+- -mat_omp_num_threads <n> - number of OpenMP threads for MatMult(), MatMultAdd() and MatMultTranspose(), by default 1
 
    Level: beginner
 
@@ -4173,6 +4387,11 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat
     MatSetOptions(,MAT_STRUCTURE_ONLY,PETSC_TRUE) may be called for this matrix type. In this no
     space is allocated for the nonzero entries and any entries passed with MatSetValues() are ignored
 
+    With more than one OpenMP thread the products split the rows between the threads and multiply them with a plain
+    row loop: the inode, compressed row and AVX2/AVX-512 kernels are not used. Ask for threads only when there are
+    idle cores, for example with one MPI process per socket, and when the bandwidth of several cores outweighs these
+    kernels.
+
   Developer Notes:
     It would be nice if all matrix formats supported passing NULL in for the numerical values
 
@@ -4192,7 +4411,7 @@ M*/
 . -mat_type aij - sets the matrix type to "aij" during a call to MatSetFromOptions()
 
   Developer Notes:
-    Subclasses include MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
+    Subclasses include MATAIJCUSPARSE, MATAIJPERM, MATAIJSELL, MATAIJSINGLE, MATAIJDELTA, MATAIJMKL, MATAIJCRL, and also automatically switches over to use inodes when
    enough exist.
 
   Level: beginner
@@ -4409,6 +4628,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   b->idiagvalid         = PETSC_FALSE;
   b->ibdiagvalid        = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
+  b->lr_nonzerostate    = -1;
+  b->omp_nonzerostate   = -1;
 
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJGetArray_C",MatSeqAIJGetArray_SeqAIJ);CHKERRQ(ierr);
@@ -4426,6 +4647,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqbaij_C",MatConvert_SeqAIJ_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijperm_C",MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsell_C",MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsingle_C",MatConvert_SeqAIJ_SeqAIJSingle);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijdelta_C",MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmkl_C",MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -4452,6 +4675,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_is_seqaij_C",MatProductSetFromOptions_IS_XAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_seqdense_seqaij_C",MatProductSetFromOptions_SeqDense_SeqAIJ);CHKERRQ(ierr);
@@ -4543,9 +4768,15 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
     c->compressedrow.i      = NULL;
     c->compressedrow.rindex = NULL;
   }
-  c->nonzerorowcnt = a->nonzerorowcnt;
-  C->nonzerostate  = A->nonzerostate;
+  c->nonzerorowcnt    = a->nonzerorowcnt;
+  c->localityreorder  = a->localityreorder;
+  c->lr_nonzerostate  = -1;
+  c->omp_request      = a->omp_request;
+  c->omp_nonzerostate = -1;
+  C->nonzerostate     = A->nonzerostate;
 
+  ierr = MatSeqAIJSetUpOpenMP_Private(C);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetUpLocalityReorder_Private(C);CHKERRQ(ierr);
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -5048,6 +5279,8 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   ierr = MatSeqAIJRegister(MATSEQAIJCRL,      MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJPERM,     MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJSELL,     MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJSINGLE,   MatConvert_SeqAIJ_SeqAIJSingle);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJDELTA,    MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatSeqAIJRegister(MATSEQAIJMKL,      MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
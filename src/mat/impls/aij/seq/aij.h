@@ -97,6 +97,7 @@ typedef struct {
   PetscInt         max_limit;                      /* maximum supported inode limit */
   PetscBool        checked;                        /* if inodes have been checked for */
   PetscObjectState mat_nonzerostate;               /* non-zero state when inodes were checked for */
+  MatKernelISA     isa;                            /* vectorized MatMult() kernels to use, generic if the inodes are too small */
 } Mat_SeqAIJ_Inode;
 
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
@@ -105,6 +106,9 @@ PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat,MatOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat,MatDuplicateOption,Mat*);
+#if defined(MAT_KERNEL_HAVE_AVX2)
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ_Inode(Mat,Vec,Vec,Vec);
+#endif
 PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
@@ -122,6 +126,31 @@ typedef struct {
   PetscBool   ibdiagvalid;                    /* inverses of block diagonals are valid. */
   PetscBool   diagonaldense;                  /* all entries along the diagonal have been set; i.e. no missing diagonal terms */
   PetscScalar fshift,omega;                   /* last used omega and fshift */
+
+  /* MatSetValuesCOO(): nonzero k is the sum of the user values coo_perm[coo_jmap[k]] .. coo_perm[coo_jmap[k+1]-1] */
+  PetscInt    *coo_jmap,*coo_perm;
+
+  /* OpenMP MatMult(): thread t handles rows omp_rsplit[t] .. omp_rsplit[t+1]-1, which hold about nz/omp_nthreads nonzeros */
+  PetscInt    omp_nthreads,*omp_rsplit;
+  PetscInt    omp_request;                    /* threads asked for with -mat_omp_num_threads, 0 or 1 for none */
+  PetscScalar *omp_work;                      /* omp_nthreads-1 private copies of the result of MatMultTranspose() */
+  PetscObjectState omp_nonzerostate;          /* nonzero state the row split was computed for, -1 if none */
+
+  /* level scheduled MatSolve() of LU factors: the rows of level l of L are lvl_Lrows[lvl_Lptr[l]] .. lvl_Lrows[lvl_Lptr[l+1]-1],
+     they only depend on rows of lower levels and can be solved concurrently; likewise for U */
+  PetscInt    lvl_nthreads;                   /* threads used by MatSolve_SeqAIJ_Level(), 0 if the level schedule is not set up */
+  PetscInt    lvl_nL,lvl_nU;                  /* number of levels of L and U */
+  PetscInt    *lvl_Lptr,*lvl_Lrows,*lvl_Uptr,*lvl_Urows;
+
+  /* MAT_LOCALITY_REORDER: copy of the matrix with rows and columns in reverse Cuthill-McKee order used by MatMult() and MatMultAdd() */
+  PetscBool        localityreorder;           /* the option is set */
+  PetscInt         *lr_perm;                  /* row i of the copy is row lr_perm[i] of the matrix, NULL if there is no copy */
+  PetscInt         *lr_i,*lr_j;               /* nonzero structure of the copy */
+  PetscInt         *lr_map;                   /* entry k of the copy is a->a[lr_map[k]] */
+  MatScalar        *lr_a;
+  PetscScalar      *lr_x;                     /* permuted input vector */
+  PetscObjectState lr_state;                  /* object state the values of the copy were taken at */
+  PetscObjectState lr_nonzerostate;           /* nonzero state the ordering was computed for, -1 if none */
 } Mat_SeqAIJ;
 
 /*
@@ -209,6 +238,9 @@ PETSC_STATIC_INLINE PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA,MatScalar **a,PetscI
   } \
 
 PETSC_INTERN PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat,PetscInt,const PetscInt*);
+PETSC_INTERN PetscErrorCode MatSeqAIJCOOBuildMap_Private(PetscInt,PetscInt,const PetscInt[],const PetscInt[],PetscInt**,PetscInt**,PetscInt**,PetscInt**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_inplace(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat,Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat,Mat,IS,IS,const MatFactorInfo*);
@@ -230,6 +262,7 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 
@@ -287,6 +320,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscR
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,PetscReal,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat);
 #endif
@@ -296,10 +330,13 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ_matmattransposemult(Mat,Mat,PetscReal,Mat);
@@ -361,12 +398,29 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat,PetscReal,IS,IS);
 PETSC_INTERN PetscErrorCode MatRARt_SeqAIJ_SeqAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatSeqAIJSplitRows_Private(PetscInt,const PetscInt[],PetscInt,PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpOpenMP_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJResetOpenMP_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetOpenMPThreads_Private(Mat,PetscInt);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpLevelSolve_Private(Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatSeqAIJResetLevelSolve_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpLocalityReorder_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJResetLocalityReorder_Private(Mat);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_LocalityReorder(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_LocalityReorder(Mat,Vec,Vec,Vec);
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_OpenMP(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_OpenMP(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ_OpenMP(Mat,Vec,Vec,Vec);
+#endif
 
 PETSC_INTERN PetscErrorCode MatAXPYGetPreallocation_SeqX_private(PetscInt,const PetscInt*,const PetscInt*,const PetscInt*,const PetscInt*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatCreateMPIMatConcatenateSeqMat_SeqAIJ(MPI_Comm,Mat,PetscInt,MatReuse,Mat*);
@@ -0,0 +1,260 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class, but maintains a "shadow"
+  copy of the column indices in which each row stores its first column and
+  the offsets of the other columns from it in 8 or 16 bits, when the row is
+  narrow enough. MatMult(), MatMultAdd() and MatSOR() read these instead of
+  the PetscInt column indices, cutting the index traffic by a factor 4 to 8.
+*/
+
+#include <../src/mat/impls/aij/seq/aijshadow.h>
+
+/* width of the column offsets of a row; rows that span too many columns keep using Mat_SeqAIJ->j */
+typedef enum {MAT_AIJDELTA_FULL = 0,MAT_AIJDELTA_8 = 1,MAT_AIJDELTA_16 = 2} MatSeqAIJDeltaWidth;
+#define MAT_AIJDELTA_MAX_8  255
+#define MAT_AIJDELTA_MAX_16 65535
+
+typedef struct {
+  unsigned char    *width;   /* MatSeqAIJDeltaWidth of each row */
+  PetscInt         *base;    /* first column of each row */
+  PetscInt         *jstart;  /* start of the row in j8[], j16[] or Mat_SeqAIJ->j, depending on width[] */
+  unsigned char    *j8;      /* offsets from base[] of the rows stored in 8 bits */
+  unsigned short   *j16;     /* offsets from base[] of the rows stored in 16 bits */
+  PetscInt         nrows[3]; /* number of rows of each width, for PetscInfo() */
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when the offsets were last computed */
+  PetscBool        built;
+} Mat_SeqAIJDelta;
+
+static PetscErrorCode MatSeqAIJDeltaReset_Private(Mat_SeqAIJDelta *d)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(d->width,d->base,d->jstart);CHKERRQ(ierr);
+  ierr = PetscFree(d->j8);CHKERRQ(ierr);
+  ierr = PetscFree(d->j16);CHKERRQ(ierr);
+  d->built = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* Encode the column indices if and only if the nonzero structure changed since they were last encoded */
+static PetscErrorCode MatSeqAIJDelta_build_shadow(Mat A)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta *d = (Mat_SeqAIJDelta*)A->spptr;
+  const PetscInt  *ai = a->i,*aj = a->j;
+  PetscInt        i,k,m = A->rmap->n,n8 = 0,n16 = 0,span;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (d->built && d->nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  ierr = MatSeqAIJDeltaReset_Private(d);CHKERRQ(ierr);
+  ierr = PetscMalloc3(m,&d->width,m,&d->base,m,&d->jstart);CHKERRQ(ierr);
+  /* the columns of a row are sorted, so the span of a row is its last minus its first column */
+  for (i=0; i<m; i++) {
+    span = ai[i+1] > ai[i] ? aj[ai[i+1]-1] - aj[ai[i]] : 0;
+    if (span <= MAT_AIJDELTA_MAX_8) {
+      d->width[i] = MAT_AIJDELTA_8;  d->jstart[i] = n8;  n8  += ai[i+1] - ai[i];
+    } else if (span <= MAT_AIJDELTA_MAX_16) {
+      d->width[i] = MAT_AIJDELTA_16; d->jstart[i] = n16; n16 += ai[i+1] - ai[i];
+    } else {
+      d->width[i] = MAT_AIJDELTA_FULL; d->jstart[i] = ai[i];
+    }
+    d->base[i] = ai[i+1] > ai[i] ? aj[ai[i]] : 0;
+  }
+  ierr = PetscMalloc1(n8,&d->j8);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n16,&d->j16);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,m*(sizeof(unsigned char)+2*sizeof(PetscInt))+n8*sizeof(unsigned char)+n16*sizeof(unsigned short));CHKERRQ(ierr);
+  ierr = PetscArrayzero(d->nrows,3);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    d->nrows[d->width[i]]++;
+    switch (d->width[i]) {
+    case MAT_AIJDELTA_8:
+      for (k=ai[i]; k<ai[i+1]; k++) d->j8[d->jstart[i]+k-ai[i]] = (unsigned char)(aj[k] - d->base[i]);
+      break;
+    case MAT_AIJDELTA_16:
+      for (k=ai[i]; k<ai[i+1]; k++) d->j16[d->jstart[i]+k-ai[i]] = (unsigned short)(aj[k] - d->base[i]);
+      break;
+    default:
+      break;
+    }
+  }
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Rows with 8 bit offsets %D, with 16 bit offsets %D, with full indices %D\n",d->nrows[MAT_AIJDELTA_8],d->nrows[MAT_AIJDELTA_16],d->nrows[MAT_AIJDELTA_FULL]);CHKERRQ(ierr);
+  d->nonzerostate = A->nonzerostate;
+  d->built        = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* the MatSeqAIJShadowRowDot of this class */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJDeltaRowDot_Private(const Mat_SeqAIJ *a,const void *shadow,PetscInt i,PetscInt kstart,PetscInt kend,const PetscScalar *x)
+{
+  const Mat_SeqAIJDelta *d  = (const Mat_SeqAIJDelta*)shadow;
+  const MatScalar       *v  = a->a + a->i[i];
+  const PetscScalar     *xb = x + d->base[i];
+  PetscScalar           sum = 0.0;
+  PetscInt              k;
+
+  switch (d->width[i]) {
+  case MAT_AIJDELTA_8: {
+    const unsigned char *o = d->j8 + d->jstart[i];
+    for (k=kstart; k<kend; k++) sum += v[k]*xb[o[k]];
+  } break;
+  case MAT_AIJDELTA_16: {
+    const unsigned short *o = d->j16 + d->jstart[i];
+    for (k=kstart; k<kend; k++) sum += v[k]*xb[o[k]];
+  } break;
+  default: {
+    const PetscInt *idx = a->j + d->jstart[i];
+    for (k=kstart; k<kend; k++) sum += v[k]*x[idx[k]];
+  }
+  }
+  return sum;
+}
+
+PetscErrorCode MatMult_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDelta_build_shadow(A);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJShadow_Private(A,MatSeqAIJDeltaRowDot_Private,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDelta_build_shadow(A);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJShadow_Private(A,MatSeqAIJDeltaRowDot_Private,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the column indices are decoded from the offsets */
+PetscErrorCode MatSOR_SeqAIJDelta(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSOR_SeqAIJShadow_Private(A,MatSeqAIJDelta_build_shadow,MatSeqAIJDeltaRowDot_Private,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJDeltaCreateShadow_Private(Mat A)
+{
+  Mat_SeqAIJDelta *d;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(A,&d);CHKERRQ(ierr);
+  A->spptr = (void*)d;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJDeltaDestroyShadow_Private(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaReset_Private((Mat_SeqAIJDelta*)A->spptr);CHKERRQ(ierr);
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat,MatType,MatReuse,Mat*);
+PetscErrorCode MatDestroy_SeqAIJDelta(Mat);
+
+static const MatSeqAIJShadowOps MatSeqAIJDeltaOps = {MATSEQAIJDELTA,"MatConvert_seqaijdelta_seqaij_C",
+                                                      MatSeqAIJDeltaCreateShadow_Private,MatSeqAIJDeltaDestroyShadow_Private,
+                                                      MatConvert_SeqAIJDelta_SeqAIJ,MatDestroy_SeqAIJDelta,
+                                                      MatMult_SeqAIJDelta,MatMultAdd_SeqAIJDelta,MatSOR_SeqAIJDelta};
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert_SeqAIJShadow_SeqAIJ_Private(A,reuse,&MatSeqAIJDeltaOps,newmat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy_SeqAIJShadow_Private(A,&MatSeqAIJDeltaOps);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a
+ * SeqAIJDelta matrix.  This routine is called by the MatCreate_SeqAIJDelta()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJDelta one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert_SeqAIJ_SeqAIJShadow_Private(A,type,reuse,&MatSeqAIJDeltaOps,newmat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatCreateSeqAIJDelta - Creates a sparse matrix of type SEQAIJDELTA.
+   This type inherits from AIJ and is identical to it, except that MatMult(), MatMultAdd() and MatSOR()
+   read the column indices from a compressed copy: each row whose columns span at most 256 (65536) consecutive
+   columns stores its first column and the offsets of its nonzeros from it in 8 (16) bits. Wider rows fall back to
+   the usual PetscInt indices. For banded matrices, such as those from structured grids, this reduces the memory
+   traffic of these operations by about a quarter (by almost a half with 64 bit indices).
+   Because SEQAIJDELTA is a subtype of SEQAIJ, the option "-mat_seqaij_type seqaijdelta" can be used to make
+   sequential AIJ matrices default to being instances of MATSEQAIJDELTA, and MatConvert() converts between the two.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   The offsets are recomputed lazily, whenever the nonzero structure changed since they were computed. Run with -info
+   to see how many rows use each width.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatCreateMPIAIJDelta(), MatSetValues(), MatConvert()
+@*/
+PetscErrorCode  MatCreateSeqAIJDelta(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJDELTA);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJDelta(A,MATSEQAIJDELTA,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
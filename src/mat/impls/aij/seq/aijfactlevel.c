@@ -0,0 +1,172 @@
+
+/*
+    Level scheduled MatSolve() for the LU (and ILU) factors of SeqAIJ matrices. The rows of each triangular factor are
+  grouped into levels: a row of L is in level 1 + the largest level of the rows it depends on (0 if it depends on none),
+  likewise for U starting from the last row. The rows of one level are independent, so the sweeps are done level by
+  level with the rows of each level divided between OpenMP threads.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+PetscErrorCode MatSeqAIJResetLevelSolve_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(a->lvl_Lrows,a->lvl_Urows);CHKERRQ(ierr);
+  ierr = PetscFree2(a->lvl_Lptr,a->lvl_Uptr);CHKERRQ(ierr);
+  a->lvl_nthreads = 0;
+  a->lvl_nL       = 0;
+  a->lvl_nU       = 0;
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+static PetscErrorCode MatSolve_SeqAIJ_Level(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscInt          n = A->rmap->n,nL = a->lvl_nL,nU = a->lvl_nU,nthreads = a->lvl_nthreads;
+  const PetscInt    *ai = a->i,*aj = a->j,*adiag = a->diag,*rout,*cout,*r,*c;
+  const PetscInt    *Lptr = a->lvl_Lptr,*Lrows = a->lvl_Lrows,*Uptr = a->lvl_Uptr,*Urows = a->lvl_Urows;
+  const MatScalar   *aa = a->a;
+  PetscScalar       *x,*tmp = a->solve_work;
+  const PetscScalar *b;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&rout);CHKERRQ(ierr); r = rout;
+  ierr = ISGetIndices(a->col,&cout);CHKERRQ(ierr); c = cout;
+
+  /* the implicit barrier at the end of each worksharing loop separates the levels */
+#pragma omp parallel num_threads((int)nthreads)
+  {
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscInt        l,k,i,nz;
+    PetscScalar     sum;
+
+    /* forward solve the lower triangular */
+    for (l=0; l<nL; l++) {
+#pragma omp for schedule(static)
+      for (k=Lptr[l]; k<Lptr[l+1]; k++) {
+        i   = Lrows[k];
+        nz  = ai[i+1] - ai[i];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        tmp[i] = sum;
+      }
+    }
+
+    /* backward solve the upper triangular */
+    for (l=0; l<nU; l++) {
+#pragma omp for schedule(static)
+      for (k=Uptr[l]; k<Uptr[l+1]; k++) {
+        i   = Urows[k];
+        v   = aa + adiag[i+1]+1;
+        vi  = aj + adiag[i+1]+1;
+        nz  = adiag[i]-adiag[i+1]-1;
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+    }
+  }
+
+  ierr = ISRestoreIndices(a->row,&rout);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&cout);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   MatSeqAIJLevels_Private - Sorts the rows 0..n-1 by their level lev[] (levels 0..nlev-1), into rows[] with the rows of
+   level l at rows[ptr[l]] .. rows[ptr[l+1]-1], ascending within each level
+*/
+static PetscErrorCode MatSeqAIJLevels_Private(PetscInt n,const PetscInt lev[],PetscInt nlev,PetscInt ptr[],PetscInt rows[])
+{
+  PetscInt       i,l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscArrayzero(ptr,nlev+1);CHKERRQ(ierr);
+  for (i=0; i<n; i++) ptr[lev[i]+1]++;
+  for (l=0; l<nlev; l++) ptr[l+1] += ptr[l];
+  for (i=0; i<n; i++) rows[ptr[lev[i]]++] = i;
+  for (l=nlev; l>0; l--) ptr[l] = ptr[l-1];
+  ptr[0] = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJSetUpLevelSolve_Private - Computes the level sets of the L and U factors and switches MatSolve() to the level
+   scheduled threaded version if more than one thread was requested
+
+   Not Collective
+
+   Input Parameters:
++  fact - the numerically factored matrix, in the format produced by MatLUFactorNumeric_SeqAIJ()
+-  info - the factor info, info->solvethreads is the number of threads to use (see PCFactorSetMatSolveThreads())
+
+   Notes:
+   Called at the end of MatLUFactorNumeric_SeqAIJ() and MatLUFactorNumeric_SeqAIJ_Inode(); the levels only depend on
+   the nonzero structure but cost just O(nnz) integer work, which is small compared with the numeric factorization.
+
+   The sweeps synchronize the threads once per level so this pays off only when the levels hold many rows each; the
+   number of levels and the average rows per level are reported with -info and with -mat_view ::ascii_info.
+
+   Level: developer
+*/
+PetscErrorCode MatSeqAIJSetUpLevelSolve_Private(Mat fact,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)fact->data;
+  PetscInt       nthreads = (PetscInt)info->solvethreads;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscInt       i,k,l,n = fact->rmap->n,nL = 0,nU = 0,*lev;
+  const PetscInt *ai = a->i,*aj = a->j,*adiag = a->diag;
+#endif
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJResetLevelSolve_Private(fact);CHKERRQ(ierr);
+  if (nthreads < 2) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_OPENMP)
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(n,&lev);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    l = 0;
+    for (k=ai[i]; k<ai[i+1]; k++) l = PetscMax(l,lev[aj[k]]+1);
+    lev[i] = l;
+    nL     = PetscMax(nL,l+1);
+  }
+  ierr = PetscMalloc2(n,&a->lvl_Lrows,n,&a->lvl_Urows);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nL+1,&a->lvl_Lptr,n+1,&a->lvl_Uptr);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevels_Private(n,lev,nL,a->lvl_Lptr,a->lvl_Lrows);CHKERRQ(ierr);
+  for (i=n-1; i>=0; i--) {
+    l = 0;
+    for (k=adiag[i+1]+1; k<adiag[i]; k++) l = PetscMax(l,lev[aj[k]]+1);
+    lev[i] = l;
+    nU     = PetscMax(nU,l+1);
+  }
+  ierr = MatSeqAIJLevels_Private(n,lev,nU,a->lvl_Uptr,a->lvl_Urows);CHKERRQ(ierr);
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)fact,(3*n+nL+2)*sizeof(PetscInt));CHKERRQ(ierr);
+
+  a->lvl_nthreads    = nthreads;
+  a->lvl_nL          = nL;
+  a->lvl_nU          = nU;
+  fact->ops->solve   = MatSolve_SeqAIJ_Level;
+  ierr = PetscInfo5(fact,"Level scheduled solve with %D threads: %D levels of L, %D levels of U, on average %g rows per level for %D rows\n",nthreads,nL,nU,(double)(2*n)/(nL+nU),n);CHKERRQ(ierr);
+#else
+  ierr = PetscInfo1(fact,"PETSc was not configured with OpenMP, ignoring the request for %D MatSolve() threads\n",nthreads);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
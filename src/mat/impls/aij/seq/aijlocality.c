@@ -0,0 +1,173 @@
+
+/*
+    Support for MAT_LOCALITY_REORDER: the SeqAIJ matrix keeps a copy of itself with the rows and columns symmetrically
+  permuted into reverse Cuthill-McKee order, which MatMult() and MatMultAdd() use. The input vector is permuted into
+  a work array and the result is written straight to the original positions, so the vectors seen by the caller are
+  unchanged. For matrices whose rows are in an arbitrary (for example file or mesh generator) order this makes the
+  accesses to the input vector nearly contiguous.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsc/private/matorderimpl.h>
+
+PetscErrorCode MatSeqAIJResetLocalityReorder_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(a->lr_perm,a->lr_i,a->lr_x);CHKERRQ(ierr);
+  ierr = PetscFree3(a->lr_j,a->lr_map,a->lr_a);CHKERRQ(ierr);
+  a->lr_nonzerostate = -1;
+  PetscFunctionReturn(0);
+}
+
+/* largest distance of a nonzero from the diagonal, with row i of the matrix at position iperm[i] (identity if NULL) */
+static PetscInt MatSeqAIJBandwidth_Private(PetscInt m,const PetscInt *ai,const PetscInt *aj,const PetscInt *iperm)
+{
+  PetscInt i,k,r,bw = 0;
+
+  for (i=0; i<m; i++) {
+    r = iperm ? iperm[i] : i;
+    for (k=ai[i]; k<ai[i+1]; k++) bw = PetscMax(bw,PetscAbsInt(r - (iperm ? iperm[aj[k]] : aj[k])));
+  }
+  return bw;
+}
+
+/*
+   MatSeqAIJSetUpLocalityReorder_Private - Computes the reverse Cuthill-McKee ordering of the matrix and the permuted
+   copy used by MatMult() and MatMultAdd()
+
+   Not Collective
+
+   Input Parameter:
+.  A - the assembled matrix
+
+   Notes:
+   Called from MatAssemblyEnd_SeqAIJ() and MatSetOption(); the ordering is only computed again when the nonzero
+   structure changed. The copy is only kept if the ordering reduces the bandwidth of the matrix. Its values are
+   refreshed at the first product after the values of the matrix changed.
+
+   Level: developer
+*/
+PetscErrorCode MatSeqAIJSetUpLocalityReorder_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       m = A->rmap->n,nz,i,k,p,nrow,bw,rbw,*mask,*xls,*iperm;
+  const PetscInt *ia,*ja,*ai = a->i,*aj = a->j;
+  PetscBool      done;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a->localityreorder || A->factortype || A->structure_only || !a->i || !m || m != A->cmap->n) {
+    ierr = MatSeqAIJResetLocalityReorder_Private(A);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (a->lr_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = MatSeqAIJResetLocalityReorder_Private(A);CHKERRQ(ierr);
+  nz   = ai[m];
+
+  ierr = MatGetRowIJ(A,1,PETSC_TRUE,PETSC_FALSE,&nrow,&ia,&ja,&done);CHKERRQ(ierr);
+  if (!done) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot get rows for matrix");
+  ierr = PetscMalloc3(m,&a->lr_perm,m+1,&a->lr_i,m,&a->lr_x);CHKERRQ(ierr);
+  ierr = PetscMalloc3(m,&mask,2*m,&xls,m,&iperm);CHKERRQ(ierr);
+  ierr = SPARSEPACKgenrcm(&nrow,ia,ja,a->lr_perm,mask,xls);CHKERRQ(ierr);
+  ierr = MatRestoreRowIJ(A,1,PETSC_TRUE,PETSC_FALSE,NULL,&ia,&ja,&done);CHKERRQ(ierr);
+  /* shift because Sparsepack indices start at one */
+  for (i=0; i<m; i++) iperm[--a->lr_perm[i]] = i;
+
+  bw  = MatSeqAIJBandwidth_Private(m,ai,aj,NULL);
+  rbw = MatSeqAIJBandwidth_Private(m,ai,aj,iperm);
+  if (rbw >= bw) {
+    ierr = PetscInfo2(A,"Reverse Cuthill-McKee does not reduce the bandwidth %D (%D), keeping the original order\n",bw,rbw);CHKERRQ(ierr);
+    ierr = PetscFree3(mask,xls,iperm);CHKERRQ(ierr);
+    ierr = MatSeqAIJResetLocalityReorder_Private(A);CHKERRQ(ierr);
+    a->lr_nonzerostate = A->nonzerostate;
+    PetscFunctionReturn(0);
+  }
+
+  ierr = PetscMalloc3(nz,&a->lr_j,nz,&a->lr_map,nz,&a->lr_a);CHKERRQ(ierr);
+  a->lr_i[0] = 0;
+  for (i=0,p=0; i<m; i++) {
+    PetscInt row = a->lr_perm[i];
+
+    for (k=ai[row]; k<ai[row+1]; k++,p++) {
+      a->lr_j[p]   = iperm[aj[k]];
+      a->lr_map[p] = k;
+    }
+    a->lr_i[i+1] = p;
+    ierr = PetscSortIntWithArray(p-a->lr_i[i],a->lr_j+a->lr_i[i],a->lr_map+a->lr_i[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(mask,xls,iperm);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,(2*m+1+2*nz)*sizeof(PetscInt)+m*sizeof(PetscScalar)+nz*sizeof(MatScalar));CHKERRQ(ierr);
+  a->lr_state        = -1;
+  a->lr_nonzerostate = A->nonzerostate;
+  ierr = PetscInfo2(A,"Reverse Cuthill-McKee ordering for MatMult() reduces the bandwidth from %D to %D\n",bw,rbw);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* zz = A*xx (+ yy), using the permuted copy */
+static PetscErrorCode MatMultAdd_SeqAIJ_LocalityReorder_Private(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y = NULL,*z,*xp = a->lr_x;
+  const PetscInt    *perm = a->lr_perm,*ii = a->lr_i,*jj = a->lr_j;
+  const MatScalar   *aa;
+  PetscInt          i,m = A->rmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (a->lr_state != ((PetscObject)A)->state) {
+    const PetscInt *map = a->lr_map;
+
+    for (i=0; i<ii[m]; i++) a->lr_a[i] = a->a[map[i]];
+    a->lr_state = ((PetscObject)A)->state;
+  }
+  aa   = a->lr_a;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  for (i=0; i<m; i++) xp[i] = x[perm[i]];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for if(a->omp_nthreads > 1) num_threads((int)a->omp_nthreads) schedule(static)
+#endif
+  for (i=0; i<m; i++) {
+    const PetscInt  n = ii[i+1] - ii[i],*idx = jj + ii[i];
+    const MatScalar *v = aa + ii[i];
+    PetscScalar     sum = y ? y[perm[i]] : 0.0;
+
+    PetscSparseDensePlusDot(sum,xp,v,idx,n);
+    z[perm[i]] = sum;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(zz,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJ_LocalityReorder(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqAIJ_LocalityReorder_Private(A,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_LocalityReorder(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqAIJ_LocalityReorder_Private(A,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
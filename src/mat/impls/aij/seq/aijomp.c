@@ -0,0 +1,242 @@
+
+/*
+    OpenMP versions of the SeqAIJ matrix-vector products. The rows are split between the threads once, when the
+  nonzero structure is assembled, so that each thread gets about the same number of nonzeros.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/*
+   MatSeqAIJSplitRows_Private - Splits rows 0..m-1 into nparts contiguous ranges of about the same work, given the
+   cumulative work w[] (w[0] = 0 and row i costs w[i+1]-w[i], for example a->i for the number of nonzeros)
+
+   Part t gets rows rsplit[t] .. rsplit[t+1]-1; rsplit[] has length nparts+1.
+*/
+PetscErrorCode MatSeqAIJSplitRows_Private(PetscInt m,const PetscInt w[],PetscInt nparts,PetscInt rsplit[])
+{
+  PetscInt t,lo,hi,mid,target;
+
+  PetscFunctionBegin;
+  rsplit[0]      = 0;
+  rsplit[nparts] = m;
+  for (t=1; t<nparts; t++) {
+    /* first row that starts at or after the t-th share of the work */
+    target = (PetscInt)(((PetscInt64)w[m]*t)/nparts);
+    lo     = rsplit[t-1];
+    hi     = m;
+    while (lo < hi) {
+      mid = lo + (hi - lo)/2;
+      if (w[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    rsplit[t] = lo;
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJResetOpenMP_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(a->omp_rsplit);CHKERRQ(ierr);
+  ierr = PetscFree(a->omp_work);CHKERRQ(ierr);
+  a->omp_nthreads     = 0;
+  a->omp_nonzerostate = -1;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJSetUpOpenMP_Private - Decides how many OpenMP threads the products with the matrix use and computes the
+   nonzero balanced row split between them
+
+   Not Collective
+
+   Input Parameter:
+.  A - the assembled matrix
+
+   Notes:
+   The number of threads is the one given with -mat_omp_num_threads, see MatSeqAIJSetOpenMPThreads_Private(), limited
+   by the number of rows; without the option the products are not threaded.
+
+   Called from MatAssemblyEnd_SeqAIJ(); the threads and the split are only computed again when the nonzero structure
+   or the requested number of threads changed.
+
+   Level: developer
+*/
+PetscErrorCode MatSeqAIJSetUpOpenMP_Private(Mat A)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       m = A->rmap->n,nz,nthreads = a->omp_request;
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (A->factortype || A->structure_only || !a->i) {
+    ierr = MatSeqAIJResetOpenMP_Private(A);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (a->omp_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = MatSeqAIJResetOpenMP_Private(A);CHKERRQ(ierr);
+  a->omp_nonzerostate = A->nonzerostate;
+  nz       = a->i[m];
+  nthreads = PetscMin(nthreads,m);
+  if (nthreads < 2) PetscFunctionReturn(0);
+
+  ierr = PetscMalloc1(nthreads+1,&a->omp_rsplit);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,(nthreads+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = MatSeqAIJSplitRows_Private(m,a->i,nthreads,a->omp_rsplit);CHKERRQ(ierr);
+  a->omp_nthreads = nthreads;
+  ierr = PetscInfo3(A,"Using %D OpenMP threads for products with %D rows and %D nonzeros\n",nthreads,m,nz);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJSetOpenMPThreads_Private - Sets the number of OpenMP threads the products with the matrix use
+
+   Not Collective
+
+   Input Parameters:
++  A - the matrix
+-  nthreads - number of threads, 0 or 1 for none
+
+   Notes:
+   Set by MatSetFromOptions_SeqAIJ() from -mat_omp_num_threads and by MATMPIAIJ on its diagonal and off-diagonal
+   blocks, which have no options of their own. An assembled matrix is split again right away.
+
+   Level: developer
+*/
+PetscErrorCode MatSeqAIJSetOpenMPThreads_Private(Mat A,PetscInt nthreads)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->omp_request == nthreads) PetscFunctionReturn(0);
+  a->omp_request      = nthreads;
+  a->omp_nonzerostate = -1;
+  if (A->assembled) {ierr = MatSeqAIJSetUpOpenMP_Private(A);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+PetscErrorCode MatMult_SeqAIJ_OpenMP(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  const PetscInt    *ai = a->i,*aj = a->j,*rsplit = a->omp_rsplit;
+  const MatScalar   *aa = a->a;
+  PetscInt          t,nthreads = a->omp_nthreads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscInt        i,n;
+    PetscScalar     sum;
+
+    for (i=rsplit[t]; i<rsplit[t+1]; i++) {
+      n   = ai[i+1] - ai[i];
+      idx = aj + ai[i];
+      v   = aa + ai[i];
+      sum = 0.0;
+      PetscSparseDensePlusDot(sum,x,v,idx,n);
+      y[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_OpenMP(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y,*z;
+  const PetscInt    *ai = a->i,*aj = a->j,*rsplit = a->omp_rsplit;
+  const MatScalar   *aa = a->a;
+  PetscInt          t,nthreads = a->omp_nthreads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscInt        i,n;
+    PetscScalar     sum;
+
+    for (i=rsplit[t]; i<rsplit[t+1]; i++) {
+      n   = ai[i+1] - ai[i];
+      idx = aj + ai[i];
+      v   = aa + ai[i];
+      sum = y[i];
+      PetscSparseDensePlusDot(sum,x,v,idx,n);
+      z[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Thread 0 accumulates directly into yy, the other threads into private zeroed buffers that are then summed into yy
+   by a second parallel loop over the columns.
+*/
+PetscErrorCode MatMultTransposeAdd_SeqAIJ_OpenMP(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y,*work;
+  const PetscInt    *ai = a->i,*aj = a->j,*rsplit = a->omp_rsplit;
+  const MatScalar   *aa = a->a;
+  PetscInt          t,j,nthreads = a->omp_nthreads,n = A->cmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->omp_work) {
+    ierr = PetscMalloc1((nthreads-1)*n,&a->omp_work);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(nthreads-1)*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  work = a->omp_work;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscScalar *yt = t ? work + (t-1)*n : y,alpha;
+    PetscInt    i,k;
+
+    if (t) for (k=0; k<n; k++) yt[k] = 0.0;
+    for (i=rsplit[t]; i<rsplit[t+1]; i++) {
+      alpha = x[i];
+      for (k=ai[i]; k<ai[i+1]; k++) yt[aj[k]] += alpha*aa[k];
+    }
+  }
+#pragma omp parallel for num_threads((int)nthreads) schedule(static)
+  for (j=0; j<n; j++) {
+    PetscInt s;
+
+    for (s=1; s<nthreads; s++) y[j] += work[(s-1)*n + j];
+  }
+  ierr = PetscLogFlops(2.0*a->nz + (nthreads-1)*n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
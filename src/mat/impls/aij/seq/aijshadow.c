@@ -0,0 +1,96 @@
+/*
+  Conversions between MATSEQAIJ and the subclasses that stream a shadow copy of the values or the column indices,
+  see aijshadow.h. Each subclass describes itself with a MatSeqAIJShadowOps.
+*/
+
+#include <../src/mat/impls/aij/seq/aijshadow.h>
+
+PetscErrorCode MatAssemblyEnd_SeqAIJShadow(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  /* the inode routines would replace the MatMult() and MatSOR() that stream the shadow */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJShadow_Private(Mat A,const MatSeqAIJShadowOps *ops)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this matrix will not have an spptr pointer. */
+  if (A->spptr) {ierr = (*ops->destroyshadow)(A);CHKERRQ(ierr);}
+  ierr = PetscObjectComposeFunction((PetscObject)A,ops->convertname,NULL);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatConvert_SeqAIJShadow_SeqAIJ_Private(Mat A,MatReuse reuse,const MatSeqAIJShadowOps *ops,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,ops->convertname,NULL);CHKERRQ(ierr);
+  ierr = (*ops->destroyshadow)(B);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/* Called by the MatCreate_XXX() of the subclass, but can also be used to convert an assembled SeqAIJ matrix */
+PetscErrorCode MatConvert_SeqAIJ_SeqAIJShadow_Private(Mat A,MatType type,MatReuse reuse,const MatSeqAIJShadowOps *ops,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+  Mat_SeqAIJ     *b;
+  PetscBool      sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr = (*ops->createshadow)(B);CHKERRQ(ierr);
+  b    = (Mat_SeqAIJ*)B->data;
+
+  /* the assembly end may not be called again, so turn the inodes off here as well */
+  b->inode.use = PETSC_FALSE;
+
+  /* MatDuplicate_SeqAIJ() creates the duplicate with the MatCreate_XXX() of the subclass */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJShadow;
+  B->ops->destroy     = ops->destroy;
+  B->ops->mult        = ops->mult;
+  B->ops->multadd     = ops->multadd;
+  B->ops->sor         = ops->sor;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,ops->convertname,ops->convert);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,ops->type);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
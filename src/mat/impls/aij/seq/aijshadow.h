@@ -0,0 +1,187 @@
+#if !defined(__AIJSHADOW_H)
+#define __AIJSHADOW_H
+
+/*
+  Shared by the subclasses of MATSEQAIJ that keep a "shadow" copy of the nonzero values (MATSEQAIJSINGLE) or of the
+  column indices (MATSEQAIJDELTA) in Mat->spptr and stream it in MatMult(), MatMultAdd() and MatSOR() instead of
+  Mat_SeqAIJ->a or Mat_SeqAIJ->j. A subclass only provides how to build its shadow and how to take the dot product
+  of a part of a row with a vector; the traversals below pass these as compile time constants to the inline kernels,
+  so the compiler specializes the loops for each subclass.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* sum_{k=kstart}^{kend-1} A[i,col(i,k)]*x[col(i,k)], where k counts the nonzeros of row i from 0 */
+typedef PetscScalar (*MatSeqAIJShadowRowDot)(const Mat_SeqAIJ*,const void*,PetscInt,PetscInt,PetscInt,const PetscScalar*);
+
+typedef struct {
+  const char     *type;                        /* type name of the subclass */
+  const char     *convertname;                 /* name of the composed conversion back to MATSEQAIJ */
+  PetscErrorCode (*createshadow)(Mat);         /* allocates Mat->spptr; the shadow itself is built when first needed */
+  PetscErrorCode (*destroyshadow)(Mat);        /* frees Mat->spptr */
+  PetscErrorCode (*convert)(Mat,MatType,MatReuse,Mat*);
+  PetscErrorCode (*destroy)(Mat);
+  PetscErrorCode (*mult)(Mat,Vec,Vec);
+  PetscErrorCode (*multadd)(Mat,Vec,Vec,Vec);
+  PetscErrorCode (*sor)(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+} MatSeqAIJShadowOps;
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJShadow_Private(Mat,MatType,MatReuse,const MatSeqAIJShadowOps*,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJShadow_SeqAIJ_Private(Mat,MatReuse,const MatSeqAIJShadowOps*,Mat*);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJShadow_Private(Mat,const MatSeqAIJShadowOps*);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJShadow(Mat,MatAssemblyType);
+
+/* z[i] = y[i] + A[i,:] x for rows rstart..rend-1, y may be NULL */
+PETSC_STATIC_INLINE void MatMultRows_SeqAIJShadow_Private(const Mat_SeqAIJ *a,const void *shadow,MatSeqAIJShadowRowDot rowdot,PetscInt rstart,PetscInt rend,const PetscScalar *x,const PetscScalar *y,PetscScalar *z)
+{
+  const PetscInt *ai = a->i;
+  PetscInt       i;
+
+  for (i=rstart; i<rend; i++) z[i] = (y ? y[i] : 0.0) + rowdot(a,shadow,i,0,ai[i+1]-ai[i],x);
+}
+
+/* zz = yy + A xx, yy may be NULL; the shadow must have been built */
+PETSC_STATIC_INLINE PetscErrorCode MatMultAdd_SeqAIJShadow_Private(Mat A,MatSeqAIJShadowRowDot rowdot,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const void        *shadow = A->spptr;
+  const PetscScalar *x,*y = NULL;
+  PetscScalar       *z;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    const PetscInt *rsplit = a->omp_rsplit;
+    PetscInt       t,nthreads = a->omp_nthreads;
+
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) MatMultRows_SeqAIJShadow_Private(a,shadow,rowdot,rsplit[t],rsplit[t+1],x,y,z);
+  } else
+#endif
+  {
+    MatMultRows_SeqAIJShadow_Private(a,shadow,rowdot,0,A->rmap->n,x,y,z);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Same sweeps as MatSOR_SeqAIJ() with the rows read through rowdot(), which never touches the diagonal entry; the
+   inverted diagonal is taken from Mat_SeqAIJ. SOR_APPLY_UPPER and Eisenstat are left to MatSOR_SeqAIJ(), the shadow
+   is only built for the other sweeps.
+*/
+PETSC_STATIC_INLINE PetscErrorCode MatSOR_SeqAIJShadow_Private(Mat A,PetscErrorCode (*buildshadow)(Mat),MatSeqAIJShadowRowDot rowdot,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const void        *shadow;
+  PetscScalar       *x,sum,*t;
+  const PetscScalar *b,*xb;
+  const MatScalar   *idiag;
+  const PetscInt    *ai = a->i,*diag;
+  PetscInt          m = A->rmap->n,i,n,nl;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+  ierr = (*buildshadow)(A);CHKERRQ(ierr);
+
+  shadow = A->spptr;
+  diag   = a->diag;
+  t      = a->ssor_work;
+  idiag  = a->idiag;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  /* nl is the number of entries left of the diagonal, n the number in the row */
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        nl   = diag[i] - ai[i];
+        sum  = b[i] - rowdot(a,shadow,i,0,nl,x);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n   = ai[i+1] - ai[i];
+        nl  = diag[i] - ai[i];
+        sum = xb[i] - rowdot(a,shadow,i,nl+1,n,x);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n    = ai[i+1] - ai[i];
+        nl   = diag[i] - ai[i];
+        /* lower, saved for the backward sweep */
+        sum  = b[i] - rowdot(a,shadow,i,0,nl,x);
+        t[i] = sum;
+        /* upper */
+        sum -= rowdot(a,shadow,i,nl+1,n,x);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n  = ai[i+1] - ai[i];
+        nl = diag[i] - ai[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available), skipping the diagonal entry */
+          sum  = b[i] - rowdot(a,shadow,i,0,nl,x);
+          sum -= rowdot(a,shadow,i,nl+1,n,x);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = xb[i] - rowdot(a,shadow,i,nl+1,n,x);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
@@ -0,0 +1,227 @@
+/*
+  Defines basic operations for the MATSEQAIJSINGLE matrix class.
+  This class is derived from the MATSEQAIJ class, but maintains a "shadow"
+  copy of the nonzero values rounded to single precision, which is streamed
+  by MatMult(), MatMultAdd() and MatSOR(). All arithmetic is done in
+  PetscScalar, only the loads of the matrix values are narrowed.
+*/
+
+#include <../src/mat/impls/aij/seq/aijshadow.h>
+
+/* complex and non-double builds have no narrower type to store the values in, there the shadow is a plain copy */
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+typedef float MatScalarSingle;
+#else
+typedef MatScalar MatScalarSingle;
+#endif
+
+typedef struct {
+  MatScalarSingle  *a;     /* the single precision values, same layout as Mat_SeqAIJ->a */
+  PetscInt         maxnz;  /* length of a[] */
+  PetscObjectState state;  /* state of the matrix when a[] was last filled */
+} Mat_SeqAIJSingle;
+
+/* Fill the shadow values if and only if the matrix changed since they were last filled */
+static PetscErrorCode MatSeqAIJSingle_build_shadow(Mat A)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)A->spptr;
+  PetscInt         k,nz = a->i[A->rmap->n];
+  PetscObjectState state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (s->a && s->state == state) PetscFunctionReturn(0);
+
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  if (!s->a || nz > s->maxnz) {
+    ierr     = PetscFree(s->a);CHKERRQ(ierr);
+    ierr     = PetscMalloc1(PetscMax(nz,1),&s->a);CHKERRQ(ierr);
+    ierr     = PetscLogObjectMemory((PetscObject)A,(PetscMax(nz,1)-s->maxnz)*sizeof(MatScalarSingle));CHKERRQ(ierr);
+    s->maxnz = PetscMax(nz,1);
+  }
+  for (k=0; k<nz; k++) s->a[k] = (MatScalarSingle)a->a[k];
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  s->state = state;
+  PetscFunctionReturn(0);
+}
+
+/* sum_k v[k]*x[idx[k]], the values are widened to PetscScalar before the multiply */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJSingleDot_Private(PetscInt n,const MatScalarSingle *v,const PetscInt *idx,const PetscScalar *x)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    k;
+
+  for (k=0; k<n; k++) sum += (PetscScalar)v[k]*x[idx[k]];
+  return sum;
+}
+
+/* the MatSeqAIJShadowRowDot of this class */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJSingleRowDot_Private(const Mat_SeqAIJ *a,const void *shadow,PetscInt i,PetscInt kstart,PetscInt kend,const PetscScalar *x)
+{
+  const Mat_SeqAIJSingle *s = (const Mat_SeqAIJSingle*)shadow;
+  PetscInt               k  = a->i[i] + kstart;
+
+  return MatSeqAIJSingleDot_Private(kend-kstart,s->a+k,a->j+k,x);
+}
+
+PetscErrorCode MatMult_SeqAIJSingle(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSingle_build_shadow(A);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJShadow_Private(A,MatSeqAIJSingleRowDot_Private,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJSingle(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSingle_build_shadow(A);CHKERRQ(ierr);
+  ierr = MatMultAdd_SeqAIJShadow_Private(A,MatSeqAIJSingleRowDot_Private,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the off-diagonal values are read from the single precision copy; the inverted diagonal is kept in PetscScalar */
+PetscErrorCode MatSOR_SeqAIJSingle(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSOR_SeqAIJShadow_Private(A,MatSeqAIJSingle_build_shadow,MatSeqAIJSingleRowDot_Private,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* values written through the raw array must invalidate the shadow copy */
+static PetscErrorCode MatSeqAIJRestoreArray_SeqAIJSingle(Mat A,PetscScalar *array[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJRestoreArray_SeqAIJ(A,array);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJSingleCreateShadow_Private(Mat A)
+{
+  Mat_SeqAIJSingle *s;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(A,&s);CHKERRQ(ierr);
+  A->spptr = (void*)s;
+  ierr     = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJRestoreArray_C",MatSeqAIJRestoreArray_SeqAIJSingle);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJSingleDestroyShadow_Private(Mat A)
+{
+  Mat_SeqAIJSingle *s = (Mat_SeqAIJSingle*)A->spptr;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(s->a);CHKERRQ(ierr);
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJRestoreArray_C",MatSeqAIJRestoreArray_SeqAIJ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingle_SeqAIJ(Mat,MatType,MatReuse,Mat*);
+PetscErrorCode MatDestroy_SeqAIJSingle(Mat);
+
+static const MatSeqAIJShadowOps MatSeqAIJSingleOps = {MATSEQAIJSINGLE,"MatConvert_seqaijsingle_seqaij_C",
+                                                       MatSeqAIJSingleCreateShadow_Private,MatSeqAIJSingleDestroyShadow_Private,
+                                                       MatConvert_SeqAIJSingle_SeqAIJ,MatDestroy_SeqAIJSingle,
+                                                       MatMult_SeqAIJSingle,MatMultAdd_SeqAIJSingle,MatSOR_SeqAIJSingle};
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingle_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert_SeqAIJShadow_SeqAIJ_Private(A,reuse,&MatSeqAIJSingleOps,newmat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJSingle(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy_SeqAIJShadow_Private(A,&MatSeqAIJSingleOps);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJSingle converts a SeqAIJ matrix into a
+ * SeqAIJSingle matrix.  This routine is called by the MatCreate_SeqAIJSingle()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJSingle one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert_SeqAIJ_SeqAIJShadow_Private(A,type,reuse,&MatSeqAIJSingleOps,newmat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatCreateSeqAIJSingle - Creates a sparse matrix of type SEQAIJSINGLE.
+   This type inherits from AIJ and is identical to it, except that MatMult(), MatMultAdd() and MatSOR()
+   read the nonzero values from a copy rounded to single precision. The arithmetic is still done in
+   PetscScalar, so the products are as accurate as the single precision values allow, while the memory
+   traffic for the values is halved. This makes it suited as the preconditioner matrix for PCSOR, PCJACOBI
+   and PCILU (the factors are computed from the full precision values) and for the smoothers of PCMG.
+   Because SEQAIJSINGLE is a subtype of SEQAIJ, the option "-mat_seqaij_type seqaijsingle" can be used to make
+   sequential AIJ matrices default to being instances of MATSEQAIJSINGLE.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   The single precision copy is refreshed lazily, whenever the state of the matrix changed since it was made.
+   Only builds with double precision real scalars store the copy in single precision; otherwise the matrix
+   behaves exactly as MATSEQAIJ.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatCreateMPIAIJSingle(), MatSetValues(), MATSEQAIJSINGLE
+@*/
+PetscErrorCode  MatCreateSeqAIJSingle(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJSINGLE);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingle(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJSingle(A,MATSEQAIJSINGLE,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
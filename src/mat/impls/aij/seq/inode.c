@@ -4,6 +4,9 @@
   by taking advantage of rows with identical nonzero structure (I-nodes).
 */
 #include <../src/mat/impls/aij/seq/aij.h>
+#if defined(MAT_KERNEL_HAVE_AVX2)
+#include <immintrin.h>
+#endif
 
 static PetscErrorCode MatCreateColInode_Private(Mat A,PetscInt *size,PetscInt **ns)
 {
@@ -364,6 +367,303 @@ static PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Inode(Mat A,PetscInt oshift,Pets
 
 /* ----------------------------------------------------------- */
 
+/*
+   Vectorized MatMult() kernels for inodes: the rows of an inode share their column indices, so each gathered
+   piece of x (or each scattered piece of y for the transpose) is used for all the rows of the inode.
+*/
+#if defined(MAT_KERNEL_HAVE_AVX2)
+PETSC_STATIC_INLINE MAT_KERNEL_TARGET_AVX2 PetscScalar MatInodeHorizontalSum_AVX2_Private(__m256d v)
+{
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+}
+
+/* sum[r] += (row r of the inode) . x for the nsz rows of an inode with n nonzeros per row stored starting at v */
+PETSC_STATIC_INLINE MAT_KERNEL_TARGET_AVX2 void MatInodeRowsDot_AVX2_Private(PetscInt nsz,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *x,PetscScalar *sum)
+{
+  __m256d  vec_x,vec_s0,vec_s1,vec_s2,vec_s3,vec_s4;
+  PetscInt k,r;
+
+  vec_s0 = vec_s1 = vec_s2 = vec_s3 = vec_s4 = _mm256_setzero_pd();
+  for (k=0; k<n-3; k+=4) {
+    vec_x  = _mm256_i32gather_pd(x,_mm_loadu_si128((__m128i const*)(idx+k)),8);
+    vec_s0 = _mm256_fmadd_pd(_mm256_loadu_pd(v+k),vec_x,vec_s0);
+    if (nsz > 1) vec_s1 = _mm256_fmadd_pd(_mm256_loadu_pd(v+n+k),vec_x,vec_s1);
+    if (nsz > 2) vec_s2 = _mm256_fmadd_pd(_mm256_loadu_pd(v+2*n+k),vec_x,vec_s2);
+    if (nsz > 3) vec_s3 = _mm256_fmadd_pd(_mm256_loadu_pd(v+3*n+k),vec_x,vec_s3);
+    if (nsz > 4) vec_s4 = _mm256_fmadd_pd(_mm256_loadu_pd(v+4*n+k),vec_x,vec_s4);
+  }
+  sum[0] += MatInodeHorizontalSum_AVX2_Private(vec_s0);
+  if (nsz > 1) sum[1] += MatInodeHorizontalSum_AVX2_Private(vec_s1);
+  if (nsz > 2) sum[2] += MatInodeHorizontalSum_AVX2_Private(vec_s2);
+  if (nsz > 3) sum[3] += MatInodeHorizontalSum_AVX2_Private(vec_s3);
+  if (nsz > 4) sum[4] += MatInodeHorizontalSum_AVX2_Private(vec_s4);
+  for (; k<n; k++) {
+    for (r=0; r<nsz; r++) sum[r] += v[r*n+k]*x[idx[k]];
+  }
+}
+
+/* y[idx[k]] += sum_r (row r of the inode)[k] * xr[r] */
+PETSC_STATIC_INLINE MAT_KERNEL_TARGET_AVX2 void MatInodeRowsAXPY_AVX2_Private(PetscInt nsz,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *xr,PetscScalar *y)
+{
+  __m256d     vec_t;
+  PetscScalar t[4];
+  PetscInt    k,r;
+
+  for (k=0; k<n-3; k+=4) {
+    vec_t = _mm256_mul_pd(_mm256_loadu_pd(v+k),_mm256_set1_pd(xr[0]));
+    for (r=1; r<nsz; r++) vec_t = _mm256_fmadd_pd(_mm256_loadu_pd(v+r*n+k),_mm256_set1_pd(xr[r]),vec_t);
+    _mm256_storeu_pd(t,vec_t);
+    y[idx[k]]   += t[0];
+    y[idx[k+1]] += t[1];
+    y[idx[k+2]] += t[2];
+    y[idx[k+3]] += t[3];
+  }
+  for (; k<n; k++) {
+    for (r=0; r<nsz; r++) y[idx[k]] += v[r*n+k]*xr[r];
+  }
+}
+
+static MAT_KERNEL_TARGET_AVX2 PetscErrorCode MatMult_SeqAIJ_Inode_AVX2(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,sum[5];
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,r,n,row,nsz,nonzerorow=0;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    if (nsz > 5) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+    nonzerorow += (n>0)*nsz;
+    for (r=0; r<nsz; r++) sum[r] = 0.0;
+    MatInodeRowsDot_AVX2_Private(nsz,n,a->j+ii[row],a->a+ii[row],x,sum);
+    for (r=0; r<nsz; r++) y[row+r] = sum[r];
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - nonzerorow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static MAT_KERNEL_TARGET_AVX2 PetscErrorCode MatMultAdd_SeqAIJ_Inode_AVX2(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*z,sum[5];
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,r,n,row,nsz;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    if (nsz > 5) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+    for (r=0; r<nsz; r++) sum[r] = z[row+r];
+    MatInodeRowsDot_AVX2_Private(nsz,n,a->j+ii[row],a->a+ii[row],x,sum);
+    for (r=0; r<nsz; r++) y[row+r] = sum[r];
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static MAT_KERNEL_TARGET_AVX2 PetscErrorCode MatMultTransposeAdd_SeqAIJ_Inode_AVX2(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,n,row,nsz;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    MatInodeRowsAXPY_AVX2_Private(nsz,n,a->j+ii[row],a->a+ii[row],x+row,y);
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(MAT_KERNEL_HAVE_AVX512)
+PETSC_STATIC_INLINE MAT_KERNEL_TARGET_AVX512 void MatInodeRowsDot_AVX512_Private(PetscInt nsz,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *x,PetscScalar *sum)
+{
+  __m512d  vec_x,vec_s0,vec_s1,vec_s2,vec_s3,vec_s4;
+  __m256i  vec_idx;
+  __mmask8 mask;
+  PetscInt k;
+
+  vec_s0 = vec_s1 = vec_s2 = vec_s3 = vec_s4 = _mm512_setzero_pd();
+  for (k=0; k<n-7; k+=8) {
+    vec_x  = _mm512_i32gather_pd(_mm256_loadu_si256((__m256i const*)(idx+k)),x,8);
+    vec_s0 = _mm512_fmadd_pd(_mm512_loadu_pd(v+k),vec_x,vec_s0);
+    if (nsz > 1) vec_s1 = _mm512_fmadd_pd(_mm512_loadu_pd(v+n+k),vec_x,vec_s1);
+    if (nsz > 2) vec_s2 = _mm512_fmadd_pd(_mm512_loadu_pd(v+2*n+k),vec_x,vec_s2);
+    if (nsz > 3) vec_s3 = _mm512_fmadd_pd(_mm512_loadu_pd(v+3*n+k),vec_x,vec_s3);
+    if (nsz > 4) vec_s4 = _mm512_fmadd_pd(_mm512_loadu_pd(v+4*n+k),vec_x,vec_s4);
+  }
+  if (k < n) { /* remaining columns with masked loads */
+    mask    = (__mmask8)(0xff >> (8-(n-k)));
+    vec_idx = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32((__mmask16)mask,idx+k));
+    vec_x   = _mm512_mask_i32gather_pd(_mm512_setzero_pd(),mask,vec_idx,x,8);
+    vec_s0  = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+k),vec_x,vec_s0);
+    if (nsz > 1) vec_s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+n+k),vec_x,vec_s1);
+    if (nsz > 2) vec_s2 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+2*n+k),vec_x,vec_s2);
+    if (nsz > 3) vec_s3 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+3*n+k),vec_x,vec_s3);
+    if (nsz > 4) vec_s4 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+4*n+k),vec_x,vec_s4);
+  }
+  sum[0] += _mm512_reduce_add_pd(vec_s0);
+  if (nsz > 1) sum[1] += _mm512_reduce_add_pd(vec_s1);
+  if (nsz > 2) sum[2] += _mm512_reduce_add_pd(vec_s2);
+  if (nsz > 3) sum[3] += _mm512_reduce_add_pd(vec_s3);
+  if (nsz > 4) sum[4] += _mm512_reduce_add_pd(vec_s4);
+}
+
+/* the column indices of a row are distinct, so y can be gathered, updated and scattered back */
+PETSC_STATIC_INLINE MAT_KERNEL_TARGET_AVX512 void MatInodeRowsAXPY_AVX512_Private(PetscInt nsz,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *xr,PetscScalar *y)
+{
+  __m512d  vec_y;
+  __m256i  vec_idx;
+  __mmask8 mask;
+  PetscInt k,r;
+
+  for (k=0; k<n-7; k+=8) {
+    vec_idx = _mm256_loadu_si256((__m256i const*)(idx+k));
+    vec_y   = _mm512_i32gather_pd(vec_idx,y,8);
+    for (r=0; r<nsz; r++) vec_y = _mm512_fmadd_pd(_mm512_loadu_pd(v+r*n+k),_mm512_set1_pd(xr[r]),vec_y);
+    _mm512_i32scatter_pd(y,vec_idx,vec_y,8);
+  }
+  if (k < n) {
+    mask    = (__mmask8)(0xff >> (8-(n-k)));
+    vec_idx = _mm512_castsi512_si256(_mm512_maskz_loadu_epi32((__mmask16)mask,idx+k));
+    vec_y   = _mm512_mask_i32gather_pd(_mm512_setzero_pd(),mask,vec_idx,y,8);
+    for (r=0; r<nsz; r++) vec_y = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask,v+r*n+k),_mm512_set1_pd(xr[r]),vec_y);
+    _mm512_mask_i32scatter_pd(y,mask,vec_idx,vec_y,8);
+  }
+}
+
+static MAT_KERNEL_TARGET_AVX512 PetscErrorCode MatMult_SeqAIJ_Inode_AVX512(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,sum[5];
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,r,n,row,nsz,nonzerorow=0;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    if (nsz > 5) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+    nonzerorow += (n>0)*nsz;
+    for (r=0; r<nsz; r++) sum[r] = 0.0;
+    MatInodeRowsDot_AVX512_Private(nsz,n,a->j+ii[row],a->a+ii[row],x,sum);
+    for (r=0; r<nsz; r++) y[row+r] = sum[r];
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - nonzerorow);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static MAT_KERNEL_TARGET_AVX512 PetscErrorCode MatMultAdd_SeqAIJ_Inode_AVX512(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*z,sum[5];
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,r,n,row,nsz;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    if (nsz > 5) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+    for (r=0; r<nsz; r++) sum[r] = z[row+r];
+    MatInodeRowsDot_AVX512_Private(nsz,n,a->j+ii[row],a->a+ii[row],x,sum);
+    for (r=0; r<nsz; r++) y[row+r] = sum[r];
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static MAT_KERNEL_TARGET_AVX512 PetscErrorCode MatMultTransposeAdd_SeqAIJ_Inode_AVX512(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          i,n,row,nsz;
+  const PetscInt    *ns = a->inode.size,*ii = a->i;
+
+  PetscFunctionBegin;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0,row=0; i<a->inode.node_count; i++) {
+    nsz = ns[i];
+    n   = ii[row+1] - ii[row];
+    MatInodeRowsAXPY_AVX512_Private(nsz,n,a->j+ii[row],a->a+ii[row],x+row,y);
+    row += nsz;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(MAT_KERNEL_HAVE_AVX2)
+/*
+   Called by MatMultTransposeAdd_SeqAIJ() when MatSeqAIJCheckInode() selected vectorized inode kernels
+*/
+PetscErrorCode MatMultTransposeAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(MAT_KERNEL_HAVE_AVX512)
+  if (a->inode.isa >= MAT_KERNEL_ISA_AVX512) {
+    ierr = MatMultTransposeAdd_SeqAIJ_Inode_AVX512(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = MatMultTransposeAdd_SeqAIJ_Inode_AVX2(A,xx,zz,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -381,6 +681,28 @@ static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
 
   PetscFunctionBegin;
   if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+  if (a->lr_perm) {
+    ierr = MatMult_SeqAIJ_LocalityReorder(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMult_SeqAIJ_OpenMP(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX512)
+  if (a->inode.isa >= MAT_KERNEL_ISA_AVX512) {
+    ierr = MatMult_SeqAIJ_Inode_AVX512(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX2)
+  if (a->inode.isa >= MAT_KERNEL_ISA_AVX2) {
+    ierr = MatMult_SeqAIJ_Inode_AVX2(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   node_max = a->inode.node_count;
   ns       = a->inode.size;     /* Node Size array */
   ierr     = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
@@ -567,6 +889,28 @@ static PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
 
   PetscFunctionBegin;
   if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+  if (a->lr_perm) {
+    ierr = MatMultAdd_SeqAIJ_LocalityReorder(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMultAdd_SeqAIJ_OpenMP(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX512)
+  if (a->inode.isa >= MAT_KERNEL_ISA_AVX512) {
+    ierr = MatMultAdd_SeqAIJ_Inode_AVX512(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX2)
+  if (a->inode.isa >= MAT_KERNEL_ISA_AVX2) {
+    ierr = MatMultAdd_SeqAIJ_Inode_AVX2(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   node_max = a->inode.node_count;
   ns       = a->inode.size;     /* Node Size array */
 
@@ -1842,6 +2186,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  ierr = MatSeqAIJSetUpLevelSolve_Private(C,info);CHKERRQ(ierr);
 
   ierr = PetscLogFlops(C->cmap->n);CHKERRQ(ierr);
 
@@ -4096,6 +4441,7 @@ PetscErrorCode MatSeqAIJCheckInode(Mat A)
     a->inode.node_count       = 0;
     a->inode.size             = NULL;
     a->inode.use              = PETSC_FALSE;
+    a->inode.isa              = MAT_KERNEL_ISA_GENERIC;
     A->ops->mult              = MatMult_SeqAIJ;
     A->ops->sor               = MatSOR_SeqAIJ;
     A->ops->multadd           = MatMultAdd_SeqAIJ;
@@ -4126,6 +4472,12 @@ PetscErrorCode MatSeqAIJCheckInode(Mat A)
     a->inode.node_count = node_count;
     a->inode.size       = ns;
     ierr = PetscInfo3(A,"Found %D nodes of %D. Limit used: %D. Using Inode routines\n",node_count,m,a->inode.limit);CHKERRQ(ierr);
+    /* the vectorized kernels pay off when x is gathered for at least two rows on average */
+    a->inode.isa = MAT_KERNEL_ISA_GENERIC;
+    if (!A->factortype && m >= 2*node_count) {
+      ierr = MatGetKernelISA_Private(A,&a->inode.isa);CHKERRQ(ierr);
+      if (a->inode.isa < MAT_KERNEL_ISA_AVX2) a->inode.isa = MAT_KERNEL_ISA_GENERIC;
+    }
   }
   a->inode.checked          = PETSC_TRUE;
   a->inode.mat_nonzerostate = A->nonzerostate;
@@ -4143,6 +4495,7 @@ PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat A,MatDuplicateOption cpvalues,Mat *
   c->inode.use       = a->inode.use;
   c->inode.limit     = a->inode.limit;
   c->inode.max_limit = a->inode.max_limit;
+  c->inode.isa       = a->inode.isa;
   if (a->inode.size) {
     ierr                = PetscMalloc1(m+1,&c->inode.size);CHKERRQ(ierr);
     c->inode.node_count = a->inode.node_count;
@@ -68,6 +68,7 @@ PetscErrorCode MatCreate_SeqAIJ_Inode(Mat B)
   b->inode.size        = 0;
   b->inode.limit       = 5;
   b->inode.max_limit   = 5;
+  b->inode.isa         = MAT_KERNEL_ISA_GENERIC;
   b->inode.ibdiagvalid = PETSC_FALSE;
   b->inode.ibdiag      = 0;
   b->inode.bdiag       = 0;
@@ -124,6 +124,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat C
     PetscFunctionReturn(0);
   }
 
+  /* hash_threaded */
+  ierr = PetscStrcmp(alg,"hash_threaded",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(A,B,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1460,18 +1467,58 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat A,Mat B,PetscReal fill,Mat
   PetscFunctionReturn(0);
 }
 
+/* largest number of columns of the dense matrix processed in one pass over the sparse matrix */
+#define MAT_SEQAIJ_DENSE_MAX_COLS 16
+
+/*
+   Rows rstart..rend-1 of C(:,0:k-1) (+)= A*B(:,0:k-1), with the k columns of B stored row by row in bt[], that is
+   B(j,l) = bt[j*k+l], so that each nonzero of A is applied to k contiguous entries. Called with a constant k so
+   the loops over the columns are unrolled and vectorized.
+*/
+PETSC_STATIC_INLINE void MatMatMultDenseColumns_Private(PetscInt k,PetscInt rstart,PetscInt rend,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const PetscScalar *bt,PetscScalar *c,PetscInt clda,PetscBool add)
+{
+  PetscScalar r[MAT_SEQAIJ_DENSE_MAX_COLS];
+  PetscInt    i,j,l;
+
+  for (i=rstart; i<rend; i++) {
+    for (l=0; l<k; l++) r[l] = 0.0;
+    for (j=ai[i]; j<ai[i+1]; j++) {
+      const PetscScalar aval = aa[j];
+      const PetscScalar *b   = bt + aj[j]*k;
+
+      for (l=0; l<k; l++) r[l] += aval*b[l];
+    }
+    if (add) for (l=0; l<k; l++) c[i+l*clda] += r[l];
+    else     for (l=0; l<k; l++) c[i+l*clda]  = r[l];
+  }
+}
+
+static void MatMatMultDenseRows_Private(PetscInt k,PetscInt rstart,PetscInt rend,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const PetscScalar *bt,PetscScalar *c,PetscInt clda,PetscBool add)
+{
+  switch (k) {
+  case 16: MatMatMultDenseColumns_Private(16,rstart,rend,ai,aj,aa,bt,c,clda,add); break;
+  case 8:  MatMatMultDenseColumns_Private(8,rstart,rend,ai,aj,aa,bt,c,clda,add); break;
+  case 4:  MatMatMultDenseColumns_Private(4,rstart,rend,ai,aj,aa,bt,c,clda,add); break;
+  case 2:  MatMatMultDenseColumns_Private(2,rstart,rend,ai,aj,aa,bt,c,clda,add); break;
+  default: MatMatMultDenseColumns_Private(1,rstart,rend,ai,aj,aa,bt,c,clda,add);
+  }
+}
+
+/*
+   The columns of B are processed in passes of 16, 8, 4, 2 or 1 columns (the largest that fits in the remaining ones),
+   each pass reads A once and accumulates all its columns of C together
+*/
 PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat C,const PetscBool add)
 {
   Mat_SeqAIJ        *a=(Mat_SeqAIJ*)A->data;
   Mat_SeqDense      *bd=(Mat_SeqDense*)B->data;
   Mat_SeqDense      *cd=(Mat_SeqDense*)C->data;
   PetscErrorCode    ierr;
-  PetscScalar       *c,r1,r2,r3,r4,*c1,*c2,*c3,*c4;
-  const PetscScalar *aa,*b,*b1,*b2,*b3,*b4,*av;
-  const PetscInt    *aj;
-  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,am=A->rmap->n;
-  PetscInt          clda=cd->lda;
-  PetscInt          am4=4*clda,bm4=4*bm,col,i,j,n;
+  PetscScalar       *c,*bt;
+  const PetscScalar *b,*av;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,bn=B->rmap->n,am=A->rmap->n;
+  PetscInt          clda=cd->lda,col,k,i,l;
 
   PetscFunctionBegin;
   if (!cm || !cn) PetscFunctionReturn(0);
@@ -1482,96 +1529,29 @@ PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat
     ierr = MatDenseGetArrayWrite(C,&c);CHKERRQ(ierr);
   }
   ierr = MatDenseGetArrayRead(B,&b);CHKERRQ(ierr);
-  b1 = b; b2 = b1 + bm; b3 = b2 + bm; b4 = b3 + bm;
-  c1 = c; c2 = c1 + clda; c3 = c2 + clda; c4 = c3 + clda;
-  for (col=0; col<(cn/4)*4; col += 4) {  /* over columns of C */
-    for (i=0; i<am; i++) {        /* over rows of A in those columns */
-      r1 = r2 = r3 = r4 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = av + a->i[i];
-      for (j=0; j<n; j++) {
-        const PetscScalar aatmp = aa[j];
-        const PetscInt    ajtmp = aj[j];
-        r1 += aatmp*b1[ajtmp];
-        r2 += aatmp*b2[ajtmp];
-        r3 += aatmp*b3[ajtmp];
-        r4 += aatmp*b4[ajtmp];
-      }
-      if (add) {
-        c1[i] += r1;
-        c2[i] += r2;
-        c3[i] += r3;
-        c4[i] += r4;
-      } else {
-        c1[i] = r1;
-        c2[i] = r2;
-        c3[i] = r3;
-        c4[i] = r4;
-      }
+  ierr = PetscMalloc1(PetscMin(cn,MAT_SEQAIJ_DENSE_MAX_COLS)*bn,&bt);CHKERRQ(ierr);
+  for (col=0; col<cn; col += k) {
+    k = MAT_SEQAIJ_DENSE_MAX_COLS;
+    while (k > cn-col) k /= 2;
+    for (l=0; l<k; l++) {
+      const PetscScalar *bl = b + (col+l)*bm;
+
+      for (i=0; i<bn; i++) bt[i*k+l] = bl[i];
     }
-    b1 += bm4; b2 += bm4; b3 += bm4; b4 += bm4;
-    c1 += am4; c2 += am4; c3 += am4; c4 += am4;
-  }
-  /* process remaining columns */
-  if (col != cn) {
-    PetscInt rc = cn-col;
-
-    if (rc == 1) {
-      for (i=0; i<am; i++) {
-        r1 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = av + a->i[i];
-        for (j=0; j<n; j++) r1 += aa[j]*b1[aj[j]];
-        if (add) c1[i] += r1;
-        else c1[i] = r1;
-      }
-    } else if (rc == 2) {
-      for (i=0; i<am; i++) {
-        r1 = r2 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = av + a->i[i];
-        for (j=0; j<n; j++) {
-          const PetscScalar aatmp = aa[j];
-          const PetscInt    ajtmp = aj[j];
-          r1 += aatmp*b1[ajtmp];
-          r2 += aatmp*b2[ajtmp];
-        }
-        if (add) {
-          c1[i] += r1;
-          c2[i] += r2;
-        } else {
-          c1[i] = r1;
-          c2[i] = r2;
-        }
-      }
-    } else {
-      for (i=0; i<am; i++) {
-        r1 = r2 = r3 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = av + a->i[i];
-        for (j=0; j<n; j++) {
-          const PetscScalar aatmp = aa[j];
-          const PetscInt    ajtmp = aj[j];
-          r1 += aatmp*b1[ajtmp];
-          r2 += aatmp*b2[ajtmp];
-          r3 += aatmp*b3[ajtmp];
-        }
-        if (add) {
-          c1[i] += r1;
-          c2[i] += r2;
-          c3[i] += r3;
-        } else {
-          c1[i] = r1;
-          c2[i] = r2;
-          c3[i] = r3;
-        }
-      }
+#if defined(PETSC_HAVE_OPENMP)
+    if (a->omp_nthreads) {
+      const PetscInt *rsplit = a->omp_rsplit;
+      PetscInt       t,nthreads = a->omp_nthreads;
+
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+      for (t=0; t<nthreads; t++) MatMatMultDenseRows_Private(k,rsplit[t],rsplit[t+1],ai,aj,av,bt,c+col*clda,clda,add);
+    } else
+#endif
+    {
+      MatMatMultDenseRows_Private(k,0,am,ai,aj,av,bt,c+col*clda,clda,add);
     }
   }
+  ierr = PetscFree(bt);CHKERRQ(ierr);
   ierr = PetscLogFlops(cn*(2.0*a->nz));CHKERRQ(ierr);
   if (add) {
     ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
@@ -1957,11 +1937,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
-#else
-  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hypre"};
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_threaded"};
   PetscInt       nalg = 8;
+#else
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash_threaded","hypre"};
+  PetscInt       nalg = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2067,11 +2047,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool      flg = PETSC_FALSE;
   PetscInt       alg = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char      *algTypes[2] = {"scalable","rap"};
-  PetscInt        nalg = 2;
-#else
-  const char      *algTypes[3] = {"scalable","rap","hypre"};
+  const char      *algTypes[3] = {"scalable","rap","hash_threaded"};
   PetscInt        nalg = 3;
+#else
+  const char      *algTypes[4] = {"scalable","rap","hash_threaded","hypre"};
+  PetscInt        nalg = 4;
 #endif
 
   PetscFunctionBegin;
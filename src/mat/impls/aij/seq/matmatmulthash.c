@@ -0,0 +1,239 @@
+
+/*
+  Defines the "hash_threaded" matrix-matrix product routines for pairs of SeqAIJ matrices
+          C = A * B  and  C = P^T * A * P
+
+  The rows of C are split between OpenMP threads so that each gets about the same number of multiply-adds. Each thread
+  hashes the columns of its rows into a dense array as long as a row of C, marking which columns it has seen: a first
+  pass counts the nonzeros of every row so that C can be allocated with its exact size, a second pass fills in the
+  column indices, which are sorted after the parallel region. The numeric phase reuses the row split; each thread
+  records in a dense array the location in C of every column of the current row and accumulates the products straight
+  into C.
+
+  Only plain C is used inside the parallel regions; PetscSortInt(), the PetscHMapI routines and PetscMalloc() all touch
+  the (not thread safe) PETSc stack or memory tracking.
+
+  The parallel MPIAIJ products do not use these routines, so with several MPI processes the products are not threaded.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h> /*I "petscmat.h" I*/
+
+typedef struct {
+  PetscInt nthreads;
+  PetscInt *rsplit;  /* thread t computes rows rsplit[t] .. rsplit[t+1]-1 of C */
+  PetscInt nflops;   /* number of multiply-adds */
+} Mat_MatMatMultHash;
+
+static PetscErrorCode MatMatMultHashDestroy_Private(void *ptr)
+{
+  Mat_MatMatMultHash *hash = (Mat_MatMatMultHash*)ptr;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(hash->rsplit);CHKERRQ(ierr);
+  ierr = PetscFree(hash);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat B,PetscReal fill,Mat C)
+{
+  PetscErrorCode     ierr;
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c;
+  const PetscInt     *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j;
+  PetscInt           am = A->rmap->N,bn = B->cmap->N,bm = B->rmap->N,i,k,t,*w,*ci,*cj,*rsplit,*mark,nthreads = 1;
+  PetscReal          afill;
+  Mat_MatMatMultHash *hash;
+  PetscContainer     container;
+
+  PetscFunctionBegin;
+  /* w[i+1]-w[i] is the number of multiply-adds of row i of C */
+  ierr = PetscMalloc1(am+1,&w);CHKERRQ(ierr);
+  w[0] = 0;
+  for (i=0; i<am; i++) {
+    w[i+1] = w[i];
+    for (k=ai[i]; k<ai[i+1]; k++) w[i+1] += bi[aj[k]+1] - bi[aj[k]];
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  ierr     = PetscOptionsGetInt(((PetscObject)C)->options,((PetscObject)C)->prefix,"-mat_omp_num_threads",&nthreads,NULL);CHKERRQ(ierr);
+  nthreads = PetscMax(PetscMin(nthreads,am),1);
+#endif
+
+  ierr = PetscNew(&hash);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nthreads+1,&hash->rsplit);CHKERRQ(ierr);
+  hash->nthreads = nthreads;
+  hash->nflops   = w[am];
+  rsplit         = hash->rsplit;
+  ierr = MatSeqAIJSplitRows_Private(am,w,nthreads,rsplit);CHKERRQ(ierr);
+  ierr = PetscFree(w);CHKERRQ(ierr);
+
+  /* first pass: count the nonzeros of each row of C; mark[t*bn+col] is the last row of thread t that has col */
+  ierr  = PetscMalloc1(nthreads*bn,&mark);CHKERRQ(ierr);
+  for (k=0; k<nthreads*bn; k++) mark[k] = -1;
+  ierr  = PetscMalloc1(am+1,&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt *m = mark + t*bn,r,p,q,nz;
+
+    for (r=rsplit[t]; r<rsplit[t+1]; r++) {
+      for (p=ai[r],nz=0; p<ai[r+1]; p++) {
+        for (q=bi[aj[p]]; q<bi[aj[p]+1]; q++) {
+          if (m[bj[q]] != r) {m[bj[q]] = r; nz++;}
+        }
+      }
+      ci[r+1] = nz;
+    }
+  }
+  for (i=0; i<am; i++) ci[i+1] += ci[i];
+
+  /* second pass: exact size allocation and the column indices, in the order they are first met */
+  ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+  for (k=0; k<nthreads*bn; k++) mark[k] = -1;
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt *m = mark + t*bn,r,p,q,*cjr;
+
+    for (r=rsplit[t]; r<rsplit[t+1]; r++) {
+      cjr = cj + ci[r];
+      for (p=ai[r]; p<ai[r+1]; p++) {
+        for (q=bi[aj[p]]; q<bi[aj[p]+1]; q++) {
+          if (m[bj[q]] != r) {m[bj[q]] = r; *cjr++ = bj[q];}
+        }
+      }
+    }
+  }
+  ierr = PetscFree(mark);CHKERRQ(ierr);
+  for (i=0; i<am; i++) {ierr = PetscSortInt(ci[i+1]-ci[i],cj+ci[i]);CHKERRQ(ierr);}
+
+  /* put together the new symbolic matrix */
+  ierr = MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A),am,bn,ci,cj,NULL,((PetscObject)A)->type_name,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(C,A,B);CHKERRQ(ierr);
+
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)(C->data);
+  c->free_a  = PETSC_FALSE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,hash);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatMatMultHashDestroy_Private);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)C,"__PETSc__MatMatMultHash",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/(ai[am]+bi[bm]) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                  = ci[am];
+  c->nz                     = ci[am];
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+
+  ierr = PetscInfo3(C,"Using %D threads; Fill ratio: given %g needed %g\n",nthreads,(double)fill,(double)afill);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode     ierr;
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c = (Mat_SeqAIJ*)C->data;
+  const PetscInt     *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*ci = c->i,*cj = c->j,*rsplit;
+  const MatScalar    *aa = a->a,*ba = b->a;
+  MatScalar          *ca;
+  PetscInt           t,nthreads,bn = B->cmap->N,*pos;
+  Mat_MatMatMultHash *hash;
+  PetscContainer     container;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)C,"__PETSc__MatMatMultHash",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Matrix was not created with MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded()");
+  ierr = PetscContainerGetPointer(container,(void**)&hash);CHKERRQ(ierr);
+  if (!c->a) {
+    ierr      = PetscMalloc1(ci[C->rmap->n]+1,&c->a);CHKERRQ(ierr);
+    c->free_a = PETSC_TRUE;
+  }
+  ca       = c->a;
+  nthreads = hash->nthreads;
+  rsplit   = hash->rsplit;
+
+  /* pos[t*bn+col] is the location in ca of column col of the row thread t works on */
+  ierr = PetscMalloc1(nthreads*bn,&pos);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt    *ps = pos + t*bn,r,p,q;
+    PetscScalar av;
+
+    for (r=rsplit[t]; r<rsplit[t+1]; r++) {
+      for (p=ci[r]; p<ci[r+1]; p++) {
+        ps[cj[p]] = p;
+        ca[p]     = 0.0;
+      }
+      for (p=ai[r]; p<ai[r+1]; p++) {
+        av = aa[p];
+        for (q=bi[aj[p]]; q<bi[aj[p]+1]; q++) ca[ps[bj[q]]] += av*ba[q];
+      }
+    }
+  }
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*hash->nflops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  Mat AP,Pt;
+} Mat_PtAPHash;
+
+static PetscErrorCode MatDestroy_SeqAIJ_PtAPHash(void *data)
+{
+  Mat_PtAPHash   *ptap = (Mat_PtAPHash*)data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&ptap->AP);CHKERRQ(ierr);
+  ierr = MatDestroy(&ptap->Pt);CHKERRQ(ierr);
+  ierr = PetscFree(ptap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   C = P^T * (A * P), both products use the hash_threaded algorithm
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat P,PetscReal fill,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_PtAPHash   *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,4);
+  if (C->product->data) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Extra product struct not empty");
+  ierr = PetscNew(&ptap);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_SELF,&ptap->AP);CHKERRQ(ierr);
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(A,P,fill,ptap->AP);CHKERRQ(ierr);
+  ierr = MatTranspose_SeqAIJ(P,MAT_INITIAL_MATRIX,&ptap->Pt);CHKERRQ(ierr);
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_HashThreaded(ptap->Pt,ptap->AP,fill,C);CHKERRQ(ierr);
+
+  C->product->data    = ptap;
+  C->product->destroy = MatDestroy_SeqAIJ_PtAPHash;
+  C->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_HashThreaded;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_HashThreaded(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_PtAPHash   *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,3);
+  ptap = (Mat_PtAPHash*)C->product->data;
+  if (!ptap) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Missing data structure");
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(A,P,ptap->AP);CHKERRQ(ierr);
+  ierr = MatTranspose_SeqAIJ(P,MAT_REUSE_MATRIX,&ptap->Pt);CHKERRQ(ierr);
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_HashThreaded(ptap->Pt,ptap->AP,C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1492,6 +1492,7 @@ PetscErrorCode MatSetOption_MPIBAIJ(Mat A,MatOption op,PetscBool flg)
     break;
   case MAT_NEW_DIAGONALS:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_IGNORE_OFF_PROC_ENTRIES:
@@ -1258,6 +1258,7 @@ PetscErrorCode MatSetOption_SeqBAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_IGNORE_OFF_PROC_ENTRIES:
   case MAT_USE_HASH_TABLE:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_SPD:
@@ -2776,6 +2777,7 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   PetscErrorCode ierr;
   PetscInt       i,mbs,nbs,bs2;
   PetscBool      flg = PETSC_FALSE,skipallocation = PETSC_FALSE,realalloc = PETSC_FALSE;
+  MatKernelISA   isa;
 
   PetscFunctionBegin;
   if (nz >= 0 || nnz) realalloc = PETSC_TRUE;
@@ -2842,12 +2844,14 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       B->ops->multadd = MatMultAdd_SeqBAIJ_7;
       break;
     case 9:
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-      B->ops->mult    = MatMult_SeqBAIJ_9_AVX2;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_9_AVX2;
-#else
+      ierr = MatGetKernelISA_Private(B,&isa);CHKERRQ(ierr);
       B->ops->mult    = MatMult_SeqBAIJ_N;
       B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+#if defined(MAT_KERNEL_HAVE_AVX2)
+      if (isa >= MAT_KERNEL_ISA_AVX2) {
+        B->ops->mult    = MatMult_SeqBAIJ_9_AVX2;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_9_AVX2;
+      }
 #endif
       break;
     case 11:
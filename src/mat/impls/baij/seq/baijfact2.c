@@ -138,6 +138,7 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_N(Mat B,Mat A,const MatFactorInfo *inf
   MatScalar      *v_work;
   PetscBool      col_identity,row_identity,both_identity;
   PetscBool      allowzeropivot,zeropivotdetected;
+  MatKernelISA   isa;
 
   PetscFunctionBegin;
   ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
@@ -236,10 +237,10 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_N(Mat B,Mat A,const MatFactorInfo *inf
   if (both_identity) {
     switch (bs) {
     case  9:
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-      C->ops->solve = MatSolve_SeqBAIJ_9_NaturalOrdering;
-#else
+      ierr = MatGetKernelISA_Private(C,&isa);CHKERRQ(ierr);
       C->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering;
+#if defined(MAT_KERNEL_HAVE_AVX2)
+      if (isa >= MAT_KERNEL_ISA_AVX2) C->ops->solve = MatSolve_SeqBAIJ_9_NaturalOrdering;
 #endif
       break;
     case 11:
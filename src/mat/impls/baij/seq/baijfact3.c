@@ -10,6 +10,9 @@
 */
 PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat fact,PetscBool natural)
 {
+  MatKernelISA   isa;
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   if (natural) {
     switch (fact->rmap->bs) {
@@ -35,10 +38,10 @@ PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat fact,PetscBool natural)
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_7_NaturalOrdering;
       break;
     case 9:
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-      fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_9_NaturalOrdering;
-#else
+      ierr = MatGetKernelISA_Private(fact,&isa);CHKERRQ(ierr);
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_N;
+#if defined(MAT_KERNEL_HAVE_AVX2)
+      if (isa >= MAT_KERNEL_ISA_AVX2) fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_9_NaturalOrdering;
 #endif
       break;
     case 15:
@@ -1709,6 +1709,7 @@ static PetscErrorCode MatSetOption_SeqDense(Mat A,MatOption op,PetscBool flg)
   case MAT_IGNORE_ZERO_ENTRIES:
   case MAT_IGNORE_LOWER_TRIANGULAR:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_SPD:
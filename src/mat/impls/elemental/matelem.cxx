@@ -91,6 +91,7 @@ PetscErrorCode MatSetOption_Elemental(Mat A,MatOption op,PetscBool flg)
   case MAT_NEW_NONZERO_ALLOCATION_ERR:
   case MAT_SYMMETRIC:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
   case MAT_HERMITIAN:
     break;
   case MAT_ROW_ORIENTED:
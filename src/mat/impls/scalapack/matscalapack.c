@@ -80,6 +80,7 @@ PetscErrorCode MatSetOption_ScaLAPACK(Mat A,MatOption op,PetscBool flg)
     case MAT_NEW_NONZERO_ALLOCATION_ERR:
     case MAT_SYMMETRIC:
     case MAT_SORTED_FULL:
+    case MAT_LOCALITY_REORDER:
     case MAT_HERMITIAN:
       break;
     default:
@@ -1729,6 +1730,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_ScaLAPACK(Mat A)
   A->stash.ScatterGetMesg = MatStashScatterGetMesg_Ref;
   A->stash.ScatterEnd     = MatStashScatterEnd_Ref;
   A->stash.ScatterDestroy = NULL;
+  A->stash.hashed         = PETSC_FALSE;
 
   ierr = PetscNewLog(A,&a);CHKERRQ(ierr);
   A->data = (void*)a;
@@ -15,7 +15,8 @@
   the above preallocation routines for simplicity.
 
    Options Database Keys:
-. -mat_type sell - sets the matrix type to "sell" during a call to MatSetFromOptions()
++ -mat_type sell - sets the matrix type to "sell" during a call to MatSetFromOptions()
+- -mat_kernel_isa <generic,avx,avx2,avx512> - use the MatMult() kernels for this instruction set instead of the best one the processor supports
 
   Developer Notes:
     Subclasses include MATSELLCUSP, MATSELLCUSPARSE, MATSELLPERM, MATSELLCRL, and also automatically switches over to use inodes when
@@ -765,6 +766,7 @@ PetscErrorCode MatSetOption_MPISELL(Mat A,MatOption op,PetscBool flg)
     break;
   case MAT_NEW_DIAGONALS:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_IGNORE_OFF_PROC_ENTRIES:
@@ -5,7 +5,7 @@
 #include <../src/mat/impls/sell/seq/sell.h>  /*I   "petscmat.h"  I*/
 #include <petscblaslapack.h>
 #include <petsc/private/kernels/blocktranspose.h>
-#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX__)) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#if defined(MAT_KERNEL_HAVE_AVX)
 
   #include <immintrin.h>
 
@@ -13,25 +13,23 @@
   #define _MM_SCALE_8    8
   #endif
 
-  #if defined(__AVX512F__)
   /* these do not work
    vec_idx  = _mm512_loadunpackhi_epi32(vec_idx,acolidx);
    vec_vals = _mm512_loadunpackhi_pd(vec_vals,aval);
   */
-    #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
-    vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
-    vec_vals = _mm512_loadu_pd(aval); \
-    vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
-    vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
-  #elif defined(__AVX2__) && defined(__FMA__)
-    #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    vec_vals = _mm256_loadu_pd(aval); \
-    vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
-    vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
-    vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
-  #endif
-#endif  /* PETSC_HAVE_IMMINTRIN_H */
+  #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
+  vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
+  vec_vals = _mm512_loadu_pd(aval); \
+  vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
+  vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
+
+  #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  vec_vals = _mm256_loadu_pd(aval); \
+  vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
+  vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
+  vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
+#endif  /* MAT_KERNEL_HAVE_AVX */
 
 /*@C
  MatSeqSELLSetPreallocation - For good matrix assembly performance
@@ -171,6 +169,7 @@ PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat B,PetscInt maxallocrow,con
   if (realalloc) {
     ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
   }
+  ierr = MatGetKernelISA_Private(B,&b->kernelisa);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -292,7 +291,11 @@ PetscErrorCode MatConvert_SeqAIJ_SeqSELL(Mat A,MatType newtype,MatReuse reuse,Ma
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+/*
+   Vectorized variants of MatMult_SeqSELL() and MatMultAdd_SeqSELL(); the one matching a->kernelisa is used
+*/
+#if defined(MAT_KERNEL_HAVE_AVX512)
+static MAT_KERNEL_TARGET_AVX512 PetscErrorCode MatMult_SeqSELL_AVX512(Mat A,Vec xx,Vec yy)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
   PetscScalar       *y;
@@ -302,25 +305,11 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
   const PetscInt    *acolidx=a->colidx;
   PetscInt          i,j;
   PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d           vec_x,vec_y,vec_vals;
   __m256i           vec_idx;
   __mmask8          mask;
   __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
   __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128i           vec_idx;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*aval)
@@ -329,7 +318,6 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   for (i=0; i<totalslices; i++) { /* loop over slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -385,7 +373,37 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
       _mm512_storeu_pd(&y[8*i],vec_y);
     }
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(MAT_KERNEL_HAVE_AVX2)
+static MAT_KERNEL_TARGET_AVX2 PetscErrorCode MatMult_SeqSELL_AVX2(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128i           vec_idx;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,rows_left,row,nnz_in_row;
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -419,7 +437,37 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y+i*8,vec_y);
     _mm256_storeu_pd(y+i*8+4,vec_y2);
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(MAT_KERNEL_HAVE_AVX)
+static MAT_KERNEL_TARGET_AVX PetscErrorCode MatMult_SeqSELL_AVX(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128d           vec_x_tmp;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,rows_left,row,nnz_in_row;
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -468,7 +516,51 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y + i*8,     vec_y);
     _mm256_storeu_pd(y + i*8 + 4, vec_y2);
   }
-#else
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  PetscScalar       sum[8];
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+#if defined(MAT_KERNEL_HAVE_AVX512)
+  if (a->kernelisa >= MAT_KERNEL_ISA_AVX512) {
+    ierr = MatMult_SeqSELL_AVX512(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX2)
+  if (a->kernelisa >= MAT_KERNEL_ISA_AVX2) {
+    ierr = MatMult_SeqSELL_AVX2(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX)
+  if (a->kernelisa >= MAT_KERNEL_ISA_AVX) {
+    ierr = MatMult_SeqSELL_AVX(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=0; j<8; j++) sum[j] = 0.0;
     for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
@@ -487,7 +579,6 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
       for(j=0; j<8; j++) y[8*i+j] = sum[j];
     }
   }
-#endif
 
   ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
@@ -496,7 +587,9 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
 }
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmultadd.h>
-PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+
+#if defined(MAT_KERNEL_HAVE_AVX512)
+static MAT_KERNEL_TARGET_AVX512 PetscErrorCode MatMultAdd_SeqSELL_AVX512(Mat A,Vec xx,Vec yy,Vec zz)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
   PetscScalar       *y,*z;
@@ -506,20 +599,11 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
   const PetscInt    *acolidx=a->colidx;
   PetscInt          i,j;
   PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d           vec_x,vec_y,vec_vals;
   __m256i           vec_idx;
   __mmask8          mask;
   __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
   __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*aval)
@@ -528,7 +612,6 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   for (i=0; i<totalslices; i++) { /* loop over slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -588,7 +671,37 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
       _mm512_storeu_pd(&z[8*i],vec_y);
     }
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(MAT_KERNEL_HAVE_AVX)
+static MAT_KERNEL_TARGET_AVX PetscErrorCode MatMultAdd_SeqSELL_AVX(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128d           vec_x_tmp;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,row,nnz_in_row;
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -634,7 +747,45 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
     _mm256_storeu_pd(z+i*8,vec_y);
     _mm256_storeu_pd(z+i*8+4,vec_y2);
   }
-#else
+
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  PetscScalar       sum[8];
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+#if defined(MAT_KERNEL_HAVE_AVX512)
+  if (a->kernelisa >= MAT_KERNEL_ISA_AVX512) {
+    ierr = MatMultAdd_SeqSELL_AVX512(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MAT_KERNEL_HAVE_AVX)
+  if (a->kernelisa >= MAT_KERNEL_ISA_AVX) {
+    ierr = MatMultAdd_SeqSELL_AVX(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=0; j<8; j++) sum[j] = 0.0;
     for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
@@ -653,7 +804,6 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
       for (j=0; j<8; j++) z[8*i+j] = y[8*i+j] + sum[j];
     }
   }
-#endif
 
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
@@ -895,6 +1045,7 @@ PetscErrorCode MatSetOption_SeqSELL(Mat A,MatOption op,PetscBool flg)
   case MAT_IGNORE_OFF_PROC_ENTRIES:
   case MAT_USE_HASH_TABLE:
   case MAT_SORTED_FULL:
+  case MAT_LOCALITY_REORDER:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_SPD:
@@ -1997,6 +2148,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C,Mat A,MatDuplicateOption cpval
   c->col        = 0;
   c->icol       = 0;
   c->reallocs   = 0;
+  c->kernelisa  = a->kernelisa;
 
   C->assembled = PETSC_TRUE;
 
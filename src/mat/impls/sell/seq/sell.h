@@ -47,6 +47,7 @@ typedef struct {
   PetscBool   idiagvalid;                /* current idiag[] and mdiag[] are valid */
   PetscScalar fshift,omega;              /* last used omega and fshift */
   ISColoring  coloring;                  /* set with MatADSetColoring() used by MatADSetValues() */
+  MatKernelISA kernelisa;                /* instruction set of the vectorized MatMult() kernels to use */
 } Mat_SeqSELL;
 
 /*
@@ -32,6 +32,12 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
 
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingle(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSingle(Mat);
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJDelta(Mat);
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMKL(Mat);
@@ -128,6 +134,14 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegister(MATMPIAIJSELL,     MatCreate_MPIAIJSELL);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQAIJSELL,     MatCreate_SeqAIJSELL);CHKERRQ(ierr);
 
+  ierr = MatRegisterRootName(MATAIJSINGLE,MATSEQAIJSINGLE,MATMPIAIJSINGLE);CHKERRQ(ierr);
+  ierr = MatRegister(MATMPIAIJSINGLE,   MatCreate_MPIAIJSingle);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJSINGLE,   MatCreate_SeqAIJSingle);CHKERRQ(ierr);
+
+  ierr = MatRegisterRootName(MATAIJDELTA,MATSEQAIJDELTA,MATMPIAIJDELTA);CHKERRQ(ierr);
+  ierr = MatRegister(MATMPIAIJDELTA,    MatCreate_MPIAIJDelta);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJDELTA,    MatCreate_SeqAIJDelta);CHKERRQ(ierr);
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL,MATMPIAIJMKL);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIAIJMKL,      MatCreate_MPIAIJMKL);CHKERRQ(ierr);
@@ -36,6 +36,7 @@ PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
 PetscLogEvent MAT_FactorFactS,MAT_FactorInvS;
+PetscLogEvent MAT_PreallCOO,MAT_SetVCOO;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
 
 const char *const MatFactorTypes[] = {"NONE","LU","CHOLESKY","ILU","ICC","ILUDT","MatFactorType","MAT_FACTOR_",0};
@@ -5265,6 +5266,12 @@ static PetscInt MatAssemblyEnd_InUse = 0;
    out by assembly. If you intend to use that extra space on a subsequent assembly, be sure to insert explicit zeros
    before MAT_FINAL_ASSEMBLY so the space is not compressed out.
 
+   Options Database Keys:
++  -matstash_hash - combine the values set on other processes' entries as they are set, so that each entry is communicated once
+-  -matstash_hash_flush_size <n> - with -matstash_hash and ADD_VALUES, send the values for a process as soon as n entries
+                                   for it are stashed instead of waiting for MatAssemblyBegin(), from the second assembly on
+                                   (0 to disable, default 1024)
+
    Level: beginner
 
 .seealso: MatAssemblyEnd(), MatSetValues(), MatAssembled()
@@ -5521,6 +5528,13 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
    MAT_SORTED_FULL - each process provides exactly its local rows; all column indices for a given row are passed in a
                      single call to MatSetValues(), preallocation is perfect, row oriented, INSERT_VALUES is used. Common
                      with finite difference schemes with non-periodic boundary conditions.
+
+   MAT_LOCALITY_REORDER - for AIJ matrices MatMult() and MatMultAdd() use a copy of the (diagonal block of the) matrix
+                     with rows and columns permuted by reverse Cuthill-McKee, computed at MatAssemblyEnd(); the vectors
+                     are permuted internally. Improves the cache reuse of the input vector for matrices whose rows are
+                     in an unstructured order, at the cost of a second copy of the matrix. Also -mat_locality_reorder in
+                     MatSetFromOptions().
+
    Notes:
     Can only be called after MatSetSizes() and MatSetType() have been set.
 
@@ -9195,6 +9209,10 @@ PetscErrorCode MatFactorFactorizeSchurComplement(Mat F)
 
    For matrix types without special implementation the function fallbacks to MatMatMult() followed by MatTransposeMatMult().
 
+   For MATSEQAIJ matrices -matptap_via hash_threaded forms the product with -mat_omp_num_threads OpenMP threads. The
+   MATMPIAIJ algorithms do not use it, so the products of several MPI processes, such as the Galerkin products of PCGAMG,
+   are not threaded.
+
    Level: intermediate
 
 .seealso: MatMatMult(), MatRARt()
@@ -9360,6 +9378,8 @@ static PetscErrorCode MatProduct_Private(Mat A,Mat B,MatReuse scall,PetscReal fi
 
    In the special case where matrix B (and hence C) are dense you can create the correctly sized matrix C yourself and then call this routine with MAT_REUSE_MATRIX, rather than first having MatMatMult() create it for you. You can NEVER do this if the matrix C is sparse.
 
+   For MATSEQAIJ matrices -matmatmult_via hash_threaded forms the product with -mat_omp_num_threads OpenMP threads; the MATMPIAIJ algorithms do not use it.
+
    Level: intermediate
 
 .seealso: MatTransposeMatMult(), MatMatTransposeMult(), MatPtAP()
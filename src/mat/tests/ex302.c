@@ -0,0 +1,122 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO() against MatSetValues() assembly.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckEqual(Mat A,PetscScalar alpha,Mat B,const char *msg)
+{
+  Mat            C;
+  Vec            x,y,z;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert(A,MATAIJ,MAT_INITIAL_MATRIX,&C);CHKERRQ(ierr);
+  ierr = MatAXPY(C,-alpha,B,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: norm of difference %g\n",msg,(double)norm);CHKERRQ(ierr);}
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+
+  /* derived formats multiply with their own copy of the values, which must have been refreshed */
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-alpha,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: norm of difference of MatMult() %g\n",msg,(double)norm);CHKERRQ(ierr);}
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       M = 10,N,e,a,b,k,n,*coo_i,*coo_j,rows[2];
+  PetscScalar    *coo_v,vals[4];
+  PetscMPIInt    rank,size;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  N    = M*size;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+
+  /* elements are dealt cyclically, so that most of them touch rows owned by other processes;
+     each element adds a 2x2 block plus one entry with a negative index, which must be ignored */
+  for (n=0,e=rank; e<N-1; e+=size) n += 5;
+  ierr = PetscMalloc3(n,&coo_i,n,&coo_j,n,&coo_v);CHKERRQ(ierr);
+  for (k=0,e=rank; e<N-1; e+=size) {
+    rows[0] = e; rows[1] = e+1;
+    for (a=0; a<2; a++) {
+      for (b=0; b<2; b++) {
+        coo_i[k] = rows[a];
+        coo_j[k] = rows[b];
+        coo_v[k] = vals[2*a+b] = (a == b ? 2.0 : -1.0) + 0.01*e;
+        k++;
+      }
+    }
+    coo_i[k] = -1; coo_j[k] = e; coo_v[k] = 100.0; k++;
+    ierr = MatSetValues(B,2,rows,2,rows,vals,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatSetPreallocationCOO(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual(A,1.0,B,"INSERT_VALUES");CHKERRQ(ierr);
+
+  /* reuse the pattern, adding the values a second time */
+  ierr = MatSetValuesCOO(A,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual(A,2.0,B,"ADD_VALUES");CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual(A,1.0,B,"INSERT_VALUES again");CHKERRQ(ierr);
+
+  /* calling the preallocation again must reset the pattern */
+  ierr = MatSetPreallocationCOO(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,NULL,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Zero values: norm %g\n",(double)norm);CHKERRQ(ierr);}
+  ierr = MatView(A,NULL);CHKERRQ(ierr);
+
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -M 3 -mat_type aij
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -M 3 -mat_type aij
+
+   test:
+      suffix: crl_2
+      nsize: 3
+      args: -M 3 -mat_type aijcrl
+
+   test:
+      suffix: baij
+      nsize: 2
+      args: -M 3 -mat_type baij
+
+TEST*/
@@ -0,0 +1,91 @@
+static char help[] = "Tests the inode and threaded MatMult(), MatMultAdd(), MatMultTranspose() and MatMultTransposeAdd() kernels against the plain AIJ ones.\n\n";
+
+#include <petscmat.h>
+
+/* rows come in groups of 1 to 5 with the same nonzero pattern, of varying length, so that all inode sizes and column remainders are exercised */
+static PetscErrorCode FillMatrix(Mat A,PetscInt ngroups,PetscInt N)
+{
+  PetscInt       g,r,k,row = 0,nsz,len,rstart,rend,cols[32];
+  PetscScalar    vals[32];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (g=0; g<ngroups; g++) {
+    nsz = 1 + g%5;
+    len = 1 + (7*g)%23;
+    for (k=0; k<len; k++) cols[k] = (37*g + 7*k)%N;
+    for (r=0; r<nsz; r++,row++) {
+      if (row < rstart || row >= rend) continue;
+      for (k=0; k<len; k++) vals[k] = 1.0 + 0.01*row + 0.001*k;
+      ierr = MatSetValues(A,1,&row,len,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       g,ngroups = 60,N = 0;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-ngroups",&ngroups,NULL);CHKERRQ(ierr);
+  for (g=0; g<ngroups; g++) N += 1 + g%5;
+  while (!(N%7)) {N += 1 + ngroups%5; ngroups++;} /* keeps the 7*k column stride free of repeats */
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,23,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,23,NULL,23,NULL);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(B,"ref_");CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(B,23,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(B,23,NULL,23,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = FillMatrix(A,ngroups,N);CHKERRQ(ierr);
+  ierr = FillMatrix(B,ngroups,N);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultAdd differs\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultTranspose differs\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeAddEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultTransposeAdd differs\n");CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Tested %D rows\n",N);CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -mat_kernel_isa {{generic avx2 avx512}}
+      output_file: output/ex303_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -mat_kernel_isa {{generic avx2 avx512}}
+      output_file: output/ex303_1.out
+
+   test:
+      suffix: omp
+      requires: openmp
+      nsize: {{1 2}}
+      args: -mat_omp_num_threads 3 -mat_no_inode {{0 1}}
+      output_file: output/ex303_1.out
+
+TEST*/
@@ -0,0 +1,104 @@
+static char help[] = "Tests MatMult(), MatMultAdd(), MatSOR() and MatConvert() of MATAIJDELTA against the plain AIJ ones.\n\n";
+
+#include <petscmat.h>
+
+/* the rows span fewer than 256, fewer than 65536 and (with the default N) more columns, so that all offset widths are used */
+static PetscErrorCode FillMatrix(Mat A,PetscInt N)
+{
+  PetscInt       i,rstart,rend,cols[4],far[2];
+  PetscScalar    vals[4] = {4.0,-1.0,-1.0,-0.5};
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  far[0] = 100; far[1] = 3000;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    cols[0] = i; cols[1] = (i+N-1)%N; cols[2] = (i+1)%N;
+    if (i%3 < 2) cols[3] = (i+far[i%3])%N;
+    else cols[3] = i < N/2 ? N-1 : 0;
+    ierr = MatSetValues(A,1,&i,4,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  Vec            x,y,z,w;
+  PetscInt       N = 70000,f;
+  PetscReal      norm,nrm;
+  PetscBool      flg;
+  PetscRandom    rand;
+  MatSORType     flags[] = {SOR_LOCAL_FORWARD_SWEEP,SOR_LOCAL_BACKWARD_SWEEP,SOR_LOCAL_SYMMETRIC_SWEEP,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),(MatSORType)(SOR_LOCAL_BACKWARD_SWEEP | SOR_ZERO_INITIAL_GUESS)};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-N",&N,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,4,NULL,4,NULL,&B);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = FillMatrix(B,N);CHKERRQ(ierr);
+  ierr = MatConvert(B,MATAIJDELTA,MAT_INITIAL_MATRIX,&A);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&w);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(z,rand);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultAdd differs\n");CHKERRQ(ierr);}
+  for (f=0; f<(PetscInt)(sizeof(flags)/sizeof(flags[0])); f++) {
+    ierr = VecCopy(z,y);CHKERRQ(ierr);
+    ierr = VecCopy(z,w);CHKERRQ(ierr);
+    ierr = MatSOR(A,x,1.2,flags[f],0.0,2,1,y);CHKERRQ(ierr);
+    ierr = MatSOR(B,x,1.2,flags[f],0.0,2,1,w);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(w,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    if (norm > PETSC_SMALL*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatSOR sweep %D: norm of difference %g\n",f,(double)norm);CHKERRQ(ierr);}
+  }
+
+  /* the values changed, the nonzero structure did not */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult after MatScale differs\n");CHKERRQ(ierr);}
+
+  ierr = MatConvert(A,MATAIJ,MAT_INITIAL_MATRIX,&C);CHKERRQ(ierr);
+  ierr = MatMultEqual(C,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult after MatConvert differs\n");CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Tested %D rows\n",N);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      output_file: output/ex304_1.out
+
+   test:
+      suffix: omp
+      requires: openmp
+      args: -mat_omp_num_threads 3
+      output_file: output/ex304_1.out
+
+TEST*/
@@ -0,0 +1,163 @@
+static char help[] = "Tests MatMult() and MatMultAdd() of AIJ matrices with MAT_LOCALITY_REORDER or -mat_mpiaij_neighbor_overlap against the plain ones.\n\n";
+
+#include <petscmat.h>
+
+/* 5 point Laplacian on an n x n grid whose points are numbered in a scrambled order so that each process has many
+   neighbors, point p gets number (p*mult)%N; with extra the first row also couples to the last column */
+static PetscErrorCode FillMatrix(Mat A,PetscInt n,PetscInt mult,PetscBool extra,InsertMode mode)
+{
+  PetscInt       N = n*n,p,i,j,k,row,rstart,rend,cols[5];
+  PetscScalar    vals[5];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (p=0; p<N; p++) {
+    row = (p*mult)%N;
+    if (row < rstart || row >= rend) continue;
+    i = p/n; j = p%n; k = 0;
+    cols[k] = row; vals[k++] = 4.0;
+    if (i > 0)   {cols[k] = ((p-n)*mult)%N; vals[k++] = -1.0;}
+    if (i < n-1) {cols[k] = ((p+n)*mult)%N; vals[k++] = -1.0;}
+    if (j > 0)   {cols[k] = ((p-1)*mult)%N; vals[k++] = -1.0 - 0.01*j;}
+    if (j < n-1) {cols[k] = ((p+1)*mult)%N; vals[k++] = -1.0 + 0.01*j;}
+    ierr = MatSetValues(A,1,&row,k,cols,vals,mode);CHKERRQ(ierr);
+  }
+  if (extra && !rstart) {
+    row = 0; cols[0] = N-1; vals[0] = 0.5;
+    ierr = MatSetValues(A,1,&row,1,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckProducts(Mat A,Mat B,Vec x,Vec z,const char *msg)
+{
+  Vec            y,w;
+  PetscReal      norm,nrm;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"MatMult %s differs\n",msg);CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,2,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"MatMultAdd %s differs\n",msg);CHKERRQ(ierr);}
+  /* MatMultAddEqual() never passes the same vector twice */
+  ierr = VecDuplicate(z,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(z,&w);CHKERRQ(ierr);
+  ierr = VecCopy(z,y);CHKERRQ(ierr);
+  ierr = VecCopy(z,w);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,w,w);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(w,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL*nrm) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"in-place MatMultAdd %s: norm of difference %g\n",msg,(double)norm);CHKERRQ(ierr);}
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  Vec            x,z;
+  PetscInt       n = 60,mult = 1031;
+  PetscBool      reorder = PETSC_TRUE;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mult",&mult,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-reorder",&reorder,NULL);CHKERRQ(ierr);
+
+  /* A gets MAT_LOCALITY_REORDER unless -reorder 0 is given and the options with prefix a_, B is the reference */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(A,"a_");CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,6,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,6,NULL,6,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_LOCALITY_REORDER,reorder);CHKERRQ(ierr);
+  ierr = FillMatrix(A,n,mult,PETSC_FALSE,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n,6,NULL,6,NULL,&B);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  /* an explicit MatSetOption() must take precedence over -mat_locality_reorder */
+  ierr = MatSetOption(B,MAT_LOCALITY_REORDER,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = FillMatrix(B,n,mult,PETSC_FALSE,INSERT_VALUES);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(z,rand);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,x,z,"after assembly");CHKERRQ(ierr);
+
+  /* new values, same nonzero structure */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,x,z,"after MatScale");CHKERRQ(ierr);
+  ierr = FillMatrix(A,n,mult,PETSC_FALSE,ADD_VALUES);CHKERRQ(ierr);
+  ierr = FillMatrix(B,n,mult,PETSC_FALSE,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,x,z,"after MatSetValues");CHKERRQ(ierr);
+  if (reorder) {
+    /* the nonzero structure did not change, the ordering is kept */
+    ierr = MatSetOption(A,MAT_LOCALITY_REORDER,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = CheckProducts(A,B,x,z,"after setting the option again");CHKERRQ(ierr);
+  }
+
+  /* a new off-process nonzero changes the ordering and the neighbors */
+  ierr = FillMatrix(A,n,mult,PETSC_TRUE,ADD_VALUES);CHKERRQ(ierr);
+  ierr = FillMatrix(B,n,mult,PETSC_TRUE,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,x,z,"after new nonzero");CHKERRQ(ierr);
+
+  /* the option set on an assembled matrix */
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = MatSetOption(C,MAT_LOCALITY_REORDER,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = CheckProducts(C,B,x,z,"option set after assembly");CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = CheckProducts(C,B,x,z,"after MatDuplicate");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Tested %D rows\n",n*n);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      output_file: output/ex305_1.out
+
+   test:
+      suffix: omp
+      requires: openmp
+      args: -a_mat_omp_num_threads 2
+      output_file: output/ex305_1.out
+
+   test:
+      suffix: info
+      # the ordering is computed for A after assembly and after the new nonzero, for C when the option is set after assembly and for the duplicate of A, never for B
+      filter: grep -e "Reverse Cuthill-McKee" -e Tested
+      args: -info :mat -mat_locality_reorder
+
+   test:
+      suffix: neighbor
+      nsize: {{2 5}}
+      args: -n 40 -reorder 0 -a_mat_mpiaij_neighbor_overlap
+      output_file: output/ex305_neighbor.out
+
+TEST*/
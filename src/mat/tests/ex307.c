@@ -0,0 +1,125 @@
+static char help[] = "Tests repeated assemblies of parallel matrices with many off-process values, as with -matstash_hash.\n\n";
+
+#include <petscmat.h>
+
+/*
+   1d linear elements on the nodes 0..N-1, element e couples the nodes e and e+1. The elements are handed out
+   cyclically so most of the values go to other processes, and every element is added twice with half its weight.
+   The result is the 1d Laplacian times scale, with bs equal blocks.
+*/
+static PetscErrorCode AssembleLaplacian(Mat A,PetscInt N,PetscInt bs,PetscScalar scale)
+{
+  PetscInt       e,k,i,j,l,idx[2];
+  PetscScalar    *vals;
+  PetscMPIInt    rank,size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  ierr = PetscMalloc1(4*bs*bs,&vals);CHKERRQ(ierr);
+  for (i=0; i<2*bs; i++) {
+    for (j=0; j<2*bs; j++) {
+      if (i%bs != j%bs) vals[i*2*bs+j] = 0.0;
+      else vals[i*2*bs+j] = (i/bs == j/bs ? 0.5 : -0.5)*scale;
+    }
+  }
+  for (k=0; k<2; k++) {
+    for (e=rank; e<N-1; e+=size) {
+      idx[0] = e; idx[1] = e+1;
+      if (bs == 1) {
+        ierr = MatSetValues(A,2,idx,2,idx,vals,ADD_VALUES);CHKERRQ(ierr);
+      } else {
+        ierr = MatSetValuesBlocked(A,2,idx,2,idx,vals,ADD_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  /* INSERT_VALUES of the same values on the diagonal of the first and last rows, several times */
+  for (l=0; l<3; l++) {
+    for (i=0; i<bs; i++) {
+      PetscInt    r;
+      PetscScalar v = scale;
+
+      r    = i;
+      ierr = MatSetValues(A,1,&r,1,&r,&v,INSERT_VALUES);CHKERRQ(ierr);
+      r    = (N-1)*bs+i;
+      ierr = MatSetValues(A,1,&r,1,&r,&v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckLaplacian(Mat A,PetscInt N,PetscInt bs,PetscScalar scale,PetscInt it)
+{
+  PetscInt          row,rstart,rend,ncols,k,node,nerr = 0,gerr;
+  const PetscInt    *cols;
+  const PetscScalar *vals;
+  PetscScalar       expect;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    node = row/bs;
+    ierr = MatGetRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+    for (k=0; k<ncols; k++) {
+      if (cols[k] == row)                              expect = (node == 0 || node == N-1) ? scale : 2.0*scale;
+      else if (cols[k] == row-bs || cols[k] == row+bs) expect = -scale;
+      else                                             expect = 0.0;
+      if (PetscAbsScalar(vals[k] - expect) > PETSC_SMALL) nerr++;
+    }
+    ierr = MatRestoreRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&nerr,&gerr,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)A));CHKERRQ(ierr);
+  if (gerr) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"Assembly %D: %D wrong entries\n",it,gerr);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  PetscInt       N = 1000,bs = 1,it,nit = 3;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nit",&nit,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N*bs,N*bs);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatXAIJSetPreallocation(A,bs,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  /* the first assembly finds the owners, the following ones may send values ahead */
+  for (it=0; it<nit; it++) {
+    if (it) {ierr = MatZeroEntries(A);CHKERRQ(ierr);}
+    ierr = AssembleLaplacian(A,N,bs,(PetscScalar)(it+1));CHKERRQ(ierr);
+    ierr = CheckLaplacian(A,N,bs,(PetscScalar)(it+1),it);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Tested %D assemblies\n",nit);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 3
+      args: -mat_type {{aij baij}} -bs {{1 2}}
+      output_file: output/ex307_1.out
+
+   test:
+      suffix: hash
+      nsize: 3
+      args: -matstash_hash -matstash_hash_flush_size {{0 16}} -mat_type {{aij baij}} -bs {{1 2}}
+      output_file: output/ex307_1.out
+
+TEST*/
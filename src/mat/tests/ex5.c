@@ -286,4 +286,15 @@ int main(int argc,char **args)
       args: -mat_type sell -test_diagonalscale
       output_file: output/ex5_53.out
 
+   test:
+      suffix: sell_5
+      args: -mat_type sell -mat_kernel_isa {{generic avx avx2 avx512}}
+      output_file: output/ex5_41.out
+
+   test:
+      suffix: sell_6
+      nsize: 3
+      args: -mat_type sell -mat_kernel_isa {{generic avx avx2 avx512}}
+      output_file: output/ex5_43.out
+
 TEST*/
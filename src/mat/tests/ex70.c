@@ -806,4 +806,10 @@ int main(int argc,char **args)
     nsize: 1
     args: -M 13 -N 13 -K {{1 3}} -local {{0 1}} -A_mat_type dense -testnest -testcircular
 
+  test:
+    output_file: output/ex70_1.out
+    suffix: 8
+    nsize: {{1 2}}
+    args: -M 23 -N 17 -K {{16 29}} -local {{0 1}} -testmatmatt 0
+
 TEST*/
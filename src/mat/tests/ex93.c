@@ -199,6 +199,11 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via btheap -matmattransmult_via color
       output_file: output/ex93_1.out
 
+   test:
+      suffix: hash_threaded
+      args: -matmatmult_via hash_threaded -matptap_via hash_threaded -mat_omp_num_threads {{1 2}}
+      output_file: output/ex93_1.out
+
    test:
       suffix: heap
       args: -matmatmult_via heap
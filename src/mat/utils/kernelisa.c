@@ -0,0 +1,68 @@
+
+#include <petsc/private/matimpl.h>
+
+const char *const MatKernelISAs[] = {"generic","avx","avx2","avx512","MatKernelISA","MAT_KERNEL_ISA_",0};
+
+static PetscBool    MatKernelISADetected = PETSC_FALSE;
+static MatKernelISA MatKernelISAHost     = MAT_KERNEL_ISA_GENERIC;
+
+/*
+   Determines the best instruction set, among those kernels are compiled for, that the processor we run on supports
+*/
+static PetscErrorCode MatKernelISADetect_Private(void)
+{
+  PetscFunctionBegin;
+  if (MatKernelISADetected) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_ATTRIBUTE_TARGET) && defined(MAT_KERNEL_HAVE_AVX)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) MatKernelISAHost = MAT_KERNEL_ISA_AVX512;
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) MatKernelISAHost = MAT_KERNEL_ISA_AVX2;
+  else if (__builtin_cpu_supports("avx")) MatKernelISAHost = MAT_KERNEL_ISA_AVX;
+#elif defined(MAT_KERNEL_HAVE_AVX512)
+  MatKernelISAHost = MAT_KERNEL_ISA_AVX512;
+#elif defined(MAT_KERNEL_HAVE_AVX2)
+  MatKernelISAHost = MAT_KERNEL_ISA_AVX2;
+#elif defined(MAT_KERNEL_HAVE_AVX)
+  MatKernelISAHost = MAT_KERNEL_ISA_AVX;
+#endif
+  MatKernelISADetected = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatGetKernelISA_Private - Returns the instruction set whose hand vectorized kernels should be used for a matrix
+
+   Not Collective
+
+   Input Parameter:
+.  A - the matrix
+
+   Output Parameter:
+.  isa - the instruction set
+
+   Options Database Key:
+.  -mat_kernel_isa <generic,avx,avx2,avx512> - use the kernels for this instruction set (or the best supported one below it)
+
+   Notes:
+   By default the best instruction set supported by the processor is used. Matrix implementations call this when they
+   set up their operations, so the choice can differ between matrices with different options prefixes.
+
+   Level: developer
+*/
+PetscErrorCode MatGetKernelISA_Private(Mat A,MatKernelISA *isa)
+{
+  MatKernelISA   req;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatKernelISADetect_Private();CHKERRQ(ierr);
+  req  = MatKernelISAHost;
+  ierr = PetscOptionsGetEnum(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_kernel_isa",MatKernelISAs,(PetscEnum*)&req,&flg);CHKERRQ(ierr);
+  if (req > MatKernelISAHost) {
+    ierr = PetscInfo2(A,"Kernels for %s requested but not supported on this processor, using %s\n",MatKernelISAs[req],MatKernelISAs[MatKernelISAHost]);CHKERRQ(ierr);
+    req  = MatKernelISAHost;
+  }
+  *isa = req;
+  PetscFunctionReturn(0);
+}
@@ -1,7 +1,9 @@
 
 #include <petsc/private/matimpl.h>
+#include <petsc/private/hashmapij.h>
 
 #define DEFAULT_STASH_SIZE   10000
+#define DEFAULT_FLUSH_SIZE   1024
 
 static PetscErrorCode MatStashScatterBegin_Ref(Mat,MatStash*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatStashScatterGetMesg_Ref(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
@@ -10,6 +12,9 @@ PETSC_INTERN PetscErrorCode MatStashScatterEnd_Ref(MatStash*);
 static PetscErrorCode MatStashScatterBegin_BTS(Mat,MatStash*,PetscInt*);
 static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
 static PetscErrorCode MatStashScatterEnd_BTS(MatStash*);
+static PetscErrorCode MatStashHashValues_Private(MatStash*,PetscInt,PetscInt,const PetscInt[],const PetscScalar[],PetscInt,PetscBool);
+static PetscErrorCode MatStashHashValuesBlocked_Private(MatStash*,PetscInt,PetscInt,const PetscInt[],const PetscScalar[],PetscInt,PetscInt,PetscInt,PetscBool);
+static PetscErrorCode MatStashHashDestroy_Private(MatStash*);
 #endif
 
 /*
@@ -18,6 +23,8 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash*);
   to be stored on other processors are kept until matrix assembly is done.
 
   This is a simple minded stash. Simply adds entries to end of stash.
+  With -matstash_hash the entries for the same (row,col) are instead combined
+  as they are inserted, see MatStashHashValues_Private().
 
   Input Parameters:
   comm - communicator, required for scatters.
@@ -78,6 +85,8 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->nprocessed  = 0;
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
+  stash->hashed      = PETSC_FALSE;
+  stash->hash        = NULL;
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_reproduce",&stash->reproduce,NULL);CHKERRQ(ierr);
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -88,6 +97,7 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
     stash->ScatterGetMesg = MatStashScatterGetMesg_BTS;
     stash->ScatterEnd     = MatStashScatterEnd_BTS;
     stash->ScatterDestroy = MatStashScatterDestroy_BTS;
+    ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_hash",&stash->hashed,NULL);CHKERRQ(ierr);
   } else {
 #endif
     stash->ScatterBegin   = MatStashScatterBegin_Ref;
@@ -110,6 +120,9 @@ PetscErrorCode MatStashDestroy_Private(MatStash *stash)
   PetscFunctionBegin;
   ierr = PetscMatStashSpaceDestroy(&stash->space_head);CHKERRQ(ierr);
   if (stash->ScatterDestroy) {ierr = (*stash->ScatterDestroy)(stash);CHKERRQ(ierr);}
+#if !defined(PETSC_HAVE_MPIUNI)
+  ierr = MatStashHashDestroy_Private(stash);CHKERRQ(ierr);
+#endif
 
   stash->space = 0;
 
@@ -270,6 +283,12 @@ PetscErrorCode MatStashValuesRow_Private(MatStash *stash,PetscInt row,PetscInt n
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->hashed) {
+    ierr = MatStashHashValues_Private(stash,row,n,idxn,values,1,ignorezeroentries);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
@@ -311,6 +330,12 @@ PetscErrorCode MatStashValuesCol_Private(MatStash *stash,PetscInt row,PetscInt n
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->hashed) {
+    ierr = MatStashHashValues_Private(stash,row,n,idxn,values,stepval,ignorezeroentries);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   /* Check and see if we have sufficient memory */
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
@@ -358,6 +383,12 @@ PetscErrorCode MatStashValuesRowBlocked_Private(MatStash *stash,PetscInt row,Pet
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->hashed) {
+    ierr = MatStashHashValuesBlocked_Private(stash,row,n,idxn,values,rmax,cmax,idx,PETSC_TRUE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
   }
@@ -412,6 +443,12 @@ PetscErrorCode MatStashValuesColBlocked_Private(MatStash *stash,PetscInt row,Pet
   PetscMatStashSpace space=stash->space;
 
   PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPIUNI)
+  if (stash->hashed) {
+    ierr = MatStashHashValuesBlocked_Private(stash,row,n,idxn,values,rmax,cmax,idx,PETSC_FALSE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (!space || space->local_remaining < n) {
     ierr = MatStashExpand_Private(stash,n);CHKERRQ(ierr);
   }
@@ -804,6 +841,326 @@ static PetscErrorCode MatStashBlockTypeSetUp(MatStash *stash)
   PetscFunctionReturn(0);
 }
 
+/*
+   The hashed stash, -matstash_hash, keeps the blocks in MatStashBlock form in one bucket per destination rank (a single
+   bucket until the ownership ranges are known, that is during the first assembly) and a hash table from (row,col) to
+   the position of the block in its bucket, so that repeated insertions into the same entry are combined at once. The
+   buckets keep their size from one assembly to the next.
+
+   With ADD_VALUES a bucket holding -matstash_hash_flush_size blocks is sent right away, the entries are removed from
+   the hash table and later insertions into them start new blocks. MatStashScatterBegin_BTS() tells each receiver how
+   many of these early messages to expect, they are received after the regular ones by MatStashRecvFlushed_Private().
+*/
+struct _MatStashHash {
+  PetscHMapIJ ht;
+  PetscInt    nbuckets;
+  char        **bucket;
+  PetscInt    *n,*nmax;        /* number of blocks in each bucket and its capacity */
+  PetscInt    *owners;         /* ownership ranges in stash rows, saved at the first assembly */
+  PetscInt    *nflushed;       /* number of early messages sent to each rank in this assembly */
+  PetscInt    threshold;
+  PetscInt    nreqs,maxreqs;
+  MPI_Request *reqs;
+  char        **bufs;          /* send buffers of the early messages */
+  PetscScalar *work;           /* one block, for the blocked insertions */
+};
+
+static PetscErrorCode MatStashHashCreate_Private(MatStash *stash)
+{
+  MatStashHash   h;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatStashBlockTypeSetUp(stash);CHKERRQ(ierr);
+  ierr = PetscNew(&h);CHKERRQ(ierr);
+  ierr = PetscHMapIJCreate(&h->ht);CHKERRQ(ierr);
+  h->nbuckets  = 1;
+  ierr = PetscCalloc3(1,&h->bucket,1,&h->n,1,&h->nmax);CHKERRQ(ierr);
+  h->threshold = DEFAULT_FLUSH_SIZE;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-matstash_hash_flush_size",&h->threshold,NULL);CHKERRQ(ierr);
+  if (h->threshold <= 0) h->threshold = PETSC_MAX_INT;
+  ierr = PetscMalloc1(stash->bs*stash->bs,&h->work);CHKERRQ(ierr);
+  stash->hash = h;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatStashHashDestroy_Private(MatStash *stash)
+{
+  MatStashHash   h = stash->hash;
+  PetscInt       b;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!h) PetscFunctionReturn(0);
+  if (h->nreqs) {ierr = MPI_Waitall(h->nreqs,h->reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  for (b=0; b<h->nreqs; b++) {ierr = PetscFree(h->bufs[b]);CHKERRQ(ierr);}
+  for (b=0; b<h->nbuckets; b++) {ierr = PetscFree(h->bucket[b]);CHKERRQ(ierr);}
+  ierr = PetscFree3(h->bucket,h->n,h->nmax);CHKERRQ(ierr);
+  ierr = PetscFree2(h->owners,h->nflushed);CHKERRQ(ierr);
+  ierr = PetscFree(h->reqs);CHKERRQ(ierr);
+  ierr = PetscFree(h->bufs);CHKERRQ(ierr);
+  ierr = PetscFree(h->work);CHKERRQ(ierr);
+  ierr = PetscHMapIJDestroy(&h->ht);CHKERRQ(ierr);
+  ierr = PetscFree(stash->hash);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatStashHashExpand_Private(MatStash *stash,PetscInt b)
+{
+  MatStashHash   h = stash->hash;
+  PetscInt       nmax;
+  char           *bucket;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (h->nmax[b])         nmax = 2*h->nmax[b];
+  else if (h->owners)     nmax = 64;
+  else if (stash->umax)   nmax = PetscMax(stash->umax/(stash->bs*stash->bs),64);
+  else                    nmax = PetscMax(stash->oldnmax/(stash->bs*stash->bs),64);
+  ierr = PetscMalloc(nmax*stash->blocktype_size,&bucket);CHKERRQ(ierr);
+  ierr = PetscMemcpy(bucket,h->bucket[b],h->n[b]*stash->blocktype_size);CHKERRQ(ierr);
+  ierr = PetscFree(h->bucket[b]);CHKERRQ(ierr);
+  h->bucket[b] = bucket;
+  h->nmax[b]   = nmax;
+  stash->reallocs++;
+  PetscFunctionReturn(0);
+}
+
+/* sends the blocks of bucket b to rank b ahead of the assembly */
+static PetscErrorCode MatStashHashFlush_Private(MatStash *stash,PetscInt b)
+{
+  MatStashHash   h = stash->hash;
+  PetscInt       i;
+  PetscMPIInt    count,rank;
+  PetscHashIJKey key;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatStashBlockTypeSetUp(stash);CHKERRQ(ierr);
+  if (h->nreqs == h->maxreqs) {
+    h->maxreqs = PetscMax(2*h->maxreqs,16);
+    ierr = PetscRealloc(h->maxreqs*sizeof(MPI_Request),&h->reqs);CHKERRQ(ierr);
+    ierr = PetscRealloc(h->maxreqs*sizeof(char*),&h->bufs);CHKERRQ(ierr);
+  }
+  for (i=0; i<h->n[b]; i++) {
+    MatStashBlock *block = (MatStashBlock*)&h->bucket[b][i*stash->blocktype_size];
+
+    key.i = block->row;
+    key.j = block->col;
+    ierr  = PetscHMapIJDel(h->ht,key);CHKERRQ(ierr);
+  }
+  ierr = PetscMPIIntCast(h->n[b],&count);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(b,&rank);CHKERRQ(ierr);
+  ierr = MPI_Isend(h->bucket[b],count,stash->blocktype,rank,stash->tag1,stash->comm,&h->reqs[h->nreqs]);CHKERRQ(ierr);
+  h->bufs[h->nreqs++] = h->bucket[b];
+  ierr = PetscMalloc(h->nmax[b]*stash->blocktype_size,&h->bucket[b]);CHKERRQ(ierr);
+  h->n[b] = 0;
+  h->nflushed[b]++;
+  PetscFunctionReturn(0);
+}
+
+/* adds or inserts, according to the insert mode of the matrix, the block vals of bs2 values into the entry (row,col) */
+static PetscErrorCode MatStashHashInsert_Private(MatStash *stash,PetscInt row,PetscInt col,const PetscScalar vals[])
+{
+  MatStashHash   h = stash->hash;
+  PetscInt       bs2 = stash->bs*stash->bs,b = 0,pos,l;
+  PetscBool      add = (PetscBool)(stash->insertmode && *stash->insertmode == ADD_VALUES),missing;
+  PetscHashIJKey key;
+  PetscHashIter  it;
+  MatStashBlock  *block;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (h->owners) {
+    ierr = PetscFindInt(row,stash->size+1,h->owners,&b);CHKERRQ(ierr);
+    if (b < 0) b = -(b+2);
+  }
+  key.i = row;
+  key.j = col;
+  ierr  = PetscHMapIJPut(h->ht,key,&it,&missing);CHKERRQ(ierr);
+  if (!missing) {
+    ierr  = PetscHMapIJIterGet(h->ht,it,&pos);CHKERRQ(ierr);
+    block = (MatStashBlock*)&h->bucket[b][pos*stash->blocktype_size];
+    if (add) {
+      for (l=0; l<bs2; l++) block->vals[l] += vals[l];
+    } else {
+      ierr = PetscArraycpy(block->vals,vals,bs2);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+  if (h->n[b] == h->nmax[b]) {ierr = MatStashHashExpand_Private(stash,b);CHKERRQ(ierr);}
+  pos   = h->n[b]++;
+  ierr  = PetscHMapIJIterSet(h->ht,it,pos);CHKERRQ(ierr);
+  block = (MatStashBlock*)&h->bucket[b][pos*stash->blocktype_size];
+  block->row = row;
+  block->col = col;
+  ierr = PetscArraycpy(block->vals,vals,bs2);CHKERRQ(ierr);
+  stash->n++;
+  /* the receivers learn about early messages from the headers, which are not exchanged when reusing the communication */
+  if (add && h->owners && !stash->first_assembly_done && h->n[b] >= h->threshold) {
+    ierr = MatStashHashFlush_Private(stash,b);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatStashHashValues_Private(MatStash *stash,PetscInt row,PetscInt n,const PetscInt idxn[],const PetscScalar values[],PetscInt stepval,PetscBool ignorezeroentries)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!stash->hash) {ierr = MatStashHashCreate_Private(stash);CHKERRQ(ierr);}
+  for (i=0; i<n; i++) {
+    if (ignorezeroentries && (values[i*stepval] == 0.0)) continue;
+    ierr = MatStashHashInsert_Private(stash,row,idxn[i],&values[i*stepval]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the blocks are stored column oriented, as in MatStashValuesRowBlocked_Private() and MatStashValuesColBlocked_Private() */
+static PetscErrorCode MatStashHashValuesBlocked_Private(MatStash *stash,PetscInt row,PetscInt n,const PetscInt idxn[],const PetscScalar values[],PetscInt rmax,PetscInt cmax,PetscInt idx,PetscBool roworiented)
+{
+  PetscInt          i,j,k,bs = stash->bs,bs2 = bs*bs;
+  const PetscScalar *vals;
+  PetscScalar       *array;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!stash->hash) {ierr = MatStashHashCreate_Private(stash);CHKERRQ(ierr);}
+  for (i=0; i<n; i++) {
+    array = stash->hash->work;
+    vals  = values + idx*bs2*n + bs*i;
+    for (j=0; j<bs; j++) {
+      if (roworiented) {
+        for (k=0; k<bs; k++) array[k*bs] = vals[k];
+        array++;
+        vals += cmax*bs;
+      } else {
+        for (k=0; k<bs; k++) array[k] = vals[k];
+        array += bs;
+        vals  += rmax*bs;
+      }
+    }
+    ierr = MatStashHashInsert_Private(stash,row,idxn[i],stash->hash->work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* moves the blocks, sorted by row and column, into the send buffer and empties the buckets */
+static PetscErrorCode MatStashHashCompress_Private(MatStash *stash,const PetscInt owners[])
+{
+  MatStashHash   h;
+  PetscInt       b,i,k,n,rowstart,*row,*col,*perm;
+  char           **blocks;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!stash->hash) {ierr = MatStashHashCreate_Private(stash);CHKERRQ(ierr);}
+  h = stash->hash;
+  for (b=0,n=0; b<h->nbuckets; b++) n += h->n[b];
+  ierr = PetscMalloc4(n,&row,n,&col,n,&blocks,n,&perm);CHKERRQ(ierr);
+  for (b=0,k=0; b<h->nbuckets; b++) {
+    for (i=0; i<h->n[b]; i++,k++) {
+      MatStashBlock *block = (MatStashBlock*)&h->bucket[b][i*stash->blocktype_size];
+
+      row[k]    = block->row;
+      col[k]    = block->col;
+      blocks[k] = (char*)block;
+      perm[k]   = k;
+    }
+    h->n[b] = 0;
+  }
+  ierr = PetscSortIntWithArrayPair(n,row,col,perm);CHKERRQ(ierr);
+  for (rowstart=0,i=1; i<=n; i++) {
+    if (i == n || row[i] != row[rowstart]) {
+      ierr = PetscSortIntWithArray(i-rowstart,&col[rowstart],&perm[rowstart]);CHKERRQ(ierr);
+      rowstart = i;
+    }
+  }
+  for (k=0; k<n; k++) {
+    char *block;
+
+    ierr = PetscSegBufferGet(stash->segsendblocks,1,&block);CHKERRQ(ierr);
+    ierr = PetscMemcpy(block,blocks[perm[k]],stash->blocktype_size);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(row,col,blocks,perm);CHKERRQ(ierr);
+  ierr = PetscHMapIJClear(h->ht);CHKERRQ(ierr);
+
+  if (!h->owners) { /* from now on the blocks are kept by destination */
+    ierr = PetscFree(h->bucket[0]);CHKERRQ(ierr);
+    ierr = PetscFree3(h->bucket,h->n,h->nmax);CHKERRQ(ierr);
+    h->nbuckets = stash->size;
+    ierr = PetscCalloc3(h->nbuckets,&h->bucket,h->nbuckets,&h->n,h->nbuckets,&h->nmax);CHKERRQ(ierr);
+    ierr = PetscMalloc2(stash->size+1,&h->owners,stash->size,&h->nflushed);CHKERRQ(ierr);
+    ierr = PetscArraycpy(h->owners,owners,stash->size+1);CHKERRQ(ierr);
+    ierr = PetscArrayzero(h->nflushed,stash->size);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* sets up the sends to the ranks that get values in this message or got early messages */
+static PetscErrorCode MatStashHashSetUpSends_Private(MatStash *stash,const PetscInt owners[],size_t nblocks,char *sendblocks)
+{
+  MatStashHash   h = stash->hash;
+  PetscInt       r,k,*cnt;
+  size_t         i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(stash->size,&cnt);CHKERRQ(ierr);
+  for (i=0; i<nblocks; i++) {
+    MatStashBlock *block = (MatStashBlock*)&sendblocks[i*stash->blocktype_size];
+
+    ierr = PetscFindInt(block->row,stash->size+1,owners,&r);CHKERRQ(ierr);
+    if (r < 0) r = -(r+2);
+    cnt[r]++;
+  }
+  for (r=0,stash->nsendranks=0; r<stash->size; r++) if (cnt[r] || h->nflushed[r]) stash->nsendranks++;
+  ierr = PetscMalloc3(stash->nsendranks,&stash->sendranks,stash->nsendranks,&stash->sendhdr,stash->nsendranks,&stash->sendframes);CHKERRQ(ierr);
+  for (r=0,k=0,i=0; r<stash->size; r++) {
+    if (!cnt[r] && !h->nflushed[r]) continue;
+    stash->sendranks[k]          = r;
+    stash->sendframes[k].buffer  = &sendblocks[i*stash->blocktype_size];
+    stash->sendframes[k].pending = 0;
+    stash->sendhdr[k].count      = cnt[r];
+    stash->sendhdr[k].nflushed   = h->nflushed[r];
+    i += cnt[r];
+    k++;
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* receives the next early message sent by a hashed stash, recvframe_active is NULL if there are none left */
+static PetscErrorCode MatStashRecvFlushed_Private(MatStash *stash)
+{
+  MPI_Status     status;
+  PetscMPIInt    count,source;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  stash->recvframe_active = NULL;
+  if (stash->use_status) PetscFunctionReturn(0); /* The headers were not exchanged, and no early messages sent */
+  while (stash->flushrecv_i < stash->nrecvranks && stash->flushrecv_n == stash->recvhdr[stash->flushrecv_i].nflushed) {
+    stash->flushrecv_i++;
+    stash->flushrecv_n = 0;
+  }
+  if (stash->flushrecv_i == stash->nrecvranks) PetscFunctionReturn(0);
+  source = stash->recvranks[stash->flushrecv_i];
+  ierr   = MPI_Probe(source,stash->tag1,stash->comm,&status);CHKERRQ(ierr);
+  ierr   = MPI_Get_count(&status,stash->blocktype,&count);CHKERRQ(ierr);
+  ierr   = PetscSegBufferGet(stash->segrecvblocks,count,&stash->flushframe.buffer);CHKERRQ(ierr);
+  ierr   = MPI_Recv(stash->flushframe.buffer,count,stash->blocktype,source,stash->tag1,stash->comm,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  if (PetscUnlikely(*stash->insertmode == NOT_SET_VALUES)) *stash->insertmode = ADD_VALUES;
+  if (PetscUnlikely(*stash->insertmode == INSERT_VALUES)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Assembling INSERT_VALUES, but rank %d requested ADD_VALUES",source);
+  stash->flushframe.count = count;
+  stash->flushrecv_n++;
+  stash->recvframe_active = &stash->flushframe;
+  stash->recvframe_count  = count;
+  stash->recvframe_i      = 0;
+  PetscFunctionReturn(0);
+}
+
 /* Callback invoked after target rank has initiatied receive of rendezvous message.
  * Here we post the main sends.
  */
@@ -857,7 +1214,11 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   }
 
   ierr = MatStashBlockTypeSetUp(stash);CHKERRQ(ierr);
-  ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
+  if (stash->hashed) {
+    ierr = MatStashHashCompress_Private(stash,owners);CHKERRQ(ierr);
+  } else {
+    ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
+  }
   ierr = PetscSegBufferGetSize(stash->segsendblocks,&nblocks);CHKERRQ(ierr);
   ierr = PetscSegBufferExtractInPlace(stash->segsendblocks,&sendblocks);CHKERRQ(ierr);
   if (stash->first_assembly_done) { /* Set up sendhdrs and sendframes for each rank that we sent before */
@@ -874,6 +1235,8 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
         stash->sendhdr[i].count++;
       }
     }
+  } else if (stash->hashed) {
+    ierr = MatStashHashSetUpSends_Private(stash,owners,nblocks,sendblocks);CHKERRQ(ierr);
   } else {                      /* Dynamically count and pack (first time) */
     PetscInt sendno;
     size_t i,rowstart;
@@ -909,6 +1272,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
       stash->sendframes[sendno].buffer = sendblock_rowstart;
       stash->sendframes[sendno].pending = 0;
       stash->sendhdr[sendno].count = i - rowstart;
+      stash->sendhdr[sendno].nflushed = 0;
       sendno++;
       rowstart = i;
     }
@@ -936,7 +1300,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     }
     stash->use_status = PETSC_TRUE; /* Use count from message status. */
   } else {
-    ierr = PetscCommBuildTwoSidedFReq(stash->comm,1,MPIU_INT,stash->nsendranks,stash->sendranks,(PetscInt*)stash->sendhdr,
+    ierr = PetscCommBuildTwoSidedFReq(stash->comm,2,MPIU_INT,stash->nsendranks,stash->sendranks,(PetscInt*)stash->sendhdr,
                                       &stash->nrecvranks,&stash->recvranks,(PetscInt*)&stash->recvhdr,1,&stash->sendreqs,&stash->recvreqs,
                                       MatStashBTSSend_Private,MatStashBTSRecv_Private,stash);CHKERRQ(ierr);
     ierr = PetscMalloc2(stash->nrecvranks,&stash->some_indices,stash->nrecvranks,&stash->some_statuses);CHKERRQ(ierr);
@@ -949,6 +1313,8 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   stash->some_i               = 0;
   stash->some_count           = 0;
   stash->recvcount            = 0;
+  stash->flushrecv_i          = 0;
+  stash->flushrecv_n          = 0;
   stash->first_assembly_done  = mat->assembly_subset; /* See the same logic in VecAssemblyBegin_MPI_BTS */
   stash->insertmode           = &mat->insertmode;
   PetscFunctionReturn(0);
@@ -963,7 +1329,11 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
   *flg = 0;
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
-      if (stash->recvcount == stash->nrecvranks) PetscFunctionReturn(0); /* Done */
+      if (stash->recvcount == stash->nrecvranks) { /* Then the messages sent ahead by hashed stashes */
+        ierr = MatStashRecvFlushed_Private(stash);CHKERRQ(ierr);
+        if (!stash->recvframe_active) PetscFunctionReturn(0); /* Done */
+        continue;
+      }
       ierr = MPI_Waitsome(stash->nrecvranks,stash->recvreqs,&stash->some_count,stash->some_indices,stash->use_status?stash->some_statuses:MPI_STATUSES_IGNORE);CHKERRQ(ierr);
       stash->some_i = 0;
     }
@@ -999,6 +1369,16 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 
   PetscFunctionBegin;
   ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  if (stash->hash && stash->hash->nreqs) {
+    MatStashHash h = stash->hash;
+    PetscInt     i;
+
+    ierr = PetscInfo1(NULL,"%D messages were sent ahead of the assembly\n",h->nreqs);CHKERRQ(ierr);
+    ierr = MPI_Waitall(h->nreqs,h->reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    for (i=0; i<h->nreqs; i++) {ierr = PetscFree(h->bufs[i]);CHKERRQ(ierr);}
+    ierr = PetscArrayzero(h->nflushed,stash->size);CHKERRQ(ierr);
+    h->nreqs = 0;
+  }
   if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
     void *dummy;
     ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
@@ -716,6 +716,13 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       output_file: output/ex19_2.out
       requires: !single
 
+   test:
+      suffix: 2_aijsingle
+      nsize: 4
+      args: -da_refine 3 -snes_converged_reason -pc_type mg -mat_fd_type ds -dm_mat_type aijsingle
+      output_file: output/ex19_2.out
+      requires: !single
+
    test:
       suffix: 3
       nsize: 4
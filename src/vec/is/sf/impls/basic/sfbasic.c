@@ -2,6 +2,94 @@
 #include <../src/vec/is/sf/impls/basic/sfbasic.h>
 #include <../src/vec/is/sf/impls/basic/sfpack.h>
 
+/*
+   PetscSFSetUpShm_Basic - Finds the neighbor ranks on the same node, with which data is exchanged through MPI shared
+   memory windows instead of MPI messages
+
+   Notes:
+   Each link allocates a window on the node holding its remote root buffer followed by its remote leaf buffer. A sender
+   packs into its window and sends a zero-byte message (through the persistent requests of the link) to say the data is
+   ready; the receiver copies its segment straight from the sender's window and replies with a zero-byte message, which
+   the sender waits for before it overwrites the window in a later operation on the link. Here we compute, for each
+   neighbor on the node, where in its window the segment for this rank starts.
+
+   Since the windows are allocated and freed collectively on the node, all processes must perform the SF operations
+   (on any rootdata/leafdata) in the same order.
+*/
+static PetscErrorCode PetscSFSetUpShm_Basic(PetscSF sf)
+{
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscErrorCode ierr;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscShmComm   pshmcomm;
+  MPI_Comm       comm;
+  PetscMPIInt    shmsize,tag[2],n,nshm = 0,anyshm;
+  PetscInt       i,*sbuf;
+  MPI_Request    *reqs;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_CUDA)
+  if (sf->use_gpu_aware_mpi) { /* Device data would be passed to MPI directly */
+    ierr = PetscInfo(sf,"Shared memory windows are not used with GPU aware MPI\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&bas->shmcomm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(bas->shmcomm,&shmsize);CHKERRQ(ierr);
+  if (shmsize == 1) PetscFunctionReturn(0);
+
+  ierr = PetscMalloc4(bas->niranks,&bas->ishmranks,bas->niranks,&bas->ishmoffset,sf->nranks,&bas->rshmranks,sf->nranks,&bas->rshmoffset);CHKERRQ(ierr);
+  for (i=0; i<bas->niranks; i++) {
+    bas->ishmranks[i] = MPI_PROC_NULL;
+    if (i >= bas->ndiranks) {ierr = PetscShmCommGlobalToLocal(pshmcomm,bas->iranks[i],&bas->ishmranks[i]);CHKERRQ(ierr);}
+    if (bas->ishmranks[i] != MPI_PROC_NULL) nshm++;
+  }
+  for (i=0; i<sf->nranks; i++) {
+    bas->rshmranks[i] = MPI_PROC_NULL;
+    if (i >= sf->ndranks) {ierr = PetscShmCommGlobalToLocal(pshmcomm,sf->ranks[i],&bas->rshmranks[i]);CHKERRQ(ierr);}
+    if (bas->rshmranks[i] != MPI_PROC_NULL) nshm++;
+  }
+  /* Windows are allocated collectively on the node, so either all or none of its processes use them */
+  ierr = MPIU_Allreduce(&nshm,&anyshm,1,MPI_INT,MPI_MAX,bas->shmcomm);CHKERRQ(ierr);
+  if (!anyshm) {
+    ierr = PetscFree4(bas->ishmranks,bas->ishmoffset,bas->rshmranks,bas->rshmoffset);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* Roots tell leaves where their segment starts in the root buffer, which comes first in the window; leaves tell roots
+     where theirs starts in the leaf buffer, which follows the root buffer */
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&tag[0]);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&tag[1]);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nshm,&sbuf,2*nshm,&reqs);CHKERRQ(ierr);
+  for (i=0,n=0; i<bas->niranks; i++) {
+    if (bas->ishmranks[i] == MPI_PROC_NULL) continue;
+    sbuf[n] = bas->ioffset[i] - bas->ioffset[bas->ndiranks];
+    ierr = MPI_Irecv(&bas->ishmoffset[i],1,MPIU_INT,bas->iranks[i],tag[1],comm,&reqs[2*n]);CHKERRQ(ierr);
+    ierr = MPI_Isend(&sbuf[n],1,MPIU_INT,bas->iranks[i],tag[0],comm,&reqs[2*n+1]);CHKERRQ(ierr);
+    n++;
+  }
+  for (i=0; i<sf->nranks; i++) {
+    if (bas->rshmranks[i] == MPI_PROC_NULL) continue;
+    sbuf[n] = bas->rootbuflen[PETSCSF_REMOTE] + sf->roffset[i] - sf->roffset[sf->ndranks];
+    ierr = MPI_Irecv(&bas->rshmoffset[i],1,MPIU_INT,sf->ranks[i],tag[0],comm,&reqs[2*n]);CHKERRQ(ierr);
+    ierr = MPI_Isend(&sbuf[n],1,MPIU_INT,sf->ranks[i],tag[1],comm,&reqs[2*n+1]);CHKERRQ(ierr);
+    n++;
+  }
+  ierr = MPI_Waitall(2*n,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr = PetscFree2(sbuf,reqs);CHKERRQ(ierr);
+  bas->shm = PETSC_TRUE;
+  ierr = PetscInfo3(sf,"Exchanging data with %d of %D neighbor ranks through shared memory windows on a node of %d processes\n",nshm,(PetscInt)(bas->niranks-bas->ndiranks+sf->nranks-sf->ndranks),shmsize);CHKERRQ(ierr);
+#else
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscInfo(sf,"Shared memory windows need MPI-3 shared memory support, exchanging all data with MPI messages\n");CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
 /*===================================================================================*/
 /*              SF public interface implementations                                  */
 /*===================================================================================*/
@@ -85,6 +173,7 @@ PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
 
   /* Setup fields related to packing */
   ierr = PetscSFSetUpPackFields(sf);CHKERRQ(ierr);
+  if (bas->useshm) {ierr = PetscSFSetUpShm_Basic(sf);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -105,6 +194,20 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 #endif
   ierr = PetscSFLinkDestroy(sf,&bas->avail);CHKERRQ(ierr);
   ierr = PetscSFResetPackFields(sf);CHKERRQ(ierr);
+  ierr = PetscFree4(bas->ishmranks,bas->ishmoffset,bas->rshmranks,bas->rshmoffset);CHKERRQ(ierr);
+  bas->shm = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Basic options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_use_shared_memory","Exchange data with processes on the same node through MPI shared memory windows","PetscSFSetFromOptions",bas->useshm,&bas->useshm,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -385,6 +488,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->Reset                = PetscSFReset_Basic;
   sf->ops->Destroy              = PetscSFDestroy_Basic;
   sf->ops->View                 = PetscSFView_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
   sf->ops->BcastAndOpBegin      = PetscSFBcastAndOpBegin_Basic;
   sf->ops->BcastAndOpEnd        = PetscSFBcastAndOpEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
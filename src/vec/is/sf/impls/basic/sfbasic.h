@@ -20,6 +20,14 @@ typedef struct _n_PetscSFLink* PetscSFLink;
   PetscSFPackOpt   rootpackopt_d[2];/* Copy of rootpackopt[] on device if needed */                                                \
   PetscBool        rootdups[2];     /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */            \
   PetscInt         nrootreqs;       /* Number of MPI reqests */                                                                    \
+  PetscBool        useshm;          /* Exchange data with ranks on the same node through MPI shared memory windows */              \
+  PetscBool        shm;             /* Is the shared memory path used? If so, it is on all ranks of the node */                    \
+  MPI_Comm         shmcomm;         /* Shared memory communicator of the node, owned by the PetscShmComm of the SF's comm */       \
+  PetscMPIInt      *ishmranks;      /* [niranks] Ranks of iranks[] in shmcomm, MPI_PROC_NULL for ranks on other nodes */          \
+  PetscInt         *ishmoffset;     /* [niranks] Offset (in unit) in the window of iranks[i] of the leaves it packed for me */     \
+  PetscMPIInt      *rshmranks;      /* [nranks] Ranks of sf->ranks[] in shmcomm, MPI_PROC_NULL for ranks on other nodes */        \
+  PetscInt         *rshmoffset;     /* [nranks] Offset (in unit) in the window of sf->ranks[i] of the roots it packed for me */    \
+  PetscInt         nshmwins;        /* Number of windows created by links. They are freed collectively in creation order */        \
   PetscSFLink      avail;           /* One or more entries per MPI Datatype, lazily constructed */                                 \
   PetscSFLink      inuse            /* Buffers being used for transactions that have not yet completed */
 
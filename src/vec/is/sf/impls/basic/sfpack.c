@@ -469,6 +469,85 @@ PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype
 }
 #endif
 
+/* Allocate the shared window of a new link, which holds its remote root and leaf buffers on host, and find the segments
+   for this rank in the windows of the neighbors on the node. Collective on the node.
+ */
+static PetscErrorCode PetscSFLinkSetUpShm(PetscSF sf,PetscSFLink link)
+{
+  PetscErrorCode ierr;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscInt       i;
+  MPI_Aint       size;
+  PetscMPIInt    dispunit;
+  char           *base;
+
+  PetscFunctionBegin;
+  size = (MPI_Aint)((bas->rootbuflen[PETSCSF_REMOTE]+sf->leafbuflen[PETSCSF_REMOTE])*link->unitbytes);
+  ierr = MPI_Win_allocate_shared(size,1,MPI_INFO_NULL,bas->shmcomm,&base,&link->shmwin);CHKERRQ(ierr);
+  ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,link->shmwin);CHKERRQ(ierr);
+  link->shmseq = bas->nshmwins++;
+  link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = base;
+  link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = base + bas->rootbuflen[PETSCSF_REMOTE]*link->unitbytes;
+
+  ierr = PetscMalloc3(bas->niranks,&link->ishmbuf,sf->nranks,&link->rshmbuf,2*(bas->niranks+sf->nranks),&link->shmreqs);CHKERRQ(ierr);
+  for (i=0; i<bas->niranks; i++) {
+    link->ishmbuf[i] = NULL;
+    if (bas->ishmranks[i] == MPI_PROC_NULL) continue;
+    ierr = MPI_Win_shared_query(link->shmwin,bas->ishmranks[i],&size,&dispunit,&base);CHKERRQ(ierr);
+    link->ishmbuf[i] = base + bas->ishmoffset[i]*link->unitbytes;
+  }
+  for (i=0; i<sf->nranks; i++) {
+    link->rshmbuf[i] = NULL;
+    if (bas->rshmranks[i] == MPI_PROC_NULL) continue;
+    ierr = MPI_Win_shared_query(link->shmwin,bas->rshmranks[i],&size,&dispunit,&base);CHKERRQ(ierr);
+    link->rshmbuf[i] = base + bas->rshmoffset[i]*link->unitbytes;
+  }
+  link->nshmreqs = 0;
+  ierr = PetscCommGetNewTag(PetscObjectComm((PetscObject)sf),&link->shmtag);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Called after the MPI requests of the link completed in the given direction, i.e., all senders on the node have packed
+   their data: copy the segments for this rank from their windows to the receive buffer and acknowledge, then post the
+   receives of the acknowledgements from the ranks reading from this rank's window.
+ */
+PetscErrorCode PetscSFLinkShmReceive(PetscSF sf,PetscSFLink link,PetscSFDirection direction)
+{
+  PetscErrorCode ierr;
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  MPI_Comm       comm = PetscObjectComm((PetscObject)sf);
+  size_t         ub = link->unitbytes;
+  PetscInt       i;
+  char           *buf;
+
+  PetscFunctionBegin;
+  ierr = MPI_Win_sync(link->shmwin);CHKERRQ(ierr);
+  if (direction == PETSCSF_ROOT2LEAF) {
+    buf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+    for (i=sf->ndranks; i<sf->nranks; i++) {
+      if (!link->rshmbuf[i]) continue;
+      ierr = PetscMemcpy(buf+(sf->roffset[i]-sf->roffset[sf->ndranks])*ub,link->rshmbuf[i],(sf->roffset[i+1]-sf->roffset[i])*ub);CHKERRQ(ierr);
+      ierr = MPI_Isend(NULL,0,MPI_BYTE,sf->ranks[i],link->shmtag,comm,&link->shmreqs[link->nshmreqs++]);CHKERRQ(ierr);
+    }
+    for (i=bas->ndiranks; i<bas->niranks; i++) {
+      if (!link->ishmbuf[i]) continue;
+      ierr = MPI_Irecv(NULL,0,MPI_BYTE,bas->iranks[i],link->shmtag,comm,&link->shmreqs[link->nshmreqs++]);CHKERRQ(ierr);
+    }
+  } else {
+    buf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+    for (i=bas->ndiranks; i<bas->niranks; i++) {
+      if (!link->ishmbuf[i]) continue;
+      ierr = PetscMemcpy(buf+(bas->ioffset[i]-bas->ioffset[bas->ndiranks])*ub,link->ishmbuf[i],(bas->ioffset[i+1]-bas->ioffset[i])*ub);CHKERRQ(ierr);
+      ierr = MPI_Isend(NULL,0,MPI_BYTE,bas->iranks[i],link->shmtag,comm,&link->shmreqs[link->nshmreqs++]);CHKERRQ(ierr);
+    }
+    for (i=sf->ndranks; i<sf->nranks; i++) {
+      if (!link->rshmbuf[i]) continue;
+      ierr = MPI_Irecv(NULL,0,MPI_BYTE,sf->ranks[i],link->shmtag,comm,&link->shmreqs[link->nshmreqs++]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
    The routine Creates a communication link for the given operation. It first looks up its link cache. If
    there is a free & suitable one, it uses it. Otherwise it creates a new one.
@@ -513,6 +592,8 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
       leafdirect[i] = PETSC_FALSE; /* We also force allocating a separate leafbuf so that leafdata and leafupdate can share mpi requests */
     }
   }
+  /* With shared memory, remote data always goes through the buffers in the window, which neighbors on the node read */
+  if (bas->shm) rootdirect[PETSCSF_REMOTE] = leafdirect[PETSCSF_REMOTE] = PETSC_FALSE;
 
   if (sf->use_gpu_aware_mpi) {
     rootmtype_mpi = rootmtype;
@@ -553,6 +634,7 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
   ierr = PetscNew(&link);CHKERRQ(ierr);
   ierr = PetscSFLinkSetUp_Host(sf,link,unit);CHKERRQ(ierr);
   ierr = PetscCommGetNewTag(PetscObjectComm((PetscObject)sf),&link->tag);CHKERRQ(ierr); /* One tag per link */
+  if (bas->shm) {ierr = PetscSFLinkSetUpShm(sf,link);CHKERRQ(ierr);}
 
   nreqs = (nrootreqs+nleafreqs)*8;
   ierr  = PetscMalloc1(nreqs,&link->reqs);CHKERRQ(ierr);
@@ -568,6 +650,11 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
   }
 
 found:
+  /* Neighbors on the node may still be reading the window from the previous operation on this link */
+  if (link->nshmreqs) {
+    ierr = MPI_Waitall(link->nshmreqs,link->shmreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    link->nshmreqs = 0;
+  }
   if ((rootmtype == PETSC_MEMTYPE_DEVICE || leafmtype == PETSC_MEMTYPE_DEVICE) && !link->deviceinited) {ierr = PetscSFLinkSetUp_Device(sf,link,unit);CHKERRQ(ierr);}
 
   /* Allocate buffers along root/leafdata */
@@ -577,7 +664,7 @@ found:
     if (bas->rootbuflen[i]) {
       if (rootdirect[i]) { /* Aha, we disguise rootdata as rootbuf */
         link->rootbuf[i][rootmtype] = (char*)rootdata + bas->rootstart[i]*link->unitbytes;
-      } else { /* Have to have a separate rootbuf */
+      } else if (!(bas->shm && i == PETSCSF_REMOTE && rootmtype == PETSC_MEMTYPE_HOST)) { /* Have to have a separate rootbuf, unless it is in the window */
         if (!link->rootbuf_alloc[i][rootmtype]) {
           ierr = PetscMallocWithMemType(rootmtype,bas->rootbuflen[i]*link->unitbytes,(void**)&link->rootbuf_alloc[i][rootmtype]);CHKERRQ(ierr);
         }
@@ -588,7 +675,7 @@ found:
     if (sf->leafbuflen[i]) {
       if (leafdirect[i]) {
         link->leafbuf[i][leafmtype] = (char*)leafdata + sf->leafstart[i]*link->unitbytes;
-      } else {
+      } else if (!(bas->shm && i == PETSCSF_REMOTE && leafmtype == PETSC_MEMTYPE_HOST)) {
         if (!link->leafbuf_alloc[i][leafmtype]) {
           ierr = PetscMallocWithMemType(leafmtype,sf->leafbuflen[i]*link->unitbytes,(void**)&link->leafbuf_alloc[i][leafmtype]);CHKERRQ(ierr);
         }
@@ -598,13 +685,13 @@ found:
   }
 
   /* Allocate buffers on host for buffering data on device in cast not use_gpu_aware_mpi */
-  if (rootmtype == PETSC_MEMTYPE_DEVICE && rootmtype_mpi == PETSC_MEMTYPE_HOST) {
+  if (rootmtype == PETSC_MEMTYPE_DEVICE && rootmtype_mpi == PETSC_MEMTYPE_HOST && !bas->shm) {
     if(!link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]) {
       ierr = PetscMalloc(bas->rootbuflen[PETSCSF_REMOTE]*link->unitbytes,&link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]);CHKERRQ(ierr);
     }
     link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = link->rootbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
   }
-  if (leafmtype == PETSC_MEMTYPE_DEVICE && leafmtype_mpi == PETSC_MEMTYPE_HOST) {
+  if (leafmtype == PETSC_MEMTYPE_DEVICE && leafmtype_mpi == PETSC_MEMTYPE_HOST && !bas->shm) {
     if (!link->leafbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]) {
       ierr = PetscMalloc(sf->leafbuflen[PETSCSF_REMOTE]*link->unitbytes,&link->leafbuf_alloc[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]);CHKERRQ(ierr);
     }
@@ -661,12 +748,14 @@ PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf,PetscSFLink link,P
         for (i=ndrootranks,j=0; i<nrootranks; i++,j++) {
           disp = (rootoffset[i] - rootoffset[ndrootranks])*link->unitbytes;
           ierr = PetscMPIIntCast(rootoffset[i+1]-rootoffset[i],&n);CHKERRQ(ierr);
+          if (bas->shm && bas->ishmranks[i] != MPI_PROC_NULL) n = 0; /* Only a notification, the data goes through the window */
           ierr = MPI_Recv_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi]+disp,n,unit,bas->iranks[i],link->tag,comm,link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi]+j);CHKERRQ(ierr);
         }
       } else { /* PETSCSF_ROOT2LEAF */
         for (i=ndrootranks,j=0; i<nrootranks; i++,j++) {
           disp = (rootoffset[i] - rootoffset[ndrootranks])*link->unitbytes;
           ierr = PetscMPIIntCast(rootoffset[i+1]-rootoffset[i],&n);CHKERRQ(ierr);
+          if (bas->shm && bas->ishmranks[i] != MPI_PROC_NULL) n = 0; /* Only a notification, the data goes through the window */
           ierr = MPI_Send_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi]+disp,n,unit,bas->iranks[i],link->tag,comm,link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi]+j);CHKERRQ(ierr);
         }
       }
@@ -679,12 +768,14 @@ PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf,PetscSFLink link,P
         for (i=ndleafranks,j=0; i<nleafranks; i++,j++) {
           disp = (leafoffset[i] - leafoffset[ndleafranks])*link->unitbytes;
           ierr = PetscMPIIntCast(leafoffset[i+1]-leafoffset[i],&n);CHKERRQ(ierr);
+          if (bas->shm && bas->rshmranks[i] != MPI_PROC_NULL) n = 0;
           ierr = MPI_Send_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi]+disp,n,unit,sf->ranks[i],link->tag,comm,link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi]+j);CHKERRQ(ierr);
         }
       } else { /* PETSCSF_ROOT2LEAF */
         for (i=ndleafranks,j=0; i<nleafranks; i++,j++) {
           disp = (leafoffset[i] - leafoffset[ndleafranks])*link->unitbytes;
           ierr = PetscMPIIntCast(leafoffset[i+1]-leafoffset[i],&n);CHKERRQ(ierr);
+          if (bas->shm && bas->rshmranks[i] != MPI_PROC_NULL) n = 0;
           ierr = MPI_Recv_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi]+disp,n,unit,sf->ranks[i],link->tag,comm,link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi]+j);CHKERRQ(ierr);
         }
       }
@@ -744,10 +835,17 @@ PetscErrorCode PetscSFLinkDestroy(PetscSF sf,PetscSFLink *avail)
   PetscSFLink       link = *avail,next;
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   PetscInt          i,nreqs = (bas->nrootreqs+sf->nleafreqs)*8;
+  MPI_Win           *wins = NULL;
 
   PetscFunctionBegin;
+  if (bas->shm) {ierr = PetscMalloc1(bas->nshmwins,&wins);CHKERRQ(ierr);}
   for (; link; link=next) {
     next = link->next;
+    if (bas->shm) {
+      ierr = MPI_Waitall(link->nshmreqs,link->shmreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+      ierr = PetscFree3(link->ishmbuf,link->rshmbuf,link->shmreqs);CHKERRQ(ierr);
+      wins[link->shmseq] = link->shmwin;
+    }
     if (!link->isbuiltin) {ierr = MPI_Type_free(&link->unit);CHKERRQ(ierr);}
     for (i=0; i<nreqs; i++) { /* Persistent reqs must be freed. */
       if (link->reqs[i] != MPI_REQUEST_NULL) {ierr = MPI_Request_free(&link->reqs[i]);CHKERRQ(ierr);}
@@ -765,6 +863,14 @@ PetscErrorCode PetscSFLinkDestroy(PetscSF sf,PetscSFLink *avail)
     ierr = PetscFree(link);CHKERRQ(ierr);
   }
   *avail = NULL;
+  if (bas->shm) { /* MPI_Win_free() is collective, so free the windows in the same order on all processes */
+    for (i=0; i<bas->nshmwins; i++) {
+      ierr = MPI_Win_unlock_all(wins[i]);CHKERRQ(ierr);
+      ierr = MPI_Win_free(&wins[i]);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(wins);CHKERRQ(ierr);
+    bas->nshmwins = 0;
+  }
   PetscFunctionReturn(0);
 }
 
@@ -1316,6 +1422,7 @@ PetscErrorCode PetscSFLinkPackRootData(PetscSF sf,PetscSFLink link,PetscSFScope
   if (scope == PETSCSF_REMOTE) {
     ierr = PetscSFLinkCopyRootBufferInCaseNotUseGpuAwareMPI(sf,link,PETSC_TRUE/*device2host*/);CHKERRQ(ierr);
     ierr = PetscSFLinkSyncStreamAfterPackRootData(sf,link);CHKERRQ(ierr);
+    if (bas->shm) {ierr = MPI_Win_sync(link->shmwin);CHKERRQ(ierr);}
   }
   ierr = PetscLogEventEnd(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1325,6 +1432,7 @@ PetscErrorCode PetscSFLinkPackRootData(PetscSF sf,PetscSFLink link,PetscSFScope
 PetscErrorCode PetscSFLinkPackLeafData(PetscSF sf,PetscSFLink link,PetscSFScope scope,const void *leafdata)
 {
   PetscErrorCode   ierr;
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   const PetscInt   *leafindices = NULL;
   PetscInt         count,start;
   PetscErrorCode   (*Pack)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,const void*,void*) = NULL;
@@ -1342,6 +1450,7 @@ PetscErrorCode PetscSFLinkPackLeafData(PetscSF sf,PetscSFLink link,PetscSFScope
   if (scope == PETSCSF_REMOTE) {
     ierr = PetscSFLinkCopyLeafBufferInCaseNotUseGpuAwareMPI(sf,link,PETSC_TRUE/*device2host*/);CHKERRQ(ierr);
     ierr = PetscSFLinkSyncStreamAfterPackLeafData(sf,link);CHKERRQ(ierr);
+    if (bas->shm) {ierr = MPI_Win_sync(link->shmwin);CHKERRQ(ierr);}
   }
   ierr = PetscLogEventEnd(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1429,6 +1538,7 @@ PetscErrorCode PetscSFLinkFetchRootData(PetscSF sf,PetscSFLink link,PetscSFScope
   if (scope == PETSCSF_REMOTE) {
     ierr = PetscSFLinkCopyRootBufferInCaseNotUseGpuAwareMPI(sf,link,PETSC_TRUE);CHKERRQ(ierr);
     ierr = PetscSFLinkSyncStreamAfterUnpackRootData(sf,link);CHKERRQ(ierr);
+    if (bas->shm) {ierr = MPI_Win_sync(link->shmwin);CHKERRQ(ierr);}
   }
   ierr = PetscSFLinkLogFlopsAfterUnpackRootData(sf,link,scope,op);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(PETSCSF_Unpack,sf,0,0,0);CHKERRQ(ierr);
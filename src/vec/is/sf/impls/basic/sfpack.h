@@ -160,6 +160,14 @@ struct _n_PetscSFLink {
   PetscBool    rootreqsinited[2][2][2];      /* Are root requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][rootdirect_mpi]*/
   PetscBool    leafreqsinited[2][2][2];      /* Are leaf requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi]*/
   MPI_Request  *reqs;                        /* An array of length (nrootreqs+nleafreqs)*8. Pointers in rootreqs[][][] and leafreqs[][][] point here */
+
+  /* For exchanging data with ranks on the same node (only used when the SF's shm is true). See PetscSFSetUpShm_Basic() */
+  MPI_Win      shmwin;                       /* Window on the node holding rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] and leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] */
+  PetscInt     shmseq;                       /* Creation order of shmwin among the windows of the SF */
+  PetscMPIInt  shmtag;                       /* Tag of the acknowledgements */
+  char         **ishmbuf,**rshmbuf;          /* [niranks], [nranks] Segments for me in the windows of iranks[] and sf->ranks[] on the node, NULL if not on the node */
+  MPI_Request  *shmreqs;                     /* [2*(niranks+nranks)] Pending acknowledgements, sent or to be received */
+  PetscMPIInt  nshmreqs;
   PetscSFLink  next;
 };
 
@@ -192,6 +200,7 @@ PETSC_INTERN PetscErrorCode PetscSFLinkGetFetchAndOp (PetscSFLink,PetscMemType,M
 PETSC_INTERN PetscErrorCode PetscSFLinkGetScatterAndOp(PetscSFLink,PetscMemType,MPI_Op,PetscBool,PetscErrorCode (**ScatterAndOp)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,const void*,PetscInt,PetscSFPackOpt,const PetscInt*,void*));
 PETSC_INTERN PetscErrorCode PetscSFLinkGetFetchAndOpLocal(PetscSFLink,PetscMemType,MPI_Op,PetscBool,PetscErrorCode (**FetchAndOpLocal)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,void*,PetscInt,PetscSFPackOpt,const PetscInt*,const void*,void*));
 PETSC_INTERN PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF,PetscSFLink,PetscSFDirection,void**,void**,MPI_Request**,MPI_Request**);
+PETSC_INTERN PetscErrorCode PetscSFLinkShmReceive(PetscSF,PetscSFLink,PetscSFDirection);
 
 /* Do Pack/Unpack/Fetch/Scatter with the link */
 PETSC_INTERN PetscErrorCode PetscSFLinkPackRootData  (PetscSF,PetscSFLink,PetscSFScope,const void*);
@@ -321,6 +330,7 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFLinkMPIWaitall(PetscSF sf,PetscSFLink
   PetscFunctionBegin;
   ierr = MPI_Waitall(bas->nrootreqs,link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi],MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = MPI_Waitall(sf->nleafreqs, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi],MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  if (bas->shm) {ierr = PetscSFLinkShmReceive(sf,link,direction);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
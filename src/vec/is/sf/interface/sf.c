@@ -267,6 +267,8 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
    Options Database Keys:
 +  -sf_type               - implementation type, see PetscSFSetType()
 .  -sf_rank_order         - sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise
+.  -sf_use_shared_memory  - with -sf_type basic, exchange data with processes on the same node through MPI-3 shared memory windows
+                            instead of MPI messages (default: false). All processes must then perform the SF operations in the same order.
 .  -sf_use_default_stream - Assume callers of SF computed the input root/leafdata with the default cuda stream. SF will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between SF and its caller (default: true).
                             If true, this option only works with -use_cuda_aware_mpi 1.
@@ -9,6 +9,7 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Allgather(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFCreate_Gatherv(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFCreate_Gather(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFCreate_Alltoall(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hierarchical(PetscSF);
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF);
 #endif
@@ -41,6 +42,7 @@ PetscErrorCode  PetscSFRegisterAll(void)
   ierr = PetscSFRegister(PETSCSFGATHERV,   PetscSFCreate_Gatherv);CHKERRQ(ierr);
   ierr = PetscSFRegister(PETSCSFGATHER,    PetscSFCreate_Gather);CHKERRQ(ierr);
   ierr = PetscSFRegister(PETSCSFALLTOALL,  PetscSFCreate_Alltoall);CHKERRQ(ierr);
+  ierr = PetscSFRegister(PETSCSFHIERARCHICAL,PetscSFCreate_Hierarchical);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
   ierr = PetscSFRegister(PETSCSFNEIGHBOR,  PetscSFCreate_Neighbor);CHKERRQ(ierr);
 #endif
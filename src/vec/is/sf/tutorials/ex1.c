@@ -599,4 +599,30 @@ int main(int argc,char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_hierarchical
+      nsize: 4
+      args: -sf_type hierarchical -sf_hierarchical_node_size {{1 2 3}separate output} -test_all -test_fetchandop 0
+
+   # the graph arrays of the inner PetscSFs are freed one by one, which coalesced mallocs do not allow for PetscMalloc2() pairs
+   test:
+      suffix: 10_hierarchical_coalesce
+      output_file: output/ex1_10_hierarchical_sf_hierarchical_node_size-2.out
+      nsize: 4
+      args: -sf_type hierarchical -sf_hierarchical_node_size 2 -malloc_coalesce 1 -test_all -test_fetchandop 0
+
+   test:
+      suffix: 10_basic_shm
+      output_file: output/ex1_10_basic.out
+      nsize: 4
+      args: -sf_type basic -sf_use_shared_memory -test_all -test_bcastop 0 -test_fetchandop 0
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: bcastop_basic_shm
+      output_file: output/ex1_bcastop_basic.out
+      nsize: 4
+      args: -sf_type basic -sf_use_shared_memory -test_bcastop
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
 TEST*/
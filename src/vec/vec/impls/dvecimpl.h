@@ -15,11 +15,26 @@ typedef struct {
   VECHEADER
 } Vec_Seq;
 
+/*
+   Storage of vectors created together by VecDuplicateVecs() as the columns of one dense matrix with leading
+   dimension ld, shared through a PetscContainer composed with each of them as "VecMultiVec"
+*/
+typedef struct {
+  PetscScalar *array;
+  PetscInt    ld,m;
+} VecMultiVec;
+
+PETSC_INTERN PetscErrorCode VecMultiVecCreate_Private(Vec,PetscInt,PetscContainer*,VecMultiVec**);
+
 PETSC_INTERN PetscErrorCode VecMDot_Seq(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecMTDot_Seq(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecMin_Seq(Vec,PetscInt*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecSet_Seq(Vec,PetscScalar);
 PETSC_INTERN PetscErrorCode VecMAXPY_Seq(Vec,PetscInt,const PetscScalar*,Vec*);
+PETSC_INTERN PetscErrorCode VecMAXPYNorm_Seq(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecMAXPYNorm_Seq_Private(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecAXPYDotNorm_Seq(Vec,PetscScalar,Vec,Vec,PetscScalar*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecAXPYDotNorm_Seq_Private(Vec,PetscScalar,Vec,Vec,PetscScalar*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecAYPX_Seq(Vec,PetscScalar,Vec);
 PETSC_INTERN PetscErrorCode VecWAXPY_Seq(Vec,PetscScalar,Vec,Vec);
 PETSC_INTERN PetscErrorCode VecAXPBYPCZ_Seq(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
@@ -53,5 +68,6 @@ PETSC_INTERN PetscErrorCode VecPointwiseDivide_Seq(Vec,Vec,Vec);
 
 PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec);
 PETSC_INTERN PetscErrorCode VecCreate_Seq_Private(Vec,const PetscScalar[]);
+PETSC_INTERN PetscErrorCode VecSetReproducible_Private(Vec);
 
 #endif
@@ -0,0 +1,133 @@
+/*
+   Parallel vectors whose local operations use OpenMP threads, see vecthreaded.c
+*/
+
+#include <../src/vec/vec/impls/mpi/pvecimpl.h>   /*I  "petscvec.h"   I*/
+#include <../src/vec/vec/impls/seq/seqthreaded/threadedvecimpl.h>
+
+static PetscErrorCode VecDot_MPIThreaded(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscScalar    sum,work;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDot_SeqThreaded(xin,yin,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  *z   = sum;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecTDot_MPIThreaded(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscScalar    sum,work;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecTDot_SeqThreaded(xin,yin,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  *z   = sum;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMDot_MPIThreaded(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
+{
+  PetscScalar    awork[128],*work = awork;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc1(nv,&work);CHKERRQ(ierr);
+  }
+  ierr = VecMDot_SeqThreaded(xin,nv,y,work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecNorm_MPIThreaded(Vec xin,NormType type,PetscReal *z)
+{
+  PetscReal      work[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (((Vec_MPI*)xin->data)->omp_nthreads < 2) {
+    ierr = VecNorm_MPI(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecNormLocal_SeqThreaded_Private(xin,type,work);CHKERRQ(ierr);
+  if (type == NORM_INFINITY) {
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  } else if (type == NORM_1_AND_2) {
+    ierr = MPIU_Allreduce(work,z,2,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    z[1] = PetscSqrtReal(z[1]);
+  } else {
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    if (type != NORM_1) z[0] = PetscSqrtReal(z[0]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDuplicate_MPIThreaded(Vec win,Vec *v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate(PetscObjectComm((PetscObject)win),v);CHKERRQ(ierr);
+  ierr = PetscLayoutReference(win->map,&(*v)->map);CHKERRQ(ierr);
+  ierr = VecSetType(*v,VECMPITHREADED);CHKERRQ(ierr);
+  ierr = PetscMemcpy((*v)->ops,win->ops,sizeof(struct _VecOps));CHKERRQ(ierr);
+
+  /* New vector should inherit stashing property of parent */
+  (*v)->stash.donotstash   = win->stash.donotstash;
+  (*v)->stash.ignorenegidx = win->stash.ignorenegidx;
+
+  ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)(*v))->olist);CHKERRQ(ierr);
+  ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)(*v))->qlist);CHKERRQ(ierr);
+
+  (*v)->map->bs   = PetscAbs(win->map->bs);
+  (*v)->bstash.bs = win->bstash.bs;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECMPITHREADED - VECMPITHREADED = "mpithreaded" - A parallel vector whose local operations use OpenMP threads
+
+   Options Database Keys:
++  -vec_type mpithreaded - sets the vector type to VECMPITHREADED during a call to VecSetFromOptions()
+-  -vec_omp_num_threads <n> - number of threads, by default 1
+
+   Notes:
+   The local part is split between the threads as for VECSEQTHREADED. Ghosted vectors are not supported.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECTHREADED, VECSEQTHREADED, VECMPI
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_MPIThreaded(Vec v)
+{
+  Vec_MPI        *s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate_MPI_Private(v,PETSC_FALSE,0,NULL);CHKERRQ(ierr);
+  s    = (Vec_MPI*)v->data;
+  ierr = PetscMalloc1(v->map->n,&s->array);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)v,v->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  s->array_allocated = s->array;
+
+  ierr = VecSetUpOpenMP_Private(v);CHKERRQ(ierr);
+  ierr = VecSetOpsOpenMP_Private(v);CHKERRQ(ierr);
+  v->ops->duplicate = VecDuplicate_MPIThreaded;
+  v->ops->dot       = VecDot_MPIThreaded;
+  v->ops->tdot      = VecTDot_MPIThreaded;
+  v->ops->mdot      = VecMDot_MPIThreaded;
+  v->ops->norm      = VecNorm_MPIThreaded;
+  ierr = VecSetReproducible_Private(v);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)v,VECMPITHREADED);CHKERRQ(ierr);
+  /* the first touch of the entries is by the threads that use them */
+  ierr = VecSet(v,0.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -182,6 +182,8 @@ PETSC_EXTERN PetscErrorCode VecCreate_MPIViennaCL(Vec vv)
   ierr = PetscObjectChangeTypeName((PetscObject)vv,VECMPIVIENNACL);CHKERRQ(ierr);
 
   vv->ops->dotnorm2        = VecDotNorm2_MPIViennaCL;
+  vv->ops->axpydotnorm     = NULL;
+  vv->ops->maxpynorm       = NULL;
   vv->ops->waxpy           = VecWAXPY_SeqViennaCL;
   vv->ops->duplicate       = VecDuplicate_MPIViennaCL;
   vv->ops->dot             = VecDot_MPIViennaCL;
@@ -80,12 +80,56 @@ static PetscErrorCode VecDuplicate_MPI(Vec win,Vec *v)
 
   ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)(*v))->olist);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)(*v))->qlist);CHKERRQ(ierr);
+  /* the storage of a VecDuplicateVecs() block is not shared by the duplicate and must not be kept alive by it */
+  ierr = PetscObjectCompose((PetscObject)*v,"VecMultiVec",NULL);CHKERRQ(ierr);
 
   (*v)->map->bs   = PetscAbs(win->map->bs);
   (*v)->bstash.bs = win->bstash.bs;
   PetscFunctionReturn(0);
 }
 
+/*
+   With -vec_duplicatevecs_contiguous the local parts of the new vectors are the columns of a VecMultiVec, which lets
+   VecMDot_MPI() and VecMAXPY_Seq() use BLAS gemv on runs of them. Not done for ghosted vectors.
+*/
+static PetscErrorCode VecDuplicateVecs_MPI(Vec win,PetscInt m,Vec *V[])
+{
+  PetscErrorCode ierr;
+  Vec_MPI        *w = (Vec_MPI*)win->data;
+  PetscBool      contiguous = PETSC_FALSE,ismpi;
+  PetscInt       i;
+  VecMultiVec    *mv;
+  PetscContainer container;
+  Vec            v;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)win,VECMPI,&ismpi);CHKERRQ(ierr);
+  if (ismpi && !w->nghost && !w->localrep) {ierr = PetscOptionsGetBool(((PetscObject)win)->options,((PetscObject)win)->prefix,"-vec_duplicatevecs_contiguous",&contiguous,NULL);CHKERRQ(ierr);}
+  if (!contiguous || m < 2) {
+    ierr = VecDuplicateVecs_Default(win,m,V);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecMultiVecCreate_Private(win,m,&container,&mv);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m,V);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    ierr = VecCreate(PetscObjectComm((PetscObject)win),&v);CHKERRQ(ierr);
+    ierr = PetscLayoutReference(win->map,&v->map);CHKERRQ(ierr);
+    ierr = VecCreate_MPI_Private(v,PETSC_FALSE,0,mv->array+i*mv->ld);CHKERRQ(ierr);
+    ierr = PetscMemcpy(v->ops,win->ops,sizeof(struct _VecOps));CHKERRQ(ierr);
+    ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)v)->olist);CHKERRQ(ierr);
+    ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)v)->qlist);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)v,"VecMultiVec",(PetscObject)container);CHKERRQ(ierr);
+    v->stash.donotstash   = win->stash.donotstash;
+    v->stash.ignorenegidx = win->stash.ignorenegidx;
+    v->map->bs            = PetscAbs(win->map->bs);
+    v->bstash.bs          = win->bstash.bs;
+    (*V)[i] = v;
+  }
+  ierr = PetscLogObjectMemory((PetscObject)(*V)[0],m*mv->ld*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 
 static PetscErrorCode VecSetOption_MPI(Vec V,VecOption op,PetscBool flag)
 {
@@ -413,7 +457,7 @@ static PetscErrorCode VecSetFromOptions_MPI(PetscOptionItems *PetscOptionsObject
 
 
 static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
-                                VecDuplicateVecs_Default,
+                                VecDuplicateVecs_MPI,
                                 VecDestroyVecs_Default,
                                 VecDot_MPI,
                                 VecMDot_MPI,
@@ -481,7 +525,16 @@ static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
                                 VecStrideSubSetGather_Default,
                                 VecStrideSubSetScatter_Default,
                                 0,
-                                0
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecAXPYDotNorm_MPI,
+                                VecMAXPYNorm_MPI
 };
 
 /*
@@ -501,6 +554,7 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
   ierr           = PetscNewLog(v,&s);CHKERRQ(ierr);
   v->data        = (void*)s;
   ierr           = PetscMemcpy(v->ops,&DvOps,sizeof(DvOps));CHKERRQ(ierr);
+  ierr           = VecSetReproducible_Private(v);CHKERRQ(ierr);
   s->nghost      = nghost;
   v->petscnative = PETSC_TRUE;
 
@@ -539,7 +593,13 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
    Options Database Keys:
-. -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
++ -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
+- -vec_reproducible - compute VecDot(), VecTDot(), VecMDot() and VecNorm() with exact sums whose results do not depend on the number of processes
+
+  Notes:
+  With -vec_reproducible the terms are added into an integer accumulator covering the whole double precision range
+  and converted to floating point at the end, which costs several times a standard dot product. The split phase
+  reductions such as VecDotBegin() are not affected; KSPCG, KSPBCGS and KSPGMRES then use blocking reductions instead.
 
   Level: beginner
 
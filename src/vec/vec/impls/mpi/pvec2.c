@@ -80,6 +80,36 @@ PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
 
 extern MPI_Op MPIU_MAXINDEX_OP, MPIU_MININDEX_OP;
 
+/* the local inner product and sum of squares are reduced together */
+PetscErrorCode VecAXPYDotNorm_MPI(Vec yin,PetscScalar alpha,Vec xin,Vec zin,PetscScalar *dp,PetscReal *nrm)
+{
+  PetscScalar    work[2],sum[2];
+  PetscReal      nrm2 = 0.0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  work[0] = 0.0;
+  ierr    = VecAXPYDotNorm_Seq_Private(yin,alpha,xin,zin,work,nrm ? &nrm2 : NULL);CHKERRQ(ierr);
+  work[1] = nrm2;
+  if (!zin && !nrm) PetscFunctionReturn(0);
+  ierr = MPIU_Allreduce(work,sum,2,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  if (zin) *dp = sum[0];
+  if (nrm) *nrm = PetscSqrtReal(PetscRealPart(sum[1]));
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYNorm_MPI(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscReal *nrm)
+{
+  PetscReal      work,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMAXPYNorm_Seq_Private(yin,nv,alpha,x,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)yin));CHKERRQ(ierr);
+  *nrm = PetscSqrtReal(sum);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode VecMax_MPI(Vec xin,PetscInt *idx,PetscReal *z)
 {
   PetscErrorCode ierr;
@@ -746,14 +746,54 @@ PetscErrorCode VecDuplicate_Seq(Vec win,Vec *V)
   ierr = PetscLayoutReference(win->map,&(*V)->map);CHKERRQ(ierr);
   ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)(*V))->olist);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)(*V))->qlist);CHKERRQ(ierr);
+  /* the storage of a VecDuplicateVecs() block is not shared by the duplicate and must not be kept alive by it */
+  ierr = PetscObjectCompose((PetscObject)*V,"VecMultiVec",NULL);CHKERRQ(ierr);
 
   (*V)->ops->view          = win->ops->view;
   (*V)->stash.ignorenegidx = win->stash.ignorenegidx;
   PetscFunctionReturn(0);
 }
 
+/*
+   With -vec_duplicatevecs_contiguous the new vectors are the columns of a VecMultiVec, which lets VecMDot_Seq() and
+   VecMAXPY_Seq() use BLAS gemv on runs of them. The array is freed with the last of the vectors.
+*/
+static PetscErrorCode VecDuplicateVecs_Seq(Vec w,PetscInt m,Vec *V[])
+{
+  PetscErrorCode ierr;
+  PetscBool      contiguous = PETSC_FALSE,isseq;
+  PetscInt       i;
+  VecMultiVec    *mv;
+  PetscContainer container;
+  Vec            v;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)w,VECSEQ,&isseq);CHKERRQ(ierr);
+  if (isseq) {ierr = PetscOptionsGetBool(((PetscObject)w)->options,((PetscObject)w)->prefix,"-vec_duplicatevecs_contiguous",&contiguous,NULL);CHKERRQ(ierr);}
+  if (!contiguous || m < 2) {
+    ierr = VecDuplicateVecs_Default(w,m,V);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecMultiVecCreate_Private(w,m,&container,&mv);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m,V);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    ierr = VecCreate(PetscObjectComm((PetscObject)w),&v);CHKERRQ(ierr);
+    ierr = PetscLayoutReference(w->map,&v->map);CHKERRQ(ierr);
+    ierr = VecCreate_Seq_Private(v,mv->array+i*mv->ld);CHKERRQ(ierr);
+    ierr = PetscObjectListDuplicate(((PetscObject)w)->olist,&((PetscObject)v)->olist);CHKERRQ(ierr);
+    ierr = PetscFunctionListDuplicate(((PetscObject)w)->qlist,&((PetscObject)v)->qlist);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)v,"VecMultiVec",(PetscObject)container);CHKERRQ(ierr);
+    v->ops->view          = w->ops->view;
+    v->stash.ignorenegidx = w->stash.ignorenegidx;
+    (*V)[i] = v;
+  }
+  ierr = PetscLogObjectMemory((PetscObject)(*V)[0],m*mv->ld*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
-                               VecDuplicateVecs_Default,
+                               VecDuplicateVecs_Seq,
                                VecDestroyVecs_Default,
                                VecDot_Seq,
                                VecMDot_Seq,
@@ -820,7 +860,16 @@ static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
                                VecStrideSubSetGather_Default,
                                VecStrideSubSetScatter_Default,
                                0,
-                               0
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecAXPYDotNorm_Seq,
+                               VecMAXPYNorm_Seq
 };
 
 
@@ -835,6 +884,7 @@ PetscErrorCode VecCreate_Seq_Private(Vec v,const PetscScalar array[])
   PetscFunctionBegin;
   ierr = PetscNewLog(v,&s);CHKERRQ(ierr);
   ierr = PetscMemcpy(v->ops,&DvOps,sizeof(DvOps));CHKERRQ(ierr);
+  ierr = VecSetReproducible_Private(v);CHKERRQ(ierr);
 
   v->data            = (void*)s;
   v->petscnative     = PETSC_TRUE;
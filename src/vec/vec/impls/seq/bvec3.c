@@ -8,7 +8,13 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+- -vec_reproducible - compute VecDot(), VecTDot(), VecMDot() and VecNorm() with exact sums whose results do not depend on the number of processes
+
+  Notes:
+  With -vec_reproducible the terms are added into an integer accumulator covering the whole double precision range
+  and converted to floating point at the end, which costs several times a standard dot product. The split phase
+  reductions such as VecDotBegin() are not affected; KSPCG, KSPBCGS and KSPGMRES then use blocking reductions instead.
 
   Level: beginner
 
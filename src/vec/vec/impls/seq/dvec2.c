@@ -5,8 +5,76 @@
 */
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
+#include <petscblaslapack.h>
 
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+#include <immintrin.h>
+#endif
+
+/* length of the pieces in which VecMDot_Seq() and VecMAXPY_Seq() go through long vectors, a multiple of 4 */
+#define VEC_SEQ_TILE 4096
+
+static PetscErrorCode VecMultiVecDestroy_Private(void *ctx)
+{
+  VecMultiVec    *mv = (VecMultiVec*)ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(mv->array);CHKERRQ(ierr);
+  ierr = PetscFree(mv);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Allocates the storage for m vectors like w as the columns of a dense matrix; the container is to be composed
+   with each of the vectors as "VecMultiVec" so the storage lives until the last of them is destroyed
+*/
+PetscErrorCode VecMultiVecCreate_Private(Vec w,PetscInt m,PetscContainer *container,VecMultiVec **multivec)
+{
+  PetscErrorCode ierr;
+  VecMultiVec    *mv;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&mv);CHKERRQ(ierr);
+  /* the leading dimension is padded to a multiple of 64 bytes */
+  mv->m  = m;
+  mv->ld = PetscMax(64/(PetscInt)sizeof(PetscScalar),1);
+  mv->ld = PetscMax(((w->map->n+mv->ld-1)/mv->ld)*mv->ld,mv->ld);
+  ierr   = PetscCalloc1(m*mv->ld,&mv->array);CHKERRQ(ierr);
+  ierr   = PetscContainerCreate(PETSC_COMM_SELF,container);CHKERRQ(ierr);
+  ierr   = PetscContainerSetPointer(*container,mv);CHKERRQ(ierr);
+  ierr   = PetscContainerSetUserDestroy(*container,VecMultiVecDestroy_Private);CHKERRQ(ierr);
+  *multivec = mv;
+  PetscFunctionReturn(0);
+}
 
+/*
+   Number of vectors at the start of y[] whose arrays yy[] are consecutive columns of one multivector, and its
+   leading dimension. Returns 1 when the run is too short to be worth a BLAS gemv call.
+*/
+static PetscErrorCode VecMultiVecRun_Private(PetscInt nv,const Vec y[],const PetscScalar *const *yy,PetscInt *len,PetscInt *ld)
+{
+  PetscErrorCode ierr;
+  PetscContainer c,ck;
+  VecMultiVec    *mv;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  *len = 1;
+  if (nv < 2) PetscFunctionReturn(0);
+  ierr = PetscObjectQuery((PetscObject)y[0],"VecMultiVec",(PetscObject*)&c);CHKERRQ(ierr);
+  if (!c) PetscFunctionReturn(0);
+  ierr = PetscContainerGetPointer(c,(void**)&mv);CHKERRQ(ierr);
+  for (k=1; k<nv; k++) {
+    ierr = PetscObjectQuery((PetscObject)y[k],"VecMultiVec",(PetscObject*)&ck);CHKERRQ(ierr);
+    if (ck != c || yy[k] != yy[0] + k*mv->ld) break;
+  }
+  if (k >= 4) {
+    *len = k;
+    *ld  = mv->ld;
+  }
+  PetscFunctionReturn(0);
+}
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
 #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
@@ -91,200 +159,139 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
 }
 
 #else
-PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+/*
+   Adds the products of a piece of x with four vectors to sum[]: the first head (< 4) entries one at a time,
+   highest first, then nb (a multiple of 4) entries four at a time. Processing the vectors piece by piece this way
+   gives the same results as going through each vector from start to end.
+*/
+PETSC_STATIC_INLINE void VecMDotTile_Private(const PetscScalar *x,const PetscScalar *y0,const PetscScalar *y1,const PetscScalar *y2,const PetscScalar *y3,PetscInt head,PetscInt nb,PetscScalar *sum)
 {
-  PetscErrorCode    ierr;
-  PetscInt          n = xin->map->n,i,j,nv_rem,j_rem;
-  PetscScalar       sum0,sum1,sum2,sum3,x0,x1,x2,x3;
-  const PetscScalar *yy0,*yy1,*yy2,*yy3,*x,*xbase;
-  Vec               *yy;
+  PetscScalar sum0 = sum[0],sum1 = sum[1],sum2 = sum[2],sum3 = sum[3],x0,x1,x2,x3;
+  PetscInt    j;
 
-  PetscFunctionBegin;
-  sum0 = 0.;
-  sum1 = 0.;
-  sum2 = 0.;
-
-  i      = nv;
-  nv_rem = nv&0x3;
-  yy     = (Vec*)yin;
-  j      = n;
-  ierr   = VecGetArrayRead(xin,&xbase);CHKERRQ(ierr);
-  x      = xbase;
-
-  switch (nv_rem) {
+  switch (head) {
   case 3:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-      sum2 += x2*PetscConj(yy2[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-      sum2 += x1*PetscConj(yy2[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-      sum2 += x0*PetscConj(yy2[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      sum2 += x0*PetscConj(yy2[0]) + x1*PetscConj(yy2[1]) + x2*PetscConj(yy2[2]) + x3*PetscConj(yy2[3]); yy2+=4;
-      j    -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    break;
+    x2    = x[2];
+    sum0 += x2*PetscConj(y0[2]); sum1 += x2*PetscConj(y1[2]);
+    sum2 += x2*PetscConj(y2[2]); sum3 += x2*PetscConj(y3[2]);
   case 2:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      j    -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    break;
+    x1    = x[1];
+    sum0 += x1*PetscConj(y0[1]); sum1 += x1*PetscConj(y1[1]);
+    sum2 += x1*PetscConj(y2[1]); sum3 += x1*PetscConj(y3[1]);
   case 1:
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2 = x[2]; sum0 += x2*PetscConj(yy0[2]);
-    case 2:
-      x1 = x[1]; sum0 += x1*PetscConj(yy0[1]);
-    case 1:
-      x0 = x[0]; sum0 += x0*PetscConj(yy0[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      j   -= j_rem;
-      break;
-    }
-    while (j>0) {
-      sum0 += x[0]*PetscConj(yy0[0]) + x[1]*PetscConj(yy0[1])
-            + x[2]*PetscConj(yy0[2]) + x[3]*PetscConj(yy0[3]);
-      yy0  +=4;
-      j    -= 4; x+=4;
-    }
-    z[0] = sum0;
-
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    break;
+    x0    = x[0];
+    sum0 += x0*PetscConj(y0[0]); sum1 += x0*PetscConj(y1[0]);
+    sum2 += x0*PetscConj(y2[0]); sum3 += x0*PetscConj(y3[0]);
   case 0:
+    x  += head;
+    y0 += head;
+    y1 += head;
+    y2 += head;
+    y3 += head;
     break;
   }
-  z  += nv_rem;
-  i  -= nv_rem;
-  yy += nv_rem;
-
-  while (i >0) {
-    sum0 = 0.;
-    sum1 = 0.;
-    sum2 = 0.;
-    sum3 = 0.;
-    ierr = VecGetArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    ierr = VecGetArrayRead(yy[3],&yy3);CHKERRQ(ierr);
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  {
+    __m512d vx,vsum0 = _mm512_setzero_pd(),vsum1 = _mm512_setzero_pd(),vsum2 = _mm512_setzero_pd(),vsum3 = _mm512_setzero_pd();
+
+    for (j=0; j<nb-7; j+=8) {
+      vx    = _mm512_loadu_pd(x+j);
+      vsum0 = _mm512_fmadd_pd(vx,_mm512_loadu_pd(y0+j),vsum0);
+      vsum1 = _mm512_fmadd_pd(vx,_mm512_loadu_pd(y1+j),vsum1);
+      vsum2 = _mm512_fmadd_pd(vx,_mm512_loadu_pd(y2+j),vsum2);
+      vsum3 = _mm512_fmadd_pd(vx,_mm512_loadu_pd(y3+j),vsum3);
+    }
+    sum0 += _mm512_reduce_add_pd(vsum0);
+    sum1 += _mm512_reduce_add_pd(vsum1);
+    sum2 += _mm512_reduce_add_pd(vsum2);
+    sum3 += _mm512_reduce_add_pd(vsum3);
+  }
+#else
+  j = 0;
+#endif
+  for (; j<nb; j+=4) {
+    x0 = x[j];
+    x1 = x[j+1];
+    x2 = x[j+2];
+    x3 = x[j+3];
+
+    sum0 += x0*PetscConj(y0[j]) + x1*PetscConj(y0[j+1]) + x2*PetscConj(y0[j+2]) + x3*PetscConj(y0[j+3]);
+    sum1 += x0*PetscConj(y1[j]) + x1*PetscConj(y1[j+1]) + x2*PetscConj(y1[j+2]) + x3*PetscConj(y1[j+3]);
+    sum2 += x0*PetscConj(y2[j]) + x1*PetscConj(y2[j+1]) + x2*PetscConj(y2[j+2]) + x3*PetscConj(y2[j+3]);
+    sum3 += x0*PetscConj(y3[j]) + x1*PetscConj(y3[j+1]) + x2*PetscConj(y3[j+2]) + x3*PetscConj(y3[j+3]);
+  }
+  sum[0] = sum0;
+  sum[1] = sum1;
+  sum[2] = sum2;
+  sum[3] = sum3;
+}
 
-    j = n;
-    x = xbase;
-    switch (j_rem=j&0x3) {
-    case 3:
-      x2    = x[2];
-      sum0 += x2*PetscConj(yy0[2]); sum1 += x2*PetscConj(yy1[2]);
-      sum2 += x2*PetscConj(yy2[2]); sum3 += x2*PetscConj(yy3[2]);
-    case 2:
-      x1    = x[1];
-      sum0 += x1*PetscConj(yy0[1]); sum1 += x1*PetscConj(yy1[1]);
-      sum2 += x1*PetscConj(yy2[1]); sum3 += x1*PetscConj(yy3[1]);
-    case 1:
-      x0    = x[0];
-      sum0 += x0*PetscConj(yy0[0]); sum1 += x0*PetscConj(yy1[0]);
-      sum2 += x0*PetscConj(yy2[0]); sum3 += x0*PetscConj(yy3[0]);
-    case 0:
-      x   += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      yy3 += j_rem;
-      j   -= j_rem;
-      break;
+/*
+   The vectors are processed in pieces of VEC_SEQ_TILE entries; each piece of x is used with all the y vectors
+   while it is in cache, instead of streaming x from memory once for every four y vectors. Groups with fewer
+   than four vectors repeat the first vector of the group and drop the extra sums.
+*/
+static void VecMDotTiles_Private(PetscInt n,const PetscScalar *x,PetscInt nv,const PetscScalar *const *yy,const PetscInt *idx,PetscScalar *z)
+{
+  PetscInt          i,j,k,nv_rem = nv&0x3,head,nb;
+  PetscScalar       sum[4];
+  const PetscScalar *y0,*y1,*y2,*y3;
+
+  for (k=0; k<nv; k++) z[idx[k]] = 0.0;
+  for (i=0; i<n; i+=head+nb) {
+    head = i ? 0 : n&0x3;
+    nb   = PetscMin(VEC_SEQ_TILE,n-i-head);
+    for (k=0; k<nv; k+=j) {
+      j  = (k || !nv_rem) ? 4 : nv_rem;
+      y0 = yy[k] + i;
+      y1 = j > 1 ? yy[k+1] + i : y0;
+      y2 = j > 2 ? yy[k+2] + i : y0;
+      y3 = j > 3 ? yy[k+3] + i : y0;
+      sum[0] = z[idx[k]]; sum[1] = j > 1 ? z[idx[k+1]] : 0.0; sum[2] = j > 2 ? z[idx[k+2]] : 0.0; sum[3] = j > 3 ? z[idx[k+3]] : 0.0;
+      VecMDotTile_Private(x+i,y0,y1,y2,y3,head,nb,sum);
+      z[idx[k]] = sum[0]; if (j > 1) z[idx[k+1]] = sum[1]; if (j > 2) z[idx[k+2]] = sum[2]; if (j > 3) z[idx[k+3]] = sum[3];
     }
-    while (j>0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
+  }
+}
 
-      sum0 += x0*PetscConj(yy0[0]) + x1*PetscConj(yy0[1]) + x2*PetscConj(yy0[2]) + x3*PetscConj(yy0[3]); yy0+=4;
-      sum1 += x0*PetscConj(yy1[0]) + x1*PetscConj(yy1[1]) + x2*PetscConj(yy1[2]) + x3*PetscConj(yy1[3]); yy1+=4;
-      sum2 += x0*PetscConj(yy2[0]) + x1*PetscConj(yy2[1]) + x2*PetscConj(yy2[2]) + x3*PetscConj(yy2[3]); yy2+=4;
-      sum3 += x0*PetscConj(yy3[0]) + x1*PetscConj(yy3[1]) + x2*PetscConj(yy3[2]) + x3*PetscConj(yy3[3]); yy3+=4;
-      j    -= 4;
+/*
+   Consecutive columns of a multivector (see VecDuplicateVecs()) are handled with one BLAS gemv, the other
+   vectors with VecMDotTiles_Private()
+*/
+PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,k,len,ld,nrest = 0,iwork[128],*idx = iwork;
+  const PetscScalar *x,*ywork[128],*rwork[128],**yy = ywork,**yrest = rwork;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc3(nv,&yy,nv,&yrest,nv,&idx);CHKERRQ(ierr);
+  }
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {ierr = VecGetArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+  for (k=0; k<nv; k+=len) {
+    ierr = VecMultiVecRun_Private(nv-k,yin+k,yy+k,&len,&ld);CHKERRQ(ierr);
+    if (len > 1) {
+      PetscBLASInt bn,blen,bld,one = 1;
+      PetscScalar  sone = 1.0,szero = 0.0;
+
+      ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(len,&blen);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(ld,&bld);CHKERRQ(ierr);
+      if (n) PetscStackCallBLAS("BLASgemv",BLASgemv_("C",&bn,&blen,&sone,yy[k],&bld,x,&one,&szero,z+k,&one));
+      else {PetscInt l; for (l=0; l<len; l++) z[k+l] = 0.0;}
+    } else {
+      yrest[nrest] = yy[k];
+      idx[nrest++] = k;
     }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    z[3] = sum3;
-    z   += 4;
-    i   -= 4;
-    ierr = VecRestoreArrayRead(yy[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[2],&yy2);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(yy[3],&yy3);CHKERRQ(ierr);
-    yy  += 4;
   }
-  ierr = VecRestoreArrayRead(xin,&xbase);CHKERRQ(ierr);
+  VecMDotTiles_Private(n,x,nrest,yrest,idx,z);
+  for (k=0; k<nv; k++) {ierr = VecRestoreArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscFree3(yy,yrest,idx);CHKERRQ(ierr);
+  }
   ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -553,73 +560,213 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y)
+/*
+   Long vectors are updated in pieces of VEC_SEQ_TILE entries with all the y vectors in turn, so each piece of x
+   is read and written once instead of once for every four y vectors
+*/
+static void VecMAXPYTiles_Private(PetscInt n,PetscScalar *xx,PetscInt nv,const PetscScalar *alpha,const PetscScalar *const *yy)
 {
-  PetscErrorCode    ierr;
-  PetscInt          n = xin->map->n,j,j_rem;
+  PetscInt          i,j,k,nb,nt;
   const PetscScalar *yy0,*yy1,*yy2,*yy3;
-  PetscScalar       *xx,alpha0,alpha1,alpha2,alpha3;
+  PetscScalar       *xt,alpha0,alpha1,alpha2,alpha3;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*xx,*yy0,*yy1,*yy2,*yy3,*alpha)
 #endif
 
+  for (i=0; i<n; i+=nb) {
+    nb = PetscMin(VEC_SEQ_TILE,n-i);
+    /* the kernels advance their arguments for some configurations, so they get copies */
+    for (k=0; k<nv; k+=j) {
+      j  = (k || !(nv&0x3)) ? 4 : nv&0x3;
+      xt = xx + i; nt = nb;
+      switch (j) {
+      case 4:
+        yy0 = yy[k] + i; yy1 = yy[k+1] + i; yy2 = yy[k+2] + i; yy3 = yy[k+3] + i;
+        alpha0 = alpha[k]; alpha1 = alpha[k+1]; alpha2 = alpha[k+2]; alpha3 = alpha[k+3];
+        PetscKernelAXPY4(xt,alpha0,alpha1,alpha2,alpha3,yy0,yy1,yy2,yy3,nt);
+        break;
+      case 3:
+        yy0 = yy[k] + i; yy1 = yy[k+1] + i; yy2 = yy[k+2] + i;
+        alpha0 = alpha[k]; alpha1 = alpha[k+1]; alpha2 = alpha[k+2];
+        PetscKernelAXPY3(xt,alpha0,alpha1,alpha2,yy0,yy1,yy2,nt);
+        break;
+      case 2:
+        yy0 = yy[k] + i; yy1 = yy[k+1] + i;
+        alpha0 = alpha[k]; alpha1 = alpha[k+1];
+        PetscKernelAXPY2(xt,alpha0,alpha1,yy0,yy1,nt);
+        break;
+      case 1:
+        yy0 = yy[k] + i;
+        alpha0 = alpha[k];
+        PetscKernelAXPY(xt,alpha0,yy0,nt);
+        break;
+      }
+    }
+  }
+}
+
+/*
+   Consecutive columns of a multivector (see VecDuplicateVecs()) are added with one BLAS gemv, the other
+   vectors with VecMAXPYTiles_Private()
+*/
+PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,k,len,ld,nrest = 0;
+  const PetscScalar *ywork[128],*rwork[128],**yy = ywork,**yrest = rwork;
+  PetscScalar       *xx,awork[128],*arest = awork;
+
   PetscFunctionBegin;
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscMalloc3(nv,&yy,nv,&yrest,nv,&arest);CHKERRQ(ierr);
+  }
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
-  switch (j_rem=nv&0x3) {
+  for (k=0; k<nv; k++) {ierr = VecGetArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+  for (k=0; k<nv; k+=len) {
+    ierr = VecMultiVecRun_Private(nv-k,y+k,yy+k,&len,&ld);CHKERRQ(ierr);
+    if (len > 1) {
+      PetscBLASInt bn,blen,bld,one = 1;
+      PetscScalar  sone = 1.0;
+
+      ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(len,&blen);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(ld,&bld);CHKERRQ(ierr);
+      if (n) PetscStackCallBLAS("BLASgemv",BLASgemv_("N",&bn,&blen,&sone,yy[k],&bld,alpha+k,&one,&sone,xx,&one));
+    } else {
+      yrest[nrest]   = yy[k];
+      arest[nrest++] = alpha[k];
+    }
+  }
+  VecMAXPYTiles_Private(n,xx,nrest,arest,yrest);
+  for (k=0; k<nv; k++) {ierr = VecRestoreArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscFree3(yy,yrest,arest);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   y <- y + alpha x followed by the local parts of (y,z) and of y'y, all in one loop; z and nrm2 may be NULL
+*/
+PetscErrorCode VecAXPYDotNorm_Seq_Private(Vec yin,PetscScalar alpha,Vec xin,Vec zin,PetscScalar *dp,PetscReal *nrm2)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,n = yin->map->n;
+  PetscScalar       *yy,dsum = 0.0;
+  const PetscScalar *xx,*zz = NULL;
+  PetscReal         nsum = 0.0;
+
+  PetscFunctionBegin;
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  if (zin) {ierr = VecGetArrayRead(zin,&zz);CHKERRQ(ierr);}
+  if (zz && nrm2) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      dsum  += yy[i]*PetscConj(zz[i]);
+      nsum  += PetscRealPart(yy[i]*PetscConj(yy[i]));
+    }
+  } else if (zz) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      dsum  += yy[i]*PetscConj(zz[i]);
+    }
+  } else if (nrm2) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      nsum  += PetscRealPart(yy[i]*PetscConj(yy[i]));
+    }
+  } else {
+    for (i=0; i<n; i++) yy[i] += alpha*xx[i];
+  }
+  if (zin) {ierr = VecRestoreArrayRead(zin,&zz);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*n*(1 + (zin ? 1 : 0) + (nrm2 ? 1 : 0)));CHKERRQ(ierr);
+  if (zin) *dp = dsum;
+  if (nrm2) *nrm2 = nsum;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPYDotNorm_Seq(Vec yin,PetscScalar alpha,Vec xin,Vec zin,PetscScalar *dp,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecAXPYDotNorm_Seq_Private(yin,alpha,xin,zin,dp,nrm);CHKERRQ(ierr);
+  if (nrm) *nrm = PetscSqrtReal(*nrm);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The x vectors except the last (up to) four are added with VecMAXPY_Seq(), the last ones in a loop that also
+   accumulates the local part of y'y so the new y is not read again for the norm
+*/
+PetscErrorCode VecMAXPYNorm_Seq_Private(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscReal *nrm2)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,j,nl,n = yin->map->n;
+  const PetscScalar *xx[4];
+  PetscScalar       *yy,a[4],s;
+  PetscReal         nsum = 0.0;
+
+  PetscFunctionBegin;
+  nl = nv ? (nv-1)%4 + 1 : 0;
+  if (nv > nl) {ierr = VecMAXPY_Seq(yin,nv-nl,alpha,x);CHKERRQ(ierr);}
+  for (j=0; j<nl; j++) {
+    a[j] = alpha[nv-nl+j];
+    ierr = VecGetArrayRead(x[nv-nl+j],&xx[j]);CHKERRQ(ierr);
+  }
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+  switch (nl) {
+  case 4:
+    for (i=0; i<n; i++) {
+      s     = yy[i] + a[0]*xx[0][i] + a[1]*xx[1][i] + a[2]*xx[2][i] + a[3]*xx[3][i];
+      yy[i] = s;
+      nsum += PetscRealPart(s*PetscConj(s));
+    }
+    break;
   case 3:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha2 = alpha[2];
-    alpha += 3;
-    PetscKernelAXPY3(xx,alpha0,alpha1,alpha2,yy0,yy1,yy2,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    y   += 3;
+    for (i=0; i<n; i++) {
+      s     = yy[i] + a[0]*xx[0][i] + a[1]*xx[1][i] + a[2]*xx[2][i];
+      yy[i] = s;
+      nsum += PetscRealPart(s*PetscConj(s));
+    }
     break;
   case 2:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha +=2;
-    PetscKernelAXPY2(xx,alpha0,alpha1,yy0,yy1,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    y   +=2;
+    for (i=0; i<n; i++) {
+      s     = yy[i] + a[0]*xx[0][i] + a[1]*xx[1][i];
+      yy[i] = s;
+      nsum += PetscRealPart(s*PetscConj(s));
+    }
     break;
   case 1:
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    alpha0 = *alpha++;
-    PetscKernelAXPY(xx,alpha0,yy0,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    y   +=1;
+    for (i=0; i<n; i++) {
+      s     = yy[i] + a[0]*xx[0][i];
+      yy[i] = s;
+      nsum += PetscRealPart(s*PetscConj(s));
+    }
     break;
+  default:
+    for (i=0; i<n; i++) nsum += PetscRealPart(yy[i]*PetscConj(yy[i]));
   }
-  for (j=j_rem; j<nv; j+=4) {
-    ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    ierr   = VecGetArrayRead(y[3],&yy3);CHKERRQ(ierr);
-    alpha0 = alpha[0];
-    alpha1 = alpha[1];
-    alpha2 = alpha[2];
-    alpha3 = alpha[3];
-    alpha += 4;
-
-    PetscKernelAXPY4(xx,alpha0,alpha1,alpha2,alpha3,yy0,yy1,yy2,yy3,n);
-    ierr = VecRestoreArrayRead(y[0],&yy0);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[1],&yy1);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[2],&yy2);CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(y[3],&yy3);CHKERRQ(ierr);
-    y   += 4;
-  }
-  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  for (j=0; j<nl; j++) {ierr = VecRestoreArrayRead(x[nv-nl+j],&xx[j]);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(2.0*n*(nl+1));CHKERRQ(ierr);
+  *nrm2 = nsum;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYNorm_Seq(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMAXPYNorm_Seq_Private(yin,nv,alpha,x,nrm);CHKERRQ(ierr);
+  *nrm = PetscSqrtReal(*nrm);
   PetscFunctionReturn(0);
 }
 
@@ -364,6 +364,8 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_Seq;
     V->ops->waxpy                  = VecWAXPY_Seq;
     V->ops->dotnorm2               = NULL;
+    V->ops->axpydotnorm            = VecAXPYDotNorm_Seq;
+    V->ops->maxpynorm              = VecMAXPYNorm_Seq;
     V->ops->placearray             = VecPlaceArray_Seq;
     V->ops->replacearray           = VecReplaceArray_Seq;
     V->ops->resetarray             = VecResetArray_Seq;
@@ -397,6 +399,8 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_SeqCUDA;
     V->ops->waxpy                  = VecWAXPY_SeqCUDA;
     V->ops->dotnorm2               = VecDotNorm2_SeqCUDA;
+    V->ops->axpydotnorm            = NULL;
+    V->ops->maxpynorm              = NULL;
     V->ops->placearray             = VecPlaceArray_SeqCUDA;
     V->ops->replacearray           = VecReplaceArray_SeqCUDA;
     V->ops->resetarray             = VecResetArray_SeqCUDA;
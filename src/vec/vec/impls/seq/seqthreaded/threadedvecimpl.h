@@ -0,0 +1,44 @@
+#if !defined(__THREADEDVECIMPL)
+#define __THREADEDVECIMPL
+
+#include <../src/vec/vec/impls/dvecimpl.h>
+
+/* largest number of threads a vector uses; the per thread partial results of the reductions are kept on the stack */
+#define VEC_OMP_MAX_THREADS 64
+
+/*
+   The entries of a vector are split between the threads in contiguous ranges of whole 64 byte lines. The split
+   only depends on the length and the number of threads, so every kernel hands each thread the entries it touched
+   first when the vector was zeroed at creation (with the first touch page placement on NUMA systems).
+*/
+PETSC_STATIC_INLINE void VecOMPRange_Private(PetscInt n,PetscInt nthreads,PetscInt t,PetscInt *start,PetscInt *end)
+{
+  const PetscInt line = PetscMax(64/(PetscInt)sizeof(PetscScalar),1);
+  PetscInt       nl   = (n + line - 1)/line;
+
+  *start = PetscMin(n,(PetscInt)(((PetscInt64)nl*t)/nthreads)*line);
+  *end   = PetscMin(n,(PetscInt)(((PetscInt64)nl*(t+1))/nthreads)*line);
+}
+
+PETSC_INTERN PetscErrorCode VecSetUpOpenMP_Private(Vec);
+PETSC_INTERN PetscErrorCode VecSetOpsOpenMP_Private(Vec);
+PETSC_INTERN PetscErrorCode VecNormLocal_SeqThreaded_Private(Vec,NormType,PetscReal*);
+
+PETSC_INTERN PetscErrorCode VecDot_SeqThreaded(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecTDot_SeqThreaded(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMDot_SeqThreaded(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecNorm_SeqThreaded(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecScale_SeqThreaded(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecCopy_SeqThreaded(Vec,Vec);
+PETSC_INTERN PetscErrorCode VecSet_SeqThreaded(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecSwap_SeqThreaded(Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPY_SeqThreaded(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBY_SeqThreaded(Vec,PetscScalar,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecMAXPY_SeqThreaded(Vec,PetscInt,const PetscScalar*,Vec*);
+PETSC_INTERN PetscErrorCode VecAYPX_SeqThreaded(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecWAXPY_SeqThreaded(Vec,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZ_SeqThreaded(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecPointwiseMult_SeqThreaded(Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecPointwiseDivide_SeqThreaded(Vec,Vec,Vec);
+
+#endif
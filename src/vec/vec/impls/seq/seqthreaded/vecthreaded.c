@@ -0,0 +1,758 @@
+/*
+   OpenMP versions of the sequential vector operations, also used for the local parts of VECMPITHREADED vectors.
+
+   Each thread works on its VecOMPRange_Private() part of the entries. The reductions first combine the entries of
+   each part and then add the partial results in the order of the parts, so they give the same result in every run
+   with the same number of threads.
+*/
+
+#include <../src/vec/vec/impls/seq/seqthreaded/threadedvecimpl.h> /*I "petscvec.h" I*/
+
+/*
+   VecSetUpOpenMP_Private - Decides how many threads the operations on a vector use
+
+   Options Database Key:
+.  -vec_omp_num_threads <n> - number of threads for the threaded vectors, 1 (the default) turns threading off
+
+   Notes:
+   The vectors use one thread unless the option is given, since with one MPI process per core more threads would only
+   oversubscribe the cores. The option is read without the prefix of the vector so that all the vectors of a given
+   length, and the duplicates of a vector, are split in the same way.
+*/
+PetscErrorCode VecSetUpOpenMP_Private(Vec v)
+{
+  Vec_Seq        *s = (Vec_Seq*)v->data;
+  PetscInt       n = v->map->n,nthreads = 1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetInt(((PetscObject)v)->options,NULL,"-vec_omp_num_threads",&nthreads,NULL);CHKERRQ(ierr);
+  nthreads        = PetscMin(nthreads,VEC_OMP_MAX_THREADS);
+  s->omp_nthreads = PetscMax(PetscMin(nthreads,n),1);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDot_SeqThreaded(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       part[VEC_OMP_MAX_THREADS],sum = 0.0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecDot_Seq(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt    i,start,end;
+    PetscScalar s = 0.0;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (i=start; i<end; i++) s += xa[i]*PetscConj(ya[i]);
+    part[t] = s;
+  }
+  for (t=0; t<nthreads; t++) sum += part[t];
+  *z   = sum;
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*n-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecTDot_SeqThreaded(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       part[VEC_OMP_MAX_THREADS],sum = 0.0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecTDot_Seq(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt    i,start,end;
+    PetscScalar s = 0.0;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (i=start; i<end; i++) s += xa[i]*ya[i];
+    part[t] = s;
+  }
+  for (t=0; t<nthreads; t++) sum += part[t];
+  *z   = sum;
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*n-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* each thread goes through its part of x once for every four y vectors */
+PetscErrorCode VecMDot_SeqThreaded(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t,k;
+  const PetscScalar *xa,*ywork[128],**yy = ywork;
+  PetscScalar       pwork[512],*part = pwork;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecMDot_Seq(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (nv > 128) {ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);}
+  if (nthreads*nv > 512) {ierr = PetscMalloc1(nthreads*nv,&part);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {ierr = VecGetArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    const PetscScalar *y0,*y1,*y2,*y3;
+    PetscScalar       *p = part + t*nv,s0,s1,s2,s3,x0;
+    PetscInt          i,j,l,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (j=0; j<nv; j+=l) {
+      l  = PetscMin(4,nv-j);
+      y0 = yy[j];
+      y1 = l > 1 ? yy[j+1] : y0;
+      y2 = l > 2 ? yy[j+2] : y0;
+      y3 = l > 3 ? yy[j+3] : y0;
+      s0 = s1 = s2 = s3 = 0.0;
+      for (i=start; i<end; i++) {
+        x0  = xa[i];
+        s0 += x0*PetscConj(y0[i]);
+        s1 += x0*PetscConj(y1[i]);
+        s2 += x0*PetscConj(y2[i]);
+        s3 += x0*PetscConj(y3[i]);
+      }
+      p[j] = s0;
+      if (l > 1) p[j+1] = s1;
+      if (l > 2) p[j+2] = s2;
+      if (l > 3) p[j+3] = s3;
+    }
+  }
+  for (k=0; k<nv; k++) {
+    z[k] = 0.0;
+    for (t=0; t<nthreads; t++) z[k] += part[t*nv+k];
+  }
+  for (k=0; k<nv; k++) {ierr = VecRestoreArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  if (nv > 128) {ierr = PetscFree(yy);CHKERRQ(ierr);}
+  if (part != pwork) {ierr = PetscFree(part);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The local part of a norm: the sum of the absolute values for NORM_1, the sum of the squares for NORM_2 (without
+   the square root) and the largest absolute value for NORM_INFINITY; both sums for NORM_1_AND_2
+*/
+PetscErrorCode VecNormLocal_SeqThreaded_Private(Vec xin,NormType type,PetscReal *z)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  const PetscScalar *xa;
+  PetscReal         part1[VEC_OMP_MAX_THREADS],part2[VEC_OMP_MAX_THREADS];
+  PetscBool         do1 = (PetscBool)(type == NORM_1 || type == NORM_1_AND_2),do2 = (PetscBool)(type == NORM_2 || type == NORM_FROBENIUS || type == NORM_1_AND_2);
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  nthreads = PetscMax(nthreads,1);
+  ierr     = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  if (type == NORM_INFINITY) {
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt  i,start,end;
+      PetscReal max = 0.0,tmp;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      for (i=start; i<end; i++) {
+        if ((tmp = PetscAbsScalar(xa[i])) > max) max = tmp;
+        /* check special case of tmp == NaN */
+        if (tmp != tmp) {max = tmp; break;}
+      }
+      part1[t] = max;
+    }
+    *z = 0.0;
+    for (t=0; t<nthreads; t++) {
+      if (part1[t] > *z) *z = part1[t];
+      if (part1[t] != part1[t]) {*z = part1[t]; break;}
+    }
+  } else {
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt  i,start,end;
+      PetscReal s1 = 0.0,s2 = 0.0;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      if (do1 && do2) {
+        for (i=start; i<end; i++) {
+          s1 += PetscAbsScalar(xa[i]);
+          s2 += PetscRealPart(xa[i]*PetscConj(xa[i]));
+        }
+      } else if (do1) {
+        for (i=start; i<end; i++) s1 += PetscAbsScalar(xa[i]);
+      } else {
+        for (i=start; i<end; i++) s2 += PetscRealPart(xa[i]*PetscConj(xa[i]));
+      }
+      part1[t] = s1;
+      part2[t] = s2;
+    }
+    if (do1) {
+      z[0] = 0.0;
+      for (t=0; t<nthreads; t++) z[0] += part1[t];
+    }
+    if (do2) {
+      PetscReal *z2 = do1 ? z+1 : z;
+
+      *z2 = 0.0;
+      for (t=0; t<nthreads; t++) *z2 += part2[t];
+    }
+    ierr = PetscLogFlops(PetscMax((do1 && do2 ? 3.0 : 2.0)*n-1,0.0));CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecNorm_SeqThreaded(Vec xin,NormType type,PetscReal *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (((Vec_Seq*)xin->data)->omp_nthreads < 2) {
+    ierr = VecNorm_Seq(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecNormLocal_SeqThreaded_Private(xin,type,z);CHKERRQ(ierr);
+  if (type == NORM_2 || type == NORM_FROBENIUS) z[0] = PetscSqrtReal(z[0]);
+  else if (type == NORM_1_AND_2) z[1] = PetscSqrtReal(z[1]);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSet_SeqThreaded(Vec xin,PetscScalar alpha)
+{
+  PetscInt       n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  PetscScalar    *xa;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecSet_Seq(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArray(xin,&xa);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt i,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    if (alpha == (PetscScalar)0.0) {
+      PetscMemzero(xa+start,(end-start)*sizeof(PetscScalar));
+    } else {
+      for (i=start; i<end; i++) xa[i] = alpha;
+    }
+  }
+  ierr = VecRestoreArray(xin,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScale_SeqThreaded(Vec xin,PetscScalar alpha)
+{
+  PetscInt       n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  PetscScalar    *xa;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecScale_Seq(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (alpha == (PetscScalar)0.0) {
+    ierr = VecSet_SeqThreaded(xin,alpha);CHKERRQ(ierr);
+  } else if (alpha != (PetscScalar)1.0) {
+    ierr = VecGetArray(xin,&xa);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt i,start,end;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      for (i=start; i<end; i++) xa[i] *= alpha;
+    }
+    ierr = VecRestoreArray(xin,&xa);CHKERRQ(ierr);
+  }
+  ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecCopy_SeqThreaded(Vec xin,Vec yin)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecCopy_Seq(xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (xin != yin) {
+    ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt start,end;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      PetscMemcpy(ya+start,xa+start,(end-start)*sizeof(PetscScalar));
+    }
+    ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSwap_SeqThreaded(Vec xin,Vec yin)
+{
+  PetscInt       n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t;
+  PetscScalar    *xa,*ya;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecSwap_Seq(xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (xin != yin) {
+    ierr = VecGetArray(xin,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt    i,start,end;
+      PetscScalar tmp;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      for (i=start; i<end; i++) {
+        tmp   = xa[i];
+        xa[i] = ya[i];
+        ya[i] = tmp;
+      }
+    }
+    ierr = VecRestoreArray(xin,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPY_SeqThreaded(Vec yin,PetscScalar alpha,Vec xin)
+{
+  PetscInt          n = yin->map->n,nthreads = ((Vec_Seq*)yin->data)->omp_nthreads,t;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecAXPY_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (alpha != (PetscScalar)0.0) {
+    ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt i,start,end;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      for (i=start; i<end; i++) ya[i] += alpha*xa[i];
+    }
+    ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAYPX_SeqThreaded(Vec yin,PetscScalar alpha,Vec xin)
+{
+  PetscInt          n = yin->map->n,nthreads = ((Vec_Seq*)yin->data)->omp_nthreads,t;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecAYPX_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (alpha == (PetscScalar)0.0) {
+    ierr = VecCopy(xin,yin);CHKERRQ(ierr);
+  } else if (alpha == (PetscScalar)1.0) {
+    ierr = VecAXPY_SeqThreaded(yin,alpha,xin);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt i,start,end;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      if (alpha == (PetscScalar)-1.0) {
+        for (i=start; i<end; i++) ya[i] = xa[i] - ya[i];
+      } else {
+        for (i=start; i<end; i++) ya[i] = xa[i] + alpha*ya[i];
+      }
+    }
+    ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+    ierr = PetscLogFlops((alpha == (PetscScalar)-1.0 ? 1.0 : 2.0)*n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBY_SeqThreaded(Vec yin,PetscScalar a,PetscScalar b,Vec xin)
+{
+  PetscInt          n = yin->map->n,nthreads = ((Vec_Seq*)yin->data)->omp_nthreads,t;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecAXPBY_Seq(yin,a,b,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (a == (PetscScalar)0.0) {
+    ierr = VecScale_SeqThreaded(yin,b);CHKERRQ(ierr);
+  } else if (b == (PetscScalar)1.0) {
+    ierr = VecAXPY_SeqThreaded(yin,a,xin);CHKERRQ(ierr);
+  } else if (a == (PetscScalar)1.0) {
+    ierr = VecAYPX_SeqThreaded(yin,b,xin);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+    for (t=0; t<nthreads; t++) {
+      PetscInt i,start,end;
+
+      VecOMPRange_Private(n,nthreads,t,&start,&end);
+      if (b == (PetscScalar)0.0) {
+        for (i=start; i<end; i++) ya[i] = a*xa[i];
+      } else {
+        for (i=start; i<end; i++) ya[i] = a*xa[i] + b*ya[i];
+      }
+    }
+    ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+    ierr = PetscLogFlops((b == (PetscScalar)0.0 ? 1.0 : 3.0)*n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPY_SeqThreaded(Vec win,PetscScalar alpha,Vec xin,Vec yin)
+{
+  PetscInt          n = win->map->n,nthreads = ((Vec_Seq*)win->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       *wa;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecWAXPY_Seq(win,alpha,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecGetArray(win,&wa);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt i,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    if (alpha == (PetscScalar)1.0) {
+      for (i=start; i<end; i++) wa[i] = ya[i] + xa[i];
+    } else if (alpha == (PetscScalar)-1.0) {
+      for (i=start; i<end; i++) wa[i] = ya[i] - xa[i];
+    } else if (alpha == (PetscScalar)0.0) {
+      PetscMemcpy(wa+start,ya+start,(end-start)*sizeof(PetscScalar));
+    } else {
+      for (i=start; i<end; i++) wa[i] = ya[i] + alpha*xa[i];
+    }
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArray(win,&wa);CHKERRQ(ierr);
+  if (alpha == (PetscScalar)1.0 || alpha == (PetscScalar)-1.0) {
+    ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  } else if (alpha != (PetscScalar)0.0) {
+    ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBYPCZ_SeqThreaded(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin)
+{
+  PetscInt          n = zin->map->n,nthreads = ((Vec_Seq*)zin->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       *za;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecAXPBYPCZ_Seq(zin,alpha,beta,gamma,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecGetArray(zin,&za);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt i,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    if (alpha == (PetscScalar)1.0) {
+      for (i=start; i<end; i++) za[i] = xa[i] + beta*ya[i] + gamma*za[i];
+    } else if (gamma == (PetscScalar)1.0) {
+      for (i=start; i<end; i++) za[i] = alpha*xa[i] + beta*ya[i] + za[i];
+    } else if (gamma == (PetscScalar)0.0) {
+      for (i=start; i<end; i++) za[i] = alpha*xa[i] + beta*ya[i];
+    } else {
+      for (i=start; i<end; i++) za[i] = alpha*xa[i] + beta*ya[i] + gamma*za[i];
+    }
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zin,&za);CHKERRQ(ierr);
+  if (alpha == (PetscScalar)1.0 || gamma == (PetscScalar)1.0) {
+    ierr = PetscLogFlops(4.0*n);CHKERRQ(ierr);
+  } else if (gamma == (PetscScalar)0.0) {
+    ierr = PetscLogFlops(3.0*n);CHKERRQ(ierr);
+  } else {
+    ierr = PetscLogFlops(5.0*n);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* each thread goes through its part of x once for every four y vectors */
+PetscErrorCode VecMAXPY_SeqThreaded(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y)
+{
+  PetscInt          n = xin->map->n,nthreads = ((Vec_Seq*)xin->data)->omp_nthreads,t,k;
+  const PetscScalar *ywork[128],**yy = ywork;
+  PetscScalar       *xa;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecMAXPY_Seq(xin,nv,alpha,y);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (nv > 128) {ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);}
+  ierr = VecGetArray(xin,&xa);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {ierr = VecGetArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    const PetscScalar *y0,*y1,*y2,*y3;
+    PetscScalar       a0,a1,a2,a3;
+    PetscInt          i,j,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (j=0; j<nv; j+=4) {
+      switch (PetscMin(4,nv-j)) {
+      case 4:
+        y0 = yy[j]; y1 = yy[j+1]; y2 = yy[j+2]; y3 = yy[j+3];
+        a0 = alpha[j]; a1 = alpha[j+1]; a2 = alpha[j+2]; a3 = alpha[j+3];
+        for (i=start; i<end; i++) xa[i] += a0*y0[i] + a1*y1[i] + a2*y2[i] + a3*y3[i];
+        break;
+      case 3:
+        y0 = yy[j]; y1 = yy[j+1]; y2 = yy[j+2];
+        a0 = alpha[j]; a1 = alpha[j+1]; a2 = alpha[j+2];
+        for (i=start; i<end; i++) xa[i] += a0*y0[i] + a1*y1[i] + a2*y2[i];
+        break;
+      case 2:
+        y0 = yy[j]; y1 = yy[j+1];
+        a0 = alpha[j]; a1 = alpha[j+1];
+        for (i=start; i<end; i++) xa[i] += a0*y0[i] + a1*y1[i];
+        break;
+      case 1:
+        y0 = yy[j];
+        a0 = alpha[j];
+        for (i=start; i<end; i++) xa[i] += a0*y0[i];
+        break;
+      }
+    }
+  }
+  for (k=0; k<nv; k++) {ierr = VecRestoreArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(xin,&xa);CHKERRQ(ierr);
+  if (nv > 128) {ierr = PetscFree(yy);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecPointwiseMult_SeqThreaded(Vec win,Vec xin,Vec yin)
+{
+  PetscInt          n = win->map->n,nthreads = ((Vec_Seq*)win->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       *wa;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecPointwiseMult_Seq(win,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecGetArray(win,&wa);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt i,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (i=start; i<end; i++) wa[i] = xa[i]*ya[i];
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArray(win,&wa);CHKERRQ(ierr);
+  ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecPointwiseDivide_SeqThreaded(Vec win,Vec xin,Vec yin)
+{
+  PetscInt          n = win->map->n,nthreads = ((Vec_Seq*)win->data)->omp_nthreads,t;
+  const PetscScalar *xa,*ya;
+  PetscScalar       *wa;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 2) {
+    ierr = VecPointwiseDivide_Seq(win,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecGetArray(win,&wa);CHKERRQ(ierr);
+#pragma omp parallel for num_threads((int)nthreads) schedule(static,1)
+  for (t=0; t<nthreads; t++) {
+    PetscInt i,start,end;
+
+    VecOMPRange_Private(n,nthreads,t,&start,&end);
+    for (i=start; i<end; i++) {
+      if (ya[i] != (PetscScalar)0.0) wa[i] = xa[i]/ya[i];
+      else wa[i] = 0.0;
+    }
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArray(win,&wa);CHKERRQ(ierr);
+  ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecSetOpsOpenMP_Private - Replaces the operations on the local entries that have threaded versions; the
+   reductions are replaced by the caller. The fused operations fall back to the separate threaded ones.
+*/
+PetscErrorCode VecSetOpsOpenMP_Private(Vec v)
+{
+  PetscFunctionBegin;
+  v->ops->scale           = VecScale_SeqThreaded;
+  v->ops->copy            = VecCopy_SeqThreaded;
+  v->ops->set             = VecSet_SeqThreaded;
+  v->ops->swap            = VecSwap_SeqThreaded;
+  v->ops->axpy            = VecAXPY_SeqThreaded;
+  v->ops->axpby           = VecAXPBY_SeqThreaded;
+  v->ops->maxpy           = VecMAXPY_SeqThreaded;
+  v->ops->aypx            = VecAYPX_SeqThreaded;
+  v->ops->waxpy           = VecWAXPY_SeqThreaded;
+  v->ops->axpbypcz        = VecAXPBYPCZ_SeqThreaded;
+  v->ops->pointwisemult   = VecPointwiseMult_SeqThreaded;
+  v->ops->pointwisedivide = VecPointwiseDivide_SeqThreaded;
+  v->ops->dot_local       = VecDot_SeqThreaded;
+  v->ops->tdot_local      = VecTDot_SeqThreaded;
+  v->ops->norm_local      = VecNorm_SeqThreaded;
+  v->ops->mdot_local      = VecMDot_SeqThreaded;
+  v->ops->axpydotnorm     = NULL;
+  v->ops->maxpynorm       = NULL;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECSEQTHREADED - VECSEQTHREADED = "seqthreaded" - A sequential vector whose operations use OpenMP threads
+
+   Options Database Keys:
++  -vec_type seqthreaded - sets the vector type to VECSEQTHREADED during a call to VecSetFromOptions()
+-  -vec_omp_num_threads <n> - number of threads, by default 1
+
+   Notes:
+   The entries are split statically between the threads in the same way for all the operations, and the array is
+   zeroed by the threads when the vector is created, so on NUMA systems each thread works on memory close to it.
+   The inner products and norms combine the partial results of the threads in a fixed order, so they do not change
+   from run to run with the same number of threads.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECTHREADED, VECMPITHREADED, VECSEQ
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_SeqThreaded(Vec V)
+{
+  Vec_Seq        *s;
+  PetscScalar    *array;
+  PetscInt       n = PetscMax(V->map->n,V->map->N);
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)V),&size);CHKERRQ(ierr);
+  if (size > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Cannot create VECSEQTHREADED on more than one process");
+  ierr = PetscMalloc1(n,&array);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)V,n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecCreate_Seq_Private(V,array);CHKERRQ(ierr);
+  s    = (Vec_Seq*)V->data;
+  s->array_allocated = array;
+
+  ierr = VecSetUpOpenMP_Private(V);CHKERRQ(ierr);
+  ierr = VecSetOpsOpenMP_Private(V);CHKERRQ(ierr);
+  V->ops->dot   = VecDot_SeqThreaded;
+  V->ops->tdot  = VecTDot_SeqThreaded;
+  V->ops->mdot  = VecMDot_SeqThreaded;
+  V->ops->norm  = VecNorm_SeqThreaded;
+  ierr = VecSetReproducible_Private(V);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)V,VECSEQTHREADED);CHKERRQ(ierr);
+  /* the first touch of the entries is by the threads that use them */
+  ierr = VecSet(V,0.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECTHREADED - VECTHREADED = "threaded" - A VECSEQTHREADED on one process and VECMPITHREADED on more than one process
+
+   Options Database Keys:
+.  -vec_type threaded - sets a vector type to threaded on calls to VecSetFromOptions()
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECSEQTHREADED, VECMPITHREADED, VECSTANDARD
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_Threaded(Vec v)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)v),&size);CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = VecSetType(v,VECSEQTHREADED);CHKERRQ(ierr);
+  } else {
+    ierr = VecSetType(v,VECMPITHREADED);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
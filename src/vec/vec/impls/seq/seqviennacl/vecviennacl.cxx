@@ -1114,6 +1114,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V,PetscBool flg)
     V->ops->aypx            = VecAYPX_Seq;
     V->ops->waxpy           = VecWAXPY_Seq;
     V->ops->dotnorm2        = NULL;
+    V->ops->axpydotnorm     = VecAXPYDotNorm_Seq;
+    V->ops->maxpynorm       = VecMAXPYNorm_Seq;
     V->ops->placearray      = VecPlaceArray_Seq;
     V->ops->replacearray    = VecReplaceArray_Seq;
     V->ops->resetarray      = VecResetArray_Seq;
@@ -1143,6 +1145,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V,PetscBool flg)
     V->ops->aypx            = VecAYPX_SeqViennaCL;
     V->ops->waxpy           = VecWAXPY_SeqViennaCL;
     V->ops->dotnorm2        = VecDotNorm2_SeqViennaCL;
+    V->ops->axpydotnorm     = NULL;
+    V->ops->maxpynorm       = NULL;
     V->ops->placearray      = VecPlaceArray_SeqViennaCL;
     V->ops->replacearray    = VecReplaceArray_SeqViennaCL;
     V->ops->resetarray      = VecResetArray_SeqViennaCL;
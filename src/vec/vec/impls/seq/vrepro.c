@@ -0,0 +1,329 @@
+/*
+   Reductions whose results do not depend on the number of processes or the order of the entries, used by VECSEQ
+   and VECMPI (and the threaded vectors) with -vec_reproducible.
+
+   The terms (the products x_i*conj(y_i), |x_i| or |x_i|^2, each rounded as usual) are added exactly into a fixed
+   point accumulator that covers the whole double precision range, VecReproSum. Adding integers is associative, so
+   the accumulators of the processes can be combined in any order, with a custom MPI_Op, and the exact sum is
+   converted to double only at the end.
+*/
+
+#include <../src/vec/vec/impls/dvecimpl.h>   /*I  "petscvec.h"   I*/
+
+/*
+   limb[k] holds the multiple of 2^(32 k + VEC_REPRO_BIAS); after VecReproSumNormalize() all the limbs but the last
+   are in [0,2^32) and the last one carries the sign. The smallest double, 2^-1074, is bit 14 of limb 0 and the
+   largest is below limb 66. Each addition adds less than 2^33 to a limb, so the accumulator is normalized at the
+   latest every 2^29 additions.
+*/
+#define VEC_REPRO_NLIMBS 68
+#define VEC_REPRO_BIAS   (-1088)
+#define VEC_REPRO_MAXADD (1<<29)
+
+typedef struct {
+  PetscInt64 limb[VEC_REPRO_NLIMBS];
+  double     special;                 /* sum of the infinite and NaN terms */
+} VecReproSum;
+
+static MPI_Datatype VecReproSum_Type = MPI_DATATYPE_NULL;
+static MPI_Op       VecReproSum_Op   = MPI_OP_NULL;
+
+PETSC_STATIC_INLINE void VecReproSumZero(VecReproSum *acc)
+{
+  PetscInt k;
+
+  for (k=0; k<VEC_REPRO_NLIMBS; k++) acc->limb[k] = 0;
+  acc->special = 0.0;
+}
+
+/* the floor of v/2^32, without relying on the right shift of negative numbers */
+PETSC_STATIC_INLINE PetscInt64 VecReproCarry(PetscInt64 v)
+{
+  return v >= 0 ? v >> 32 : -((-v + (((PetscInt64)1 << 32) - 1)) >> 32);
+}
+
+static void VecReproSumNormalize(VecReproSum *acc)
+{
+  PetscInt   k;
+  PetscInt64 c;
+
+  for (k=0; k<VEC_REPRO_NLIMBS-1; k++) {
+    c              = VecReproCarry(acc->limb[k]);
+    acc->limb[k]  -= c*((PetscInt64)1 << 32);
+    acc->limb[k+1] += c;
+  }
+}
+
+PETSC_STATIC_INLINE void VecReproSumAdd(VecReproSum *acc,double d)
+{
+  union {double d; PetscInt64 i;} bits;
+  PetscInt64 m,lo,hi;
+  int        e,s,k,r;
+
+  bits.d = d;
+  e = (int)((bits.i >> 52) & 0x7ff);
+  m = bits.i & (((PetscInt64)1 << 52) - 1);
+  if (e == 0x7ff) {acc->special += d; return;}
+  if (e) {m |= (PetscInt64)1 << 52; e -= 1075;}
+  else e = -1074;
+  if (!m) return;
+  s  = e - VEC_REPRO_BIAS;
+  k  = s >> 5;
+  r  = s & 31;
+  lo = (m & 0xffffffff) << r;
+  hi = (m >> 32) << r;
+  if (d < 0) {
+    acc->limb[k]   -= lo & 0xffffffff;
+    acc->limb[k+1] -= (lo >> 32) + (hi & 0xffffffff);
+    acc->limb[k+2] -= hi >> 32;
+  } else {
+    acc->limb[k]   += lo & 0xffffffff;
+    acc->limb[k+1] += (lo >> 32) + (hi & 0xffffffff);
+    acc->limb[k+2] += hi >> 32;
+  }
+}
+
+/* the exact sum converted to double; the accumulator must be normalized */
+static double VecReproSumRound(const VecReproSum *acc)
+{
+  VecReproSum a = *acc;
+  double      r = 0.0;
+  PetscInt    k;
+  PetscBool   neg = (PetscBool)(a.limb[VEC_REPRO_NLIMBS-1] < 0);
+
+  if (a.special != 0.0) return a.special;
+  if (neg) {
+    for (k=0; k<VEC_REPRO_NLIMBS; k++) a.limb[k] = -a.limb[k];
+    VecReproSumNormalize(&a);
+  }
+  /* the limbs are exact in double and are added from the smallest, so the result only depends on the exact sum */
+  for (k=0; k<VEC_REPRO_NLIMBS; k++) {
+    if (a.limb[k]) r += ldexp((double)a.limb[k],32*(int)k+VEC_REPRO_BIAS);
+  }
+  return neg ? -r : r;
+}
+
+static void MPIAPI VecReproSum_Local(void *in,void *out,PetscMPIInt *cnt,MPI_Datatype *datatype)
+{
+  VecReproSum *xin = (VecReproSum*)in,*xout = (VecReproSum*)out;
+  PetscInt    i,k;
+
+  for (i=0; i<*cnt; i++) {
+    for (k=0; k<VEC_REPRO_NLIMBS; k++) xout[i].limb[k] += xin[i].limb[k];
+    xout[i].special += xin[i].special;
+    VecReproSumNormalize(&xout[i]);
+  }
+}
+
+static PetscErrorCode VecReproSumFinalize_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Op_free(&VecReproSum_Op);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&VecReproSum_Type);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* combines the normalized accumulators of the processes, nacc accumulators at a time */
+static PetscErrorCode VecReproSumAllreduce_Private(Vec x,PetscInt nacc,VecReproSum *acc)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject)x);
+  PetscMPIInt    size,cnt;
+  VecReproSum    awork[4],*work = awork;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (size == 1) PetscFunctionReturn(0);
+  if (VecReproSum_Op == MPI_OP_NULL) {
+    ierr = MPI_Type_contiguous((PetscMPIInt)sizeof(VecReproSum),MPI_BYTE,&VecReproSum_Type);CHKERRQ(ierr);
+    ierr = MPI_Type_commit(&VecReproSum_Type);CHKERRQ(ierr);
+    ierr = MPI_Op_create(VecReproSum_Local,1,&VecReproSum_Op);CHKERRQ(ierr);
+    ierr = PetscRegisterFinalize(VecReproSumFinalize_Private);CHKERRQ(ierr);
+  }
+  if (nacc > 4) {ierr = PetscMalloc1(nacc,&work);CHKERRQ(ierr);}
+  ierr = PetscMPIIntCast(nacc,&cnt);CHKERRQ(ierr);
+  ierr = PetscArraycpy(work,acc,nacc);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,acc,cnt,VecReproSum_Type,VecReproSum_Op,comm);CHKERRQ(ierr);
+  if (nacc > 4) {ierr = PetscFree(work);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   Adds the products x_i*conj(y_i) (or x_i*y_i) to acc[0] and, for complex numbers, their imaginary parts to acc[1];
+   the accumulators are normalized on return
+*/
+static void VecReproDot_Private(PetscInt n,const PetscScalar *x,const PetscScalar *y,PetscBool conj,VecReproSum *acc)
+{
+  PetscInt    i,nadd = 0;
+  PetscScalar p;
+
+  for (i=0; i<n; i++) {
+    p = conj ? x[i]*PetscConj(y[i]) : x[i]*y[i];
+    VecReproSumAdd(&acc[0],(double)PetscRealPart(p));
+#if defined(PETSC_USE_COMPLEX)
+    VecReproSumAdd(&acc[1],(double)PetscImaginaryPart(p));
+#endif
+    if (++nadd == VEC_REPRO_MAXADD) {
+      VecReproSumNormalize(&acc[0]);
+#if defined(PETSC_USE_COMPLEX)
+      VecReproSumNormalize(&acc[1]);
+#endif
+      nadd = 0;
+    }
+  }
+  VecReproSumNormalize(&acc[0]);
+#if defined(PETSC_USE_COMPLEX)
+  VecReproSumNormalize(&acc[1]);
+#endif
+}
+
+#if defined(PETSC_USE_COMPLEX)
+#define VEC_REPRO_NS 2
+#define VecReproScalar(acc) PetscCMPLX((PetscReal)VecReproSumRound(&(acc)[0]),(PetscReal)VecReproSumRound(&(acc)[1]))
+#else
+#define VEC_REPRO_NS 1
+#define VecReproScalar(acc) ((PetscScalar)VecReproSumRound(&(acc)[0]))
+#endif
+
+static PetscErrorCode VecDotReproducible_Private(Vec xin,Vec yin,PetscBool conj,PetscScalar *z)
+{
+  const PetscScalar *xa,*ya;
+  VecReproSum       acc[VEC_REPRO_NS];
+  PetscInt          k;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  for (k=0; k<VEC_REPRO_NS; k++) VecReproSumZero(&acc[k]);
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+  VecReproDot_Private(xin->map->n,xa,ya,conj,acc);
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&ya);CHKERRQ(ierr);
+  ierr = VecReproSumAllreduce_Private(xin,VEC_REPRO_NS,acc);CHKERRQ(ierr);
+  *z   = VecReproScalar(acc);
+  ierr = PetscLogFlops(PetscMax(2.0*xin->map->n-1,0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDot_Reproducible(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDotReproducible_Private(xin,yin,PETSC_TRUE,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecTDot_Reproducible(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDotReproducible_Private(xin,yin,PETSC_FALSE,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* all the inner products are combined in one reduction */
+static PetscErrorCode VecMDot_Reproducible(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
+{
+  const PetscScalar *xa,*ya;
+  VecReproSum       *acc;
+  PetscInt          j,k;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(VEC_REPRO_NS*nv,&acc);CHKERRQ(ierr);
+  for (k=0; k<VEC_REPRO_NS*nv; k++) VecReproSumZero(&acc[k]);
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    ierr = VecGetArrayRead(y[j],&ya);CHKERRQ(ierr);
+    VecReproDot_Private(xin->map->n,xa,ya,PETSC_TRUE,acc+VEC_REPRO_NS*j);
+    ierr = VecRestoreArrayRead(y[j],&ya);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  ierr = VecReproSumAllreduce_Private(xin,VEC_REPRO_NS*nv,acc);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) z[j] = VecReproScalar(acc+VEC_REPRO_NS*j);
+  ierr = PetscFree(acc);CHKERRQ(ierr);
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecNorm_Reproducible(Vec xin,NormType type,PetscReal *z)
+{
+  const PetscScalar *xa;
+  VecReproSum       acc[2];
+  PetscInt          i,n = xin->map->n,nadd = 0;
+  PetscBool         do1 = (PetscBool)(type == NORM_1 || type == NORM_1_AND_2),do2 = (PetscBool)(type != NORM_1);
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (type == NORM_INFINITY) {
+    PetscReal work;
+
+    /* the largest entry does not depend on the order */
+    ierr = VecNorm_Seq(xin,NORM_INFINITY,&work);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&work,z,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  VecReproSumZero(&acc[0]);
+  VecReproSumZero(&acc[1]);
+  ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (do1) VecReproSumAdd(&acc[0],(double)PetscAbsScalar(xa[i]));
+    if (do2) {
+      VecReproSumAdd(&acc[1],(double)(PetscRealPart(xa[i])*PetscRealPart(xa[i])));
+#if defined(PETSC_USE_COMPLEX)
+      VecReproSumAdd(&acc[1],(double)(PetscImaginaryPart(xa[i])*PetscImaginaryPart(xa[i])));
+#endif
+    }
+    if (++nadd == VEC_REPRO_MAXADD/2) {
+      VecReproSumNormalize(&acc[0]);
+      VecReproSumNormalize(&acc[1]);
+      nadd = 0;
+    }
+  }
+  ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
+  VecReproSumNormalize(&acc[0]);
+  VecReproSumNormalize(&acc[1]);
+  ierr = VecReproSumAllreduce_Private(xin,2,acc);CHKERRQ(ierr);
+  if (type == NORM_1) *z = (PetscReal)VecReproSumRound(&acc[0]);
+  else if (type == NORM_1_AND_2) {
+    z[0] = (PetscReal)VecReproSumRound(&acc[0]);
+    z[1] = PetscSqrtReal((PetscReal)VecReproSumRound(&acc[1]));
+  } else *z = PetscSqrtReal((PetscReal)VecReproSumRound(&acc[1]));
+  ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecSetReproducible_Private - With -vec_reproducible replaces the global reductions of a VECSEQ or VECMPI vector by
+   ones whose results do not depend on the number of processes
+
+   The option is read without the prefix of the vector, the mode is meant to be used for a whole run. The fused
+   operations are removed so that VecAXPYDotNorm() and VecMAXPYNorm() use the separate reproducible ones; the
+   split phase reductions, VecDotBegin() and friends, are not affected, so the solvers check v->reproducible and
+   use the blocking ones instead.
+*/
+PetscErrorCode VecSetReproducible_Private(Vec v)
+{
+  PetscBool      flg = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetBool(((PetscObject)v)->options,NULL,"-vec_reproducible",&flg,NULL);CHKERRQ(ierr);
+  if (!flg) PetscFunctionReturn(0);
+#if !defined(PETSC_USE_REAL_SINGLE) && !defined(PETSC_USE_REAL_DOUBLE)
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"-vec_reproducible is only supported for single and double precision");
+#else
+  v->ops->dot         = VecDot_Reproducible;
+  v->ops->tdot        = VecTDot_Reproducible;
+  v->ops->mdot        = VecMDot_Reproducible;
+  v->ops->norm        = VecNorm_Reproducible;
+  v->ops->axpydotnorm = NULL;
+  v->ops->maxpynorm   = NULL;
+  v->reproducible     = PETSC_TRUE;
+#endif
+  PetscFunctionReturn(0);
+}
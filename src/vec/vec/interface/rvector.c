@@ -85,6 +85,9 @@ PetscErrorCode  VecMaxPointwiseDivide(Vec x,Vec y,PetscReal *max)
    Output Parameter:
 .  val - the dot product
 
+   Options Database Key:
+.  -vec_reproducible - for VECSEQ and VECMPI vectors, sum the products exactly so the result does not depend on the number of processes
+
    Performance Issues:
 $    per-processor memory bandwidth
 $    interprocessor latency
@@ -191,6 +194,9 @@ $     NORM_INFINITY denotes max_i |x_i|
       the 1 norm of the complex entries (what is returned by the BLAS routine asum()). Both are valid norms but most
       people expect the former.
 
+   Options Database Key:
+.  -vec_reproducible - for VECSEQ and VECMPI vectors, sum the terms exactly so the result does not depend on the number of processes
+
    Level: intermediate
 
    Performance Issues:
@@ -1217,6 +1223,130 @@ PetscErrorCode  VecMAXPY(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[])
   PetscFunctionReturn(0);
 }
 
+/*@
+   VecAXPYDotNorm - Computes y = y + alpha x and then the inner product of the new y with z and the 2-norm of the new y,
+   with one pass over the vectors and a single reduction
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  y - the vector to update
+.  alpha - the scalar
+.  x - the vector that is added to y
+-  z - the vector for the inner product, or NULL
+
+   Output Parameters:
++  dp - the inner product (y,z) of the new y as computed by VecDot(y,z), or NULL
+-  nrm - the 2-norm of the new y, or NULL
+
+   Level: intermediate
+
+   Notes:
+   This gives the same result as VecAXPY(y,alpha,x); VecDot(y,z,dp); VecNorm(y,NORM_2,nrm); up to rounding.
+   It is meant for Krylov methods that need the norm or an inner product of a vector right after updating it.
+
+   x and y MUST be different vectors, z may be x or y
+
+   Vector types that do not provide a fused kernel use the separate operations.
+
+.seealso: VecAXPY(), VecDot(), VecNorm(), VecMAXPYNorm(), VecDotNorm2()
+@*/
+PetscErrorCode  VecAXPYDotNorm(Vec y,PetscScalar alpha,Vec x,Vec z,PetscScalar *dp,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidType(y,1);
+  PetscValidType(x,3);
+  PetscCheckSameTypeAndComm(x,3,y,1);
+  VecCheckSameSize(x,3,y,1);
+  if (x == y) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  if (dp) {
+    PetscValidScalarPointer(dp,5);
+    PetscValidHeaderSpecific(z,VEC_CLASSID,4);
+    PetscValidType(z,4);
+    PetscCheckSameTypeAndComm(z,4,y,1);
+    VecCheckSameSize(z,4,y,1);
+  }
+  if (nrm) PetscValidRealPointer(nrm,6);
+  PetscValidLogicalCollectiveScalar(y,alpha,2);
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+
+  if (!y->ops->axpydotnorm) {
+    ierr = VecAXPY(y,alpha,x);CHKERRQ(ierr);
+    if (dp)  {ierr = VecDot(y,z,dp);CHKERRQ(ierr);}
+    if (nrm) {ierr = VecNorm(y,NORM_2,nrm);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+  ierr = VecLockReadPush(x);CHKERRQ(ierr);
+  if (dp && z != y) {ierr = VecLockReadPush(z);CHKERRQ(ierr);}
+  ierr = PetscLogEventBegin(VEC_AXPYDotNorm,x,y,z,0);CHKERRQ(ierr);
+  ierr = (*y->ops->axpydotnorm)(y,alpha,x,dp ? z : NULL,dp,nrm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_AXPYDotNorm,x,y,z,0);CHKERRQ(ierr);
+  if (dp && z != y) {ierr = VecLockReadPop(z);CHKERRQ(ierr);}
+  ierr = VecLockReadPop(x);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  if (nrm) {ierr = PetscObjectComposedDataSetReal((PetscObject)y,NormIds[NORM_2],*nrm);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecMAXPYNorm - Computes y = y + sum alpha[i] x[i] and the 2-norm of the new y, computing the norm while the last
+   x vectors are added
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+.  y - one vector
+-  x - array of vectors
+
+   Output Parameter:
+.  nrm - the 2-norm of the new y
+
+   Level: intermediate
+
+   Notes:
+   This gives the same result as VecMAXPY(y,nv,alpha,x); VecNorm(y,NORM_2,nrm); up to rounding but saves one
+   pass over y. y cannot be any of the x vectors
+
+.seealso: VecMAXPY(), VecNorm(), VecAXPYDotNorm()
+@*/
+PetscErrorCode  VecMAXPYNorm(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[],PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(y,nv,2);
+  PetscValidRealPointer(nrm,5);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors (given %D) cannot be negative",nv);
+  if (!nv || !y->ops->maxpynorm) {
+    ierr = VecMAXPY(y,nv,alpha,x);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_2,nrm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  PetscValidScalarPointer(alpha,3);
+  PetscValidPointer(x,4);
+  PetscValidHeaderSpecific(*x,VEC_CLASSID,4);
+  PetscValidType(y,1);
+  PetscValidType(*x,4);
+  PetscCheckSameTypeAndComm(y,1,*x,4);
+  VecCheckSameSize(y,1,*x,4);
+  for (i=0; i<nv; i++) PetscValidLogicalCollectiveScalar(y,alpha[i],3);
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_MAXPYNorm,*x,y,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->maxpynorm)(y,nv,alpha,x,nrm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_MAXPYNorm,*x,y,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetReal((PetscObject)y,NormIds[NORM_2],*nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecGetSubVector - Gets a vector representing part of another vector
 
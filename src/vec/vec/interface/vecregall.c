@@ -13,6 +13,11 @@ PETSC_EXTERN PetscErrorCode VecCreate_SeqViennaCL(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_MPIViennaCL(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_ViennaCL(Vec);
 #endif
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_EXTERN PetscErrorCode VecCreate_SeqThreaded(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_MPIThreaded(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_Threaded(Vec);
+#endif
 #if defined(PETSC_HAVE_CUDA)
 PETSC_EXTERN PetscErrorCode VecCreate_SeqCUDA(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_MPICUDA(Vec);
@@ -48,6 +53,11 @@ PetscErrorCode VecRegisterAll(void)
   ierr = VecRegister(VECMPIVIENNACL,    VecCreate_MPIViennaCL);CHKERRQ(ierr);
   ierr = VecRegister(VECVIENNACL,       VecCreate_ViennaCL);CHKERRQ(ierr);
 #endif
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = VecRegister(VECSEQTHREADED,VecCreate_SeqThreaded);CHKERRQ(ierr);
+  ierr = VecRegister(VECMPITHREADED,VecCreate_MPIThreaded);CHKERRQ(ierr);
+  ierr = VecRegister(VECTHREADED,   VecCreate_Threaded);CHKERRQ(ierr);
+#endif
 #if defined(PETSC_HAVE_CUDA)
   ierr = VecRegister(VECSEQCUDA,    VecCreate_SeqCUDA);CHKERRQ(ierr);
   ierr = VecRegister(VECMPICUDA,    VecCreate_MPICUDA);CHKERRQ(ierr);
@@ -11,7 +11,7 @@ PetscLogEvent VEC_Norm, VEC_Normalize, VEC_Scale, VEC_Copy, VEC_Set, VEC_AXPY, V
 PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
 PetscLogEvent VEC_AssemblyEnd, VEC_PointwiseMult, VEC_SetValues, VEC_Load;
 PetscLogEvent VEC_SetRandom, VEC_ReduceArithmetic, VEC_ReduceCommunication,VEC_ReduceBegin,VEC_ReduceEnd,VEC_Ops;
-PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ;
+PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ, VEC_AXPYDotNorm, VEC_MAXPYNorm;
 PetscLogEvent VEC_ViennaCLCopyFromGPU, VEC_ViennaCLCopyToGPU;
 PetscLogEvent VEC_CUDACopyFromGPU, VEC_CUDACopyToGPU;
 PetscLogEvent VEC_CUDACopyFromGPUSome, VEC_CUDACopyToGPUSome;
@@ -413,6 +413,11 @@ PetscErrorCode  VecDestroy(Vec *v)
    Output Parameter:
 .  V - location to put pointer to array of vectors
 
+   Options Database Key:
+.  -vec_duplicatevecs_contiguous - for VECSEQ and VECMPI vectors (without ghost points) store the local parts of the
+                                   new vectors in one array as the columns of a dense matrix, VecMDot() and VecMAXPY()
+                                   then use BLAS gemv on runs of four or more consecutive columns of such an array
+
    Notes:
    Use VecDestroyVecs() to free the space. Use VecDuplicate() to form a single
    vector.
@@ -0,0 +1,259 @@
+static char help[] = "Tests VecAXPYDotNorm(), VecMAXPYNorm() and, with -threaded, the operations of threaded vectors against the separate or standard vector operations.\n\n";
+
+#include <petscvec.h>
+
+/* compares the entries, so x and y may be of different types */
+static PetscErrorCode CheckVec(Vec x,Vec y,const char *msg)
+{
+  PetscReal         norm = 0.0,nrm = 0.0;
+  const PetscScalar *xa,*ya;
+  PetscInt          i,n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(y,&ya);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    norm = PetscMax(norm,PetscAbsScalar(xa[i]-ya[i]));
+    nrm  = PetscMax(nrm,PetscAbsScalar(xa[i]));
+  }
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(y,&ya);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&norm,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)x));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&nrm,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)x));CHKERRQ(ierr);
+  if (norm > PETSC_SMALL*nrm) {ierr = PetscPrintf(PetscObjectComm((PetscObject)x),"%s: difference %g\n",msg,(double)norm);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckScalar(MPI_Comm comm,PetscScalar a,PetscScalar b,const char *msg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscAbsScalar(a-b) > PETSC_SMALL*PetscAbsScalar(b)) {ierr = PetscPrintf(comm,"%s: %g != %g\n",msg,(double)PetscRealPart(a),(double)PetscRealPart(b));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TestFused(MPI_Comm comm,PetscRandom rand,PetscInt n)
+{
+  Vec            x,y,z,w,*v;
+  PetscInt       nv,k;
+  PetscScalar    alpha = -0.7,dp,dpref,a[9];
+  PetscReal      nrm,nrmref;
+  char           str[64];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate(comm,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(z,rand);CHKERRQ(ierr);
+
+  /* update, inner product and norm */
+  ierr = VecCopy(y,w);CHKERRQ(ierr);
+  ierr = VecAXPY(w,alpha,x);CHKERRQ(ierr);
+  ierr = VecDot(w,z,&dpref);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_2,&nrmref);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm(y,alpha,x,z,&dp,&nrm);CHKERRQ(ierr);
+  ierr = CheckVec(w,y,"VecAXPYDotNorm() vector");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,dp,dpref,"VecAXPYDotNorm() inner product");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,nrm,nrmref,"VecAXPYDotNorm() norm");CHKERRQ(ierr);
+
+  /* only the inner product, with z the vector that is added */
+  ierr = VecAXPY(w,alpha,x);CHKERRQ(ierr);
+  ierr = VecDot(w,x,&dpref);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm(y,alpha,x,x,&dp,NULL);CHKERRQ(ierr);
+  ierr = CheckVec(w,y,"VecAXPYDotNorm() vector, z = x");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,dp,dpref,"VecAXPYDotNorm() inner product, z = x");CHKERRQ(ierr);
+
+  /* inner product with itself */
+  ierr = VecAXPY(w,alpha,x);CHKERRQ(ierr);
+  ierr = VecDot(w,w,&dpref);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm(y,alpha,x,y,&dp,NULL);CHKERRQ(ierr);
+  ierr = CheckVec(w,y,"VecAXPYDotNorm() vector, z = y");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,dp,dpref,"VecAXPYDotNorm() inner product, z = y");CHKERRQ(ierr);
+
+  /* only the norm, which must also be the cached norm of y */
+  ierr = VecAXPY(w,alpha,x);CHKERRQ(ierr);
+  ierr = VecNorm(w,NORM_2,&nrmref);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm(y,alpha,x,NULL,NULL,&nrm);CHKERRQ(ierr);
+  ierr = CheckVec(w,y,"VecAXPYDotNorm() vector, no inner product");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,nrm,nrmref,"VecAXPYDotNorm() norm, no inner product");CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = CheckScalar(comm,nrm,nrmref,"VecNorm() after VecAXPYDotNorm()");CHKERRQ(ierr);
+
+  /* all the cases of the unrolled kernels */
+  ierr = VecDuplicateVecs(x,9,&v);CHKERRQ(ierr);
+  for (k=0; k<9; k++) {
+    ierr = VecSetRandom(v[k],rand);CHKERRQ(ierr);
+    a[k] = 1.0/(k+2);
+  }
+  for (nv=0; nv<=9; nv++) {
+    ierr = VecCopy(y,w);CHKERRQ(ierr);
+    ierr = VecMAXPY(w,nv,a,v);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_2,&nrmref);CHKERRQ(ierr);
+    ierr = VecMAXPYNorm(y,nv,a,v,&nrm);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(str,sizeof(str),"VecMAXPYNorm() with %D vectors",nv);CHKERRQ(ierr);
+    ierr = CheckVec(w,y,str);CHKERRQ(ierr);
+    ierr = CheckScalar(comm,nrm,nrmref,str);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(comm,"Tested fused vector operations\n");CHKERRQ(ierr);
+
+  ierr = VecDestroyVecs(9,&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* x[] are threaded vectors, y[] standard vectors with the same entries */
+static PetscErrorCode TestThreaded(MPI_Comm comm,PetscRandom rand,PetscInt n)
+{
+  Vec            x[3],y[3],*v,*w;
+  PetscInt       i,k;
+  PetscScalar    a[6],d,dref,md[6],mdref[6];
+  PetscReal      nrm[2],nrmref[2];
+  NormType       types[] = {NORM_1,NORM_2,NORM_INFINITY};
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<3; i++) {
+    ierr = VecCreate(comm,&x[i]);CHKERRQ(ierr);
+    ierr = VecSetSizes(x[i],n,PETSC_DECIDE);CHKERRQ(ierr);
+    ierr = VecSetType(x[i],VECTHREADED);CHKERRQ(ierr);
+    ierr = VecCreate(comm,&y[i]);CHKERRQ(ierr);
+    ierr = VecSetSizes(y[i],n,PETSC_DECIDE);CHKERRQ(ierr);
+    ierr = VecSetType(y[i],VECSTANDARD);CHKERRQ(ierr);
+    ierr = VecSetRandom(y[i],rand);CHKERRQ(ierr);
+    ierr = VecCopy(y[i],x[i]);CHKERRQ(ierr);
+  }
+  ierr = VecDuplicateVecs(x[0],6,&v);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(y[0],6,&w);CHKERRQ(ierr);
+  for (k=0; k<6; k++) {
+    ierr = VecSetRandom(w[k],rand);CHKERRQ(ierr);
+    ierr = VecCopy(w[k],v[k]);CHKERRQ(ierr);
+    a[k] = 1.0/(k+2);
+  }
+
+  ierr = VecDot(x[0],x[1],&d);CHKERRQ(ierr);
+  ierr = VecDot(y[0],y[1],&dref);CHKERRQ(ierr);
+  ierr = CheckScalar(comm,d,dref,"VecDot()");CHKERRQ(ierr);
+  ierr = VecTDot(x[0],x[1],&d);CHKERRQ(ierr);
+  ierr = VecTDot(y[0],y[1],&dref);CHKERRQ(ierr);
+  ierr = CheckScalar(comm,d,dref,"VecTDot()");CHKERRQ(ierr);
+  for (k=1; k<=6; k++) {
+    ierr = VecMDot(x[0],k,v,md);CHKERRQ(ierr);
+    ierr = VecMDot(y[0],k,w,mdref);CHKERRQ(ierr);
+    for (i=0; i<k; i++) {ierr = CheckScalar(comm,md[i],mdref[i],"VecMDot()");CHKERRQ(ierr);}
+  }
+  for (i=0; i<3; i++) {
+    ierr = VecNorm(x[0],types[i],nrm);CHKERRQ(ierr);
+    ierr = VecNorm(y[0],types[i],nrmref);CHKERRQ(ierr);
+    ierr = CheckScalar(comm,nrm[0],nrmref[0],"VecNorm()");CHKERRQ(ierr);
+  }
+  ierr = VecNorm(x[0],NORM_1_AND_2,nrm);CHKERRQ(ierr);
+  ierr = VecNorm(y[0],NORM_1_AND_2,nrmref);CHKERRQ(ierr);
+  ierr = CheckScalar(comm,nrm[0],nrmref[0],"VecNorm() NORM_1_AND_2");CHKERRQ(ierr);
+  ierr = CheckScalar(comm,nrm[1],nrmref[1],"VecNorm() NORM_1_AND_2");CHKERRQ(ierr);
+
+  /* the reductions do not depend on the run */
+  ierr = VecDot(x[0],x[1],&dref);CHKERRQ(ierr);
+  for (i=0; i<10; i++) {
+    ierr = VecDot(x[0],x[1],&d);CHKERRQ(ierr);
+    if (d != dref) {ierr = PetscPrintf(comm,"VecDot() differs between calls\n");CHKERRQ(ierr);}
+  }
+
+  ierr = VecAXPY(x[2],0.3,x[0]);CHKERRQ(ierr);
+  ierr = VecAXPY(y[2],0.3,y[0]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecAXPY()");CHKERRQ(ierr);
+  ierr = VecAYPX(x[2],-0.6,x[1]);CHKERRQ(ierr);
+  ierr = VecAYPX(y[2],-0.6,y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecAYPX()");CHKERRQ(ierr);
+  ierr = VecAYPX(x[2],-1.0,x[1]);CHKERRQ(ierr);
+  ierr = VecAYPX(y[2],-1.0,y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecAYPX() with -1");CHKERRQ(ierr);
+  ierr = VecAXPBY(x[2],2.0,0.5,x[0]);CHKERRQ(ierr);
+  ierr = VecAXPBY(y[2],2.0,0.5,y[0]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecAXPBY()");CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(x[2],2.0,-1.0,0.5,x[0],x[1]);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(y[2],2.0,-1.0,0.5,y[0],y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecAXPBYPCZ()");CHKERRQ(ierr);
+  ierr = VecWAXPY(x[2],-3.0,x[0],x[1]);CHKERRQ(ierr);
+  ierr = VecWAXPY(y[2],-3.0,y[0],y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecWAXPY()");CHKERRQ(ierr);
+  ierr = VecScale(x[2],1.5);CHKERRQ(ierr);
+  ierr = VecScale(y[2],1.5);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecScale()");CHKERRQ(ierr);
+  ierr = VecPointwiseMult(x[2],x[0],x[1]);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(y[2],y[0],y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecPointwiseMult()");CHKERRQ(ierr);
+  ierr = VecPointwiseDivide(x[2],x[0],x[1]);CHKERRQ(ierr);
+  ierr = VecPointwiseDivide(y[2],y[0],y[1]);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecPointwiseDivide()");CHKERRQ(ierr);
+  ierr = VecSwap(x[1],x[2]);CHKERRQ(ierr);
+  ierr = VecSwap(y[1],y[2]);CHKERRQ(ierr);
+  ierr = CheckVec(x[1],y[1],"VecSwap()");CHKERRQ(ierr);
+  for (k=1; k<=6; k++) {
+    ierr = VecMAXPY(x[2],k,a,v);CHKERRQ(ierr);
+    ierr = VecMAXPY(y[2],k,a,w);CHKERRQ(ierr);
+    ierr = CheckVec(x[2],y[2],"VecMAXPY()");CHKERRQ(ierr);
+  }
+  ierr = VecSet(x[2],2.0);CHKERRQ(ierr);
+  ierr = VecSet(y[2],2.0);CHKERRQ(ierr);
+  ierr = CheckVec(x[2],y[2],"VecSet()");CHKERRQ(ierr);
+  ierr = PetscPrintf(comm,"Tested threaded vector operations\n");CHKERRQ(ierr);
+
+  ierr = VecDestroyVecs(6,&v);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(6,&w);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {
+    ierr = VecDestroy(&x[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&y[i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscInt       n = 37;
+  PetscBool      threaded = PETSC_FALSE;
+  PetscRandom    rand;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  comm = PETSC_COMM_WORLD;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-threaded",&threaded,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(comm,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  if (threaded) {
+    ierr = TestThreaded(comm,rand,n);CHKERRQ(ierr);
+  } else {
+    ierr = TestFused(comm,rand,n);CHKERRQ(ierr);
+  }
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      output_file: output/ex56_1.out
+
+   test:
+      suffix: threaded
+      requires: openmp
+      nsize: {{1 2}}
+      args: -threaded -n 1003 -vec_omp_num_threads {{1 3}}
+      output_file: output/ex56_threaded.out
+
+TEST*/
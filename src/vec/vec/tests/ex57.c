@@ -0,0 +1,89 @@
+static char help[] = "Tests VecMDot() and VecMAXPY() on long vectors and on vectors from VecDuplicateVecs() with -vec_duplicatevecs_contiguous.\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  Vec            x,y,w,z,*v,*u,b[18];
+  PetscInt       n = 10003,nv,k,m = 11,mu = 6,nb,nerr = 0;
+  PetscScalar    a[18],val[18],dot;
+  PetscReal      norm,nrm;
+  PetscRandom    rand;
+  PetscObject    obj;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,m,&v);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,mu,&u);CHKERRQ(ierr);
+  /* a duplicate of one of the group has its own storage and must not keep the group's alive */
+  ierr = VecDuplicate(v[0],&z);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject)z,"VecMultiVec",&obj);CHKERRQ(ierr);
+  if (obj) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"VecDuplicate() of a vector from VecDuplicateVecs() kept its storage\n");CHKERRQ(ierr);
+    nerr++;
+  }
+  /* a basis made of several groups of vectors and a single vector in between, as in GMRES */
+  nb = 0;
+  for (k=0; k<m; k++) b[nb++] = v[k];
+  b[nb++] = z;
+  for (k=0; k<mu; k++) b[nb++] = u[k];
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  for (k=0; k<nb; k++) {
+    ierr = VecSetRandom(b[k],rand);CHKERRQ(ierr);
+    a[k] = 1.0/(k+1);
+  }
+
+  for (nv=1; nv<=nb; nv++) {
+    /* the first vector may be skipped so the arrays of the group do not start at the beginning of the allocation */
+    Vec *vv = b + (nv < nb ? 1 : 0);
+
+    ierr = VecMDot(x,nv,vv,val);CHKERRQ(ierr);
+    for (k=0; k<nv; k++) {
+      ierr = VecDot(x,vv[k],&dot);CHKERRQ(ierr);
+      if (PetscAbsScalar(dot-val[k]) > PETSC_SMALL*PetscAbsScalar(dot)) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMDot() with %D vectors, entry %D: %g != %g\n",nv,k,(double)PetscRealPart(val[k]),(double)PetscRealPart(dot));CHKERRQ(ierr);
+        nerr++;
+      }
+    }
+
+    ierr = VecCopy(x,y);CHKERRQ(ierr);
+    ierr = VecCopy(x,w);CHKERRQ(ierr);
+    ierr = VecMAXPY(y,nv,a,vv);CHKERRQ(ierr);
+    for (k=0; k<nv; k++) {ierr = VecAXPY(w,a[k],vv[k]);CHKERRQ(ierr);}
+    ierr = VecAXPY(w,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    if (norm > PETSC_SMALL*nrm) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPY() with %D vectors: norm of difference %g\n",nv,(double)norm);CHKERRQ(ierr);
+      nerr++;
+    }
+  }
+  if (!nerr) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMDot() and VecMAXPY() agree with VecDot() and VecAXPY()\n");CHKERRQ(ierr);}
+
+  ierr = VecDestroyVecs(m,&v);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(mu,&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      args: -n {{3 10003}} -vec_duplicatevecs_contiguous {{0 1}}
+      output_file: output/ex57_1.out
+
+TEST*/
@@ -0,0 +1,84 @@
+static char help[] = "Tests the reductions of -vec_reproducible on any number of processes.\n\n";
+
+#include <petscvec.h>
+
+/* entries that only depend on the global index, with a wide range of magnitudes */
+static PetscErrorCode FillVec(Vec x,PetscInt shift)
+{
+  PetscScalar    *xa;
+  PetscInt       i,rstart,rend;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&xa);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) xa[i-rstart] = PetscSinReal((PetscReal)(i+shift))*PetscPowReal(10.0,(PetscReal)((i+shift)%13-6));
+  ierr = VecRestoreArray(x,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            x,y,one,*v;
+  PetscInt       n = 1000,i,k,rstart,rend;
+  PetscScalar    d,md[4];
+  PetscReal      nrm[2];
+  NormType       types[] = {NORM_1,NORM_2,NORM_INFINITY};
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  comm = PETSC_COMM_WORLD;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = VecCreate(comm,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&one);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,4,&v);CHKERRQ(ierr);
+  ierr = FillVec(x,0);CHKERRQ(ierr);
+  ierr = FillVec(y,5);CHKERRQ(ierr);
+  for (k=0; k<4; k++) {ierr = FillVec(v[k],3*k+1);CHKERRQ(ierr);}
+  ierr = VecSet(one,1.0);CHKERRQ(ierr);
+
+  /* the results are printed with all their digits; the output is the same on any number of processes */
+  ierr = VecDot(x,y,&d);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm,"VecDot() %.17g\n",(double)PetscRealPart(d));CHKERRQ(ierr);
+  ierr = VecTDot(x,y,&d);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm,"VecTDot() %.17g\n",(double)PetscRealPart(d));CHKERRQ(ierr);
+  ierr = VecMDot(x,4,v,md);CHKERRQ(ierr);
+  for (k=0; k<4; k++) {ierr = PetscPrintf(comm,"VecMDot() %.17g\n",(double)PetscRealPart(md[k]));CHKERRQ(ierr);}
+  for (k=0; k<3; k++) {
+    ierr = VecNorm(x,types[k],nrm);CHKERRQ(ierr);
+    ierr = PetscPrintf(comm,"VecNorm() %s %.17g\n",NormTypes[types[k]],(double)nrm[0]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(x,NORM_1_AND_2,nrm);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm,"VecNorm() NORM_1_AND_2 %.17g %.17g\n",(double)nrm[0],(double)nrm[1]);CHKERRQ(ierr);
+
+  /* the sum is exact: 1e20 + 1 + 1 - 1e20 + ... gives n/2 */
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = VecSetValue(x,i,(i%4 == 0) ? 1.e20 : ((i%4 == 3) ? -1.e20 : 1.0),INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecAssemblyBegin(x);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(x);CHKERRQ(ierr);
+  ierr = VecDot(x,one,&d);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm,"Sum with cancellation %.17g\n",(double)PetscRealPart(d));CHKERRQ(ierr);
+
+  ierr = VecDestroyVecs(4,&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&one);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      requires: double !complex
+      nsize: {{1 2 3}}
+      args: -vec_reproducible
+      output_file: output/ex59_1.out
+
+TEST*/
@@ -20,6 +20,7 @@
 */
 
 #include <petsc/private/vecimpl.h>    /*I   "petscvec.h"    I*/
+#include <petsctime.h>
 
 static PetscErrorCode MPIPetsc_Iallreduce(void *sendbuf,void *recvbuf,PetscMPIInt count,MPI_Datatype datatype,MPI_Op op,MPI_Comm comm,MPI_Request *request)
 {
@@ -46,6 +47,8 @@ some of each.
 
 static PetscErrorCode PetscSplitReductionApply(PetscSplitReduction*);
 
+PetscMPIInt Petsc_Reduction_keyval = MPI_KEYVAL_INVALID;
+
 /*
    PetscSplitReductionCreate - Creates a data structure to contain the queued information.
 */
@@ -65,6 +68,8 @@ static PetscErrorCode  PetscSplitReductionCreate(MPI_Comm comm,PetscSplitReducti
   (*sr)->comm        = comm;
   (*sr)->request     = MPI_REQUEST_NULL;
   (*sr)->async       = PETSC_FALSE;
+  (*sr)->toverlap    = 0.0;
+  (*sr)->tblocked    = 0.0;
 #if defined(PETSC_HAVE_MPI_IALLREDUCE) || defined(PETSC_HAVE_MPIX_IALLREDUCE)
   (*sr)->async = PETSC_TRUE;    /* Enable by default */
 #endif
@@ -119,7 +124,8 @@ PETSC_EXTERN void MPIAPI PetscSplitReduction_Local(void *in,void *out,PetscMPIIn
    Calling this function is optional when using split-mode reduction. On supporting hardware, calling this after all
    VecXxxBegin() allows the reduction to make asynchronous progress before the result is needed (in VecXxxEnd()).
 
-.seealso: VecNormBegin(), VecNormEnd(), VecDotBegin(), VecDotEnd(), VecTDotBegin(), VecTDotEnd(), VecMDotBegin(), VecMDotEnd(), VecMTDotBegin(), VecMTDotEnd()
+.seealso: VecNormBegin(), VecNormEnd(), VecDotBegin(), VecDotEnd(), VecTDotBegin(), VecTDotEnd(), VecMDotBegin(), VecMDotEnd(), VecMTDotBegin(), VecMTDotEnd(),
+          PetscCommSplitReductionGetTimes()
 @*/
 PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm comm)
 {
@@ -165,6 +171,7 @@ PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm comm)
     }
     sr->state     = STATE_PENDING;
     sr->numopsend = 0;
+    ierr = PetscTime(&sr->tpending);CHKERRQ(ierr);
     ierr = PetscLogEventEnd(VEC_ReduceBegin,0,0,0,0);CHKERRQ(ierr);
   } else {
     ierr = PetscSplitReductionApply(sr);CHKERRQ(ierr);
@@ -172,9 +179,52 @@ PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm comm)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PetscCommSplitReductionGetTimes - Gets the time split-mode reductions on a communicator have spent in flight while
+   the process did other work, and the time spent waiting for their results
+
+   Not Collective
+
+   Input Arguments:
+.  comm - communicator of the vectors used in the reductions
+
+   Output Arguments:
++  overlapped - total time between the start of an asynchronous reduction by PetscCommSplitReductionBegin() and the
+                first VecXxxEnd()
+-  blocked - total time VecXxxEnd() waited for the results, including the reductions done synchronously
+
+   Level: advanced
+
+   Notes:
+   The times are accumulated since the first split-mode reduction on the communicator; take differences to time a
+   part of the computation, as KSPSolve() does with -info. Both are zero if no split-mode reduction was done.
+
+.seealso: PetscCommSplitReductionBegin(), VecDotBegin(), VecNormBegin()
+@*/
+PetscErrorCode PetscCommSplitReductionGetTimes(MPI_Comm comm,PetscLogDouble *overlapped,PetscLogDouble *blocked)
+{
+  PetscErrorCode      ierr;
+  PetscMPIInt         flag = 0;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  if (overlapped) *overlapped = 0.0;
+  if (blocked) *blocked = 0.0;
+  /* do not create the reduction object just to report nothing */
+  if (Petsc_Reduction_keyval != MPI_KEYVAL_INVALID) {
+    ierr = MPI_Comm_get_attr(comm,Petsc_Reduction_keyval,(void**)&sr,&flag);CHKERRQ(ierr);
+  }
+  if (flag) {
+    if (overlapped) *overlapped = sr->toverlap;
+    if (blocked) *blocked = sr->tblocked;
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscSplitReductionEnd(PetscSplitReduction *sr)
 {
   PetscErrorCode ierr;
+  PetscLogDouble t0,t1;
 
   PetscFunctionBegin;
   switch (sr->state) {
@@ -184,9 +234,13 @@ PetscErrorCode PetscSplitReductionEnd(PetscSplitReduction *sr)
   case STATE_PENDING:
     /* We are doing asynchronous-mode communication and this is the first VecXxxEnd() so wait for comm to complete */
     ierr = PetscLogEventBegin(VEC_ReduceEnd,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
     if (sr->request != MPI_REQUEST_NULL) {
       ierr = MPI_Wait(&sr->request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
     }
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    sr->toverlap += t0 - sr->tpending;
+    sr->tblocked += t1 - t0;
     sr->state = STATE_END;
     ierr = PetscLogEventEnd(VEC_ReduceEnd,0,0,0,0);CHKERRQ(ierr);
     break;
@@ -206,10 +260,12 @@ static PetscErrorCode PetscSplitReductionApply(PetscSplitReduction *sr)
   PetscInt       sum_flg  = 0,max_flg = 0, min_flg = 0;
   MPI_Comm       comm     = sr->comm;
   PetscMPIInt    size,cmul = sizeof(PetscScalar)/sizeof(PetscReal);
+  PetscLogDouble t0,t1;
 
   PetscFunctionBegin;
   if (sr->numopsend > 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot call this after VecxxxEnd() has been called");
   ierr = PetscLogEventBegin(VEC_ReduceCommunication,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
   ierr = MPI_Comm_size(sr->comm,&size);CHKERRQ(ierr);
   if (size == 1) {
     ierr = PetscArraycpy(gvalues,lvalues,numops);CHKERRQ(ierr);
@@ -238,6 +294,8 @@ static PetscErrorCode PetscSplitReductionApply(PetscSplitReduction *sr)
   }
   sr->state     = STATE_END;
   sr->numopsend = 0;
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  sr->tblocked += t1 - t0;
   ierr = PetscLogEventEnd(VEC_ReduceCommunication,0,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -273,8 +331,6 @@ PetscErrorCode  PetscSplitReductionDestroy(PetscSplitReduction *sr)
   PetscFunctionReturn(0);
 }
 
-PetscMPIInt Petsc_Reduction_keyval = MPI_KEYVAL_INVALID;
-
 /*
    Private routine to delete internal storage when a communicator is freed.
   This is called by MPI, not by users.